@@ -25,7 +25,8 @@
 
 #include "debug.h"
 #include <stddef.h>
-#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
 
 #ifdef __GNUC__
 # if __GNUC__ >= 4
@@ -42,32 +43,91 @@ typedef struct _Pud_Mmap Pud_Mmap;
 struct _Pud_Mmap
 {
    void *map;
-   unsigned char *ptr;
    size_t size;
-   jmp_buf trap;
 };
 
+/*
+ * Bounds-checked read cursor. Errors are sticky: once a read went past the
+ * end, it and all the following reads produce zeros, so a sequence of
+ * reads is checked once, with common_cursor_error().
+ */
+typedef struct
+{
+   const unsigned char *ptr;
+   const unsigned char *end;
+   Pud_Bool             error;
+} Common_Cursor;
+
 PUDAPI Pud_Mmap *common_file_mmap(const char *file);
 PUDAPI void common_file_munmap(Pud_Mmap *map);
 PUDAPI Pud_Bool common_file_exists(const char *path);
-PUDAPI Pud_Bool common_mem_map_ok(const Pud_Mmap *map, size_t extra);
-PUDAPI void common_mmap_ptr_reset(Pud_Mmap *map);
-PUDAPI void common_read_buffer(Pud_Mmap *map, void *buf, size_t bytes);
-PUDAPI uint8_t common_read8(Pud_Mmap *map);
-PUDAPI uint16_t common_read16(Pud_Mmap *map);
-PUDAPI uint32_t common_read32(Pud_Mmap *map);
-PUDAPI void common_trap_hook(void);
 
 #define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
 
-#define COMMON_TRAP_SETUP(Map) \
-   if (setjmp((Map)->trap) != 0)
+static inline void
+common_cursor_init(Common_Cursor *cur,
+                   const void    *mem,
+                   size_t         size)
+{
+   cur->ptr = mem;
+   cur->end = cur->ptr + size;
+   cur->error = PUD_FALSE;
+}
+
+static inline Pud_Bool
+common_cursor_error(const Common_Cursor *cur)
+{
+   return cur->error;
+}
+
+/* Count of bytes that can still be read */
+static inline size_t
+common_cursor_left(const Common_Cursor *cur)
+{
+   return cur->end - cur->ptr;
+}
+
+static inline void
+common_cursor_read(Common_Cursor *cur,
+                   void          *buf,
+                   size_t         bytes)
+{
+   if ((size_t)(cur->end - cur->ptr) < bytes)
+     {
+        cur->error = PUD_TRUE;
+        cur->ptr = cur->end;
+        memset(buf, 0, bytes);
+        return;
+     }
+   memcpy(buf, cur->ptr, bytes);
+   cur->ptr += bytes;
+}
+
+static inline uint8_t
+common_cursor_read8(Common_Cursor *cur)
+{
+   if (cur->ptr == cur->end)
+     {
+        cur->error = PUD_TRUE;
+        return 0;
+     }
+   return *(cur->ptr++);
+}
+
+static inline uint16_t
+common_cursor_read16(Common_Cursor *cur)
+{
+   uint16_t v;
+   common_cursor_read(cur, &v, sizeof(v));
+   return v;
+}
 
-#define COMMON_TRAP_RAISE(Map, ...)      \
-  do {                                   \
-     ERR(__VA_ARGS__);                   \
-     common_trap_hook();                 \
-     longjmp((Map)->trap, 1);            \
-  } while (0)
+static inline uint32_t
+common_cursor_read32(Common_Cursor *cur)
+{
+   uint32_t v;
+   common_cursor_read(cur, &v, sizeof(v));
+   return v;
+}
 
 #endif /* ! __COMMON_H__ */
@@ -162,8 +162,16 @@ typedef enum
  */
 typedef enum
 {
-   PUD_PIXEL_FORMAT_RGBA, /**< Pixels are 8 bits each, RGBA ordered */
-   PUD_PIXEL_FORMAT_ARGB, /**< Pixels are 8 bits each, ARGB ordered */
+   PUD_PIXEL_FORMAT_RGBA, /**< Pixels are 8 bits each, RGBA ordered (Pud_Color) */
+   PUD_PIXEL_FORMAT_ARGB, /**< Native-endian 32 bits 0xAARRGGBB */
+   PUD_PIXEL_FORMAT_ARGB32_PREMUL, /**< Native-endian 32 bits 0xAARRGGBB, premultiplied
+                                        alpha (cairo's CAIRO_FORMAT_ARGB32) */
+   PUD_PIXEL_FORMAT_BGRA, /**< Pixels are 8 bits each, BGRA ordered */
+   PUD_PIXEL_FORMAT_RGB, /**< Pixels are 8 bits each, RGB ordered. Alpha is dropped */
+   PUD_PIXEL_FORMAT_RGB565, /**< Native-endian 16 bits, 5 bits red, 6 bits green,
+                                 5 bits blue. Alpha is dropped */
+
+   __PUD_PIXEL_FORMAT_LAST /**< Sentinel. Not a valid format */
 } Pud_Pixel_Format;
 
 /**
@@ -1554,6 +1562,19 @@ PUDAPI Pud *pud_open(const char *file, Pud_Open_Mode mode);
  */
 PUDAPI void pud_close(Pud *pud);
 
+/**
+ * Set the verbosity level on a PUD handle
+ *
+ * Open the file with PUD_OPEN_MODE_NO_PARSE, then set the verbosity
+ * before calling pud_parse() to get the reports of the parser, such as
+ * unknown sections.
+ *
+ * @param pud A valid PUD handle
+ * @param level The verbosity level
+ * @since 1.0.0
+ */
+PUDAPI void pud_verbosity_set(Pud *pud, int level);
+
 /**
  * Determine if the pud file uses the default ALOW section
  *
@@ -1873,6 +1894,35 @@ PUDAPI Pud_Color pud_minimap_color_for_unit(Pud_Unit unit, Pud_Player player);
  */
 PUDAPI unsigned char *pud_minimap_bitmap_generate(const Pud *pud, unsigned int *size_ret, Pud_Pixel_Format pfmt);
 
+/**
+ * Get the size of a pixel in a given format
+ *
+ * @param pfmt A pixel format
+ * @return The size of a pixel, in bytes. 0 if @p pfmt is invalid.
+ * @since 1.0.0
+ */
+PUDAPI unsigned int pud_pixel_format_size(Pud_Pixel_Format pfmt);
+
+/**
+ * Convert RGBA pixels to another pixel format
+ *
+ * Surfaces of cairo (PUD_PIXEL_FORMAT_ARGB32_PREMUL) or SDL
+ * (PUD_PIXEL_FORMAT_RGB565, ...) can be filled directly.
+ *
+ * @param src The pixels to be converted
+ * @param dst Where to write the @p count converted pixels. Its size
+ *            must be @p count * pud_pixel_format_size(@p pfmt). It may
+ *            be @p src only if @p pfmt is PUD_PIXEL_FORMAT_RGBA.
+ * @param count The count of pixels
+ * @param pfmt The format of the pixels written in @p dst
+ * @return PUD_TRUE on success, PUD_FALSE if @p pfmt is invalid
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool pud_pixels_convert(const Pud_Color  *src,
+                                   void             *dst,
+                                   size_t            count,
+                                   Pud_Pixel_Format  pfmt);
+
 /**
  * @}
  */ /* End of Pud_Minimap group */
@@ -29,7 +29,6 @@
 #include <string.h>
 #include <errno.h>
 #include <stdint.h>
-#include <setjmp.h>
 #include <time.h>
 
 #include "debug.h"
@@ -37,6 +36,16 @@
 
 #include "common.h"
 
+#define PUD_SECTIONS_COUNT 20
+
+/* Where the data of a section is in the mapped file. Offset 0 (where the
+ * first tag is) means the section is not present */
+typedef struct
+{
+   uint32_t offset;
+   uint32_t size;
+} Pud_Section_Index;
+
 struct _Pud_Private
 {
    Pud_Open_Mode  open_mode;
@@ -45,12 +54,17 @@ struct _Pud_Private
    /* Bitfield: is section X present? */
    uint32_t     sections;
 
-   /* Cache */
-   uint8_t       current_section;
+   /* Built once by pud_sections_index() */
+   Pud_Section_Index index[PUD_SECTIONS_COUNT];
+
+   /* Found by pud_sections_index(), reported by pud_parse() */
+   unsigned int  unknown_sections;
+   size_t        unknown_offset; /* Of the first unknown section */
+   size_t        trailing_bytes;
 
    Pud_Bool has_erax;
 
-   unsigned int  verbose;
+   int           verbose;
    Pud_Bool init; /* set by defaults */
    Pud_Bool default_allow; /* [defaults] */
    Pud_Bool default_udta; /* [defaults] */
@@ -87,12 +101,6 @@ struct _Pud_Private
       } \
    } while (0)
 
-#define PUD_TRAP_SETUP(pud_) COMMON_TRAP_SETUP((pud_)->private_data->mem_map)
-#define PUD_READ8(pud_) common_read8((pud_)->private_data->mem_map)
-#define PUD_READ16(pud_) common_read16((pud_)->private_data->mem_map)
-#define PUD_READ32(pud_) common_read32((pud_)->private_data->mem_map)
-#define PUD_READ_BUFFER(pud_, buf_, size_) common_read_buffer((pud_)->private_data->mem_map, buf_, size_)
-
 
 //============================================================================//
 //                                 Private API                                //
@@ -101,7 +109,16 @@ struct _Pud_Private
 PUDAPI_INTERNAL const char *long2bin(uint32_t x);
 PUDAPI_INTERNAL Pud_Color color_make(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 PUDAPI_INTERNAL const char *mode2str(Pud_Open_Mode mode);
-PUDAPI_INTERNAL uint32_t pud_go_to_section(Pud *pud, Pud_Section sec);
+PUDAPI_INTERNAL void pud_sections_index(Pud *pud);
+PUDAPI_INTERNAL uint32_t pud_go_to_section(Pud *pud, Pud_Section sec, Common_Cursor *cur);
+
+/* Tile IDs covered by the minimap colors tables (last tile ID is 0x9df) */
+#define MINIMAP_TILES 0x09e0
+#define MINIMAP_COLOR_UNPACK(Px) \
+   color_make(((Px) >> 16) & 0xff, ((Px) >> 8) & 0xff, (Px) & 0xff, 0xff)
+
+/* Packed minimap colors of the tiles of an era, MINIMAP_TILES long */
+PUDAPI_INTERNAL const uint32_t *minimap_colors_get(Pud_Era era);
 
 
 #endif /* ! _PRIVATE_H_ */
@@ -44,10 +44,27 @@ extern "C" { /* } For dumb editors */
 /**
  * @typedef War2_Data
  * Opaque type that handles warcraft 2 data
+ *
+ * A handle may be shared by several threads, each one decoding with its
+ * own War2_Decoder. The data that is decoded once and kept by the handle
+ * (minitiles, tile equivalences, icons) is then built under a lock.
+ * Without threads support, a handle must not be shared.
  * @since 1.0.0
  */
 typedef struct _War2_Data War2_Data;
 
+/**
+ * @typedef War2_Decoder
+ * Opaque type that holds the scratch memory used while decoding
+ * Warcraft 2 data.
+ *
+ * A decoder keeps its buffers between calls and only grows them. Once
+ * they are large enough, decoding does not allocate memory anymore.
+ * A decoder is not thread-safe: use one decoder per thread.
+ * @since 1.0.0
+ */
+typedef struct _War2_Decoder War2_Decoder;
+
 /**
  * @def WAR2_PALETTE_SIZE
  * The size of elements in a color palette
@@ -68,6 +85,111 @@ typedef enum
    WAR2_SPRITES_SYSTEM    = 0x103  /**< System sprites (i.e. start locations) */
 } War2_Sprites;
 
+/**
+ * @typedef War2_Scaler
+ * Algorithms that can be used to upscale images
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_SCALER_NEAREST = 0, /**< Integer nearest neighbour. Any factor */
+   WAR2_SCALER_SCALE2X = 1  /**< Scale2x/Scale3x pixel-art scaler. Factors 1 to 4 */
+} War2_Scaler;
+
+/**
+ * @typedef War2_Ppm_Format
+ * Formats of the Netpbm family that images can be written to
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_PPM_FORMAT_P6  = 0, /**< Binary RGB PPM. Alpha is dropped */
+   WAR2_PPM_FORMAT_PAM = 1, /**< Binary RGBA PAM (P7) */
+   WAR2_PPM_FORMAT_P3  = 2  /**< ASCII RGB PPM. Alpha is dropped */
+} War2_Ppm_Format;
+
+/**
+ * @typedef War2_Png_Filter
+ * Filters applied to the rows of PNG images before they are compressed
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_PNG_FILTER_DEFAULT  = 0, /**< Let libpng choose */
+   WAR2_PNG_FILTER_NONE     = 1, /**< No filtering. Fastest */
+   WAR2_PNG_FILTER_SUB      = 2, /**< Difference with the left pixel */
+   WAR2_PNG_FILTER_PAETH    = 3, /**< Paeth predictor */
+   WAR2_PNG_FILTER_ADAPTIVE = 4  /**< Best filter of each row. Slowest */
+} War2_Png_Filter;
+
+/**
+ * @typedef War2_Png_Strategy
+ * Strategies of zlib to compress PNG images
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_PNG_STRATEGY_DEFAULT      = 0, /**< Let libpng choose */
+   WAR2_PNG_STRATEGY_FILTERED     = 1, /**< Z_FILTERED */
+   WAR2_PNG_STRATEGY_HUFFMAN_ONLY = 2, /**< Z_HUFFMAN_ONLY */
+   WAR2_PNG_STRATEGY_RLE          = 3  /**< Z_RLE */
+} War2_Png_Strategy;
+
+/**
+ * @typedef War2_Png_Profile
+ * Sets of PNG options (see war2_png_options_init())
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_PNG_PROFILE_DEFAULT = 0, /**< Defaults of libpng */
+   WAR2_PNG_PROFILE_FAST    = 1, /**< Fast encoding, e.g. for previews */
+   WAR2_PNG_PROFILE_SMALL   = 2  /**< Smallest files, e.g. for archival */
+} War2_Png_Profile;
+
+/**
+ * Options of the PNG encoder
+ * @since 1.0.0
+ */
+typedef struct
+{
+   int               compression_level; /**< zlib level, from 0 (none) to 9 (best). -1 for the default */
+   War2_Png_Filter   filter; /**< Row filters */
+   War2_Png_Strategy strategy; /**< zlib strategy */
+   size_t            buffer_size; /**< Size of the compression buffer. 0 for the default */
+} War2_Png_Options;
+
+/**
+ * @typedef War2_Image_Format
+ * Formats of the images written by a War2_Image_Encoder
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_IMAGE_FORMAT_PNG  = 0, /**< RGBA PNG. Requires PNG support */
+   WAR2_IMAGE_FORMAT_JPEG = 1, /**< RGB JPEG. Requires JPEG support */
+   WAR2_IMAGE_FORMAT_PPM  = 2, /**< Binary RGB PPM (P6) */
+   WAR2_IMAGE_FORMAT_QOI  = 3  /**< RGBA QOI (see war2_qoi_write()) */
+} War2_Image_Format;
+
+/**
+ * @typedef War2_Image_Write_Func
+ * Function that receives the bytes produced by a War2_Image_Encoder, in
+ * order. It returns PUD_FALSE if the bytes could not be written, which
+ * makes the encoder fail.
+ * @since 1.0.0
+ */
+typedef Pud_Bool (*War2_Image_Write_Func)(void *data, const unsigned char *bytes, size_t size);
+
+/**
+ * @typedef War2_Image_Encoder
+ * Opaque type that encodes an image whose rows are given progressively.
+ * Rows are converted as they come, so the encoder never holds a copy of
+ * the whole image.
+ * @since 1.0.0
+ */
+typedef struct _War2_Image_Encoder War2_Image_Encoder;
+
 /**
  * @typedef War2_Font
  *
@@ -90,8 +212,101 @@ typedef struct
 {
    Pud_Era       era; /**< Current era */
    unsigned int  tiles; /**< Total amount of decoded tiles */
+
+   /**
+    * Pixels of the tile being decoded, in the pixel format of the
+    * decoder (see war2_decoder_pixel_format_set()). They are only valid
+    * during the execution of the decoding callback.
+    */
+   const void       *pixels;
+   Pud_Pixel_Format  pixel_format; /**< Format of @c pixels */
 } War2_Tileset_Descriptor;
 
+/**
+ * First tile ID (as stored in MTXM) that can be found in a tileset
+ * @since 1.0.0
+ */
+#define WAR2_TILESET_TILE_FIRST 0x0010
+
+/**
+ * Last tile ID (as stored in MTXM) that can be found in a tileset
+ * @since 1.0.0
+ */
+#define WAR2_TILESET_TILE_LAST 0x09df
+
+/**
+ * Tile ID that designates the absence of a tile
+ * @since 1.0.0
+ */
+#define WAR2_TILESET_TILE_NONE 0xffff
+
+/**
+ * Count of tiles per row in a tileset atlas
+ * @since 1.0.0
+ */
+#define WAR2_TILESET_ATLAS_COLUMNS 16
+
+/**
+ * Value of a slot of War2_Tileset_Atlas for a tile that is not in the atlas
+ * @since 1.0.0
+ */
+#define WAR2_TILESET_ATLAS_NONE 0xffff
+
+/**
+ * @typedef War2_Tileset_Atlas_Flags
+ * Formats of the images of a tileset atlas
+ * @since 1.0.0
+ */
+typedef enum
+{
+   WAR2_TILESET_ATLAS_RGBA    = (1 << 0), /**< Generate an RGBA image */
+   WAR2_TILESET_ATLAS_INDEXED = (1 << 1)  /**< Generate palette indexes */
+} War2_Tileset_Atlas_Flags;
+
+/**
+ * All the tiles of an era packed in a single image. Tiles are 32x32
+ * and laid out WAR2_TILESET_ATLAS_COLUMNS per row. Tiles that render to
+ * the same image share a slot.
+ * @since 1.0.0
+ */
+typedef struct
+{
+   Pud_Era        era; /**< Era of the tileset */
+   unsigned int   w; /**< Width of the atlas, in pixels */
+   unsigned int   h; /**< Height of the atlas, in pixels */
+   unsigned int   tiles; /**< Count of (unique) tiles in the atlas */
+   Pud_Color     *rgba; /**< RGBA pixels, or NULL if not requested */
+   unsigned char *indexes; /**< Palette indexes, or NULL if not requested */
+
+   /** Position of each tile ID (minus WAR2_TILESET_TILE_FIRST) in the atlas,
+    * or WAR2_TILESET_ATLAS_NONE */
+   uint16_t       slots[WAR2_TILESET_TILE_LAST - WAR2_TILESET_TILE_FIRST + 1];
+} War2_Tileset_Atlas;
+
+/**
+ * @typedef War2_Tileset_Encoder
+ * Opaque type that converts 32x32 RGBA tiles into tileset entries.
+ * Minitiles are shared between the tiles, flipped if needed.
+ * @since 1.0.0
+ */
+typedef struct _War2_Tileset_Encoder War2_Tileset_Encoder;
+
+/**
+ * Entries of a tileset, as produced by war2_tileset_encoder_encode().
+ * Each of them has the layout of the corresponding entry of the data
+ * file, and is to be released with free().
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned char *megatiles; /**< 16 minitile words per megatile */
+   size_t         megatiles_size; /**< Size of @c megatiles, in bytes */
+   unsigned char *minitiles; /**< 8x8 palette indexes per minitile */
+   size_t         minitiles_size; /**< Size of @c minitiles, in bytes */
+   unsigned char *map; /**< Megatile of each tile ID */
+   size_t         map_size; /**< Size of @c map, in bytes */
+} War2_Tileset_Entries;
+
 /**
  * Type to map a cursor to its associated entry
  * @since 1.0.0
@@ -125,6 +340,103 @@ typedef enum
    __WAR2_CURSOR_FIRST                  = WAR2_CURSOR_HUMAN_POINTER /**< Alias to the first cursor */
 } War2_Cursor;
 
+/**
+ * Count of cursors (entries __WAR2_CURSOR_FIRST to __WAR2_CURSOR_LAST)
+ * @since 1.0.0
+ */
+#define WAR2_CURSORS_COUNT (__WAR2_CURSOR_LAST - __WAR2_CURSOR_FIRST)
+
+/**
+ * An image packed in a War2_Images_Atlas
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned int entry; /**< Entry the image was decoded from */
+   unsigned int x; /**< X position of the image in the atlas */
+   unsigned int y; /**< Y position of the image in the atlas */
+   unsigned int w; /**< Width of the image */
+   unsigned int h; /**< Height of the image */
+   int          hot_x; /**< Hot X position (cursors only) */
+   int          hot_y; /**< Hot Y position (cursors only) */
+} War2_Atlas_Image;
+
+/**
+ * Several images packed in a single RGBA image
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned int      w; /**< Width of the atlas, in pixels */
+   unsigned int      h; /**< Height of the atlas, in pixels */
+   Pud_Color        *rgba; /**< Pixels of the atlas. Unused pixels are transparent */
+   unsigned int      count; /**< Count of images */
+   War2_Atlas_Image  images[]; /**< The images, in the order they were requested */
+} War2_Images_Atlas;
+
+/**
+ * An icon of a cached icon sheet (see war2_icon_get())
+ * @since 1.0.0
+ */
+typedef struct
+{
+   const Pud_Color     *pixels; /**< w * h pixels, with the colors of the red player */
+   const unsigned char *indexes; /**< w * h palette indexes of the pixels */
+   int                  x; /**< X offset of the icon */
+   int                  y; /**< Y offset of the icon */
+   unsigned int         w; /**< Width of the icon */
+   unsigned int         h; /**< Height of the icon */
+} War2_Icon;
+
+/**
+ * Horizontal extent of the opaque pixels within one row of a sprite frame
+ * @since 1.0.0
+ */
+typedef struct
+{
+   uint16_t start; /**< X of the first opaque pixel of the row */
+   uint16_t end; /**< X following the last opaque pixel. Equals @c start for an empty row */
+} War2_Sprite_Span;
+
+/**
+ * 1-bit opacity mask of a sprite frame
+ *
+ * Each row of the frame is stored in @c words_per_row 64-bits words.
+ * Pixel @c x of a row is opaque if the bit @c (x % 64) (least significant
+ * bit first) of the word @c (x / 64) is set.
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned int            w; /**< Width of the frame */
+   unsigned int            h; /**< Height of the frame */
+   unsigned int            words_per_row; /**< Count of 64-bits words per row */
+   const uint64_t         *bits; /**< Mask rows (h * words_per_row words) */
+   const War2_Sprite_Span *spans; /**< Opaque span of each row (h spans) */
+} War2_Sprite_Mask;
+
+/**
+ * @typedef War2_Sprites_Encoder
+ * Opaque type that converts RGBA images into sprites entries.
+ * It caches the palette lookups, so one encoder should be kept for all
+ * the images that use the same palette.
+ * @since 1.0.0
+ */
+typedef struct _War2_Sprites_Encoder War2_Sprites_Encoder;
+
+/**
+ * A frame to be encoded by war2_sprites_encoder_encode()
+ * @since 1.0.0
+ */
+typedef struct
+{
+   const Pud_Color *pixels; /**< w * h pixels, row by row */
+   unsigned int     x; /**< X offset of the frame in the sprite (0-255) */
+   unsigned int     y; /**< Y offset of the frame in the sprite (0-255) */
+   unsigned int     w; /**< Width of the frame (0-255) */
+   unsigned int     h; /**< Height of the frame (0-255) */
+} War2_Sprite_Frame;
+
 /**
  * Type that holds information about a current sprite deconding
  * @since 1.0.0
@@ -136,6 +448,31 @@ typedef struct
    Pud_Side     side; /**< Side (when appliable) */
    unsigned int object; /**< Decoded object */
    War2_Sprites sprite_type; /**< Sprite type */
+
+   /**
+    * Opacity mask of the sprite being decoded. It is only valid during
+    * the execution of the decoding callback. Use war2_sprite_mask_dup()
+    * to keep it around.
+    */
+   const War2_Sprite_Mask *mask;
+
+   /**
+    * Palette indexes of the sprite being decoded (w * h bytes), before
+    * colorization. They are only valid during the execution of the
+    * decoding callback.
+    */
+   const unsigned char *indexes;
+
+   /**
+    * Pixels of the sprite being decoded, in the pixel format of the
+    * decoder (see war2_decoder_pixel_format_set()). They are only valid
+    * during the execution of the decoding callback.
+    */
+   const void *pixels;
+   Pud_Pixel_Format pixel_format; /**< Format of @c pixels */
+
+   unsigned int max_w; /**< Width of the box that contains all the frames */
+   unsigned int max_h; /**< Height of the box that contains all the frames */
 } War2_Sprites_Descriptor;
 
 /**
@@ -173,6 +510,42 @@ typedef struct
    void *data;
 } War2_Font_Decoder;
 
+/**
+ * Count of glyphs per row in a font atlas
+ * @since 1.0.0
+ */
+#define WAR2_FONT_ATLAS_COLUMNS 16
+
+/**
+ * Position and metrics of a glyph in a font atlas
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned int x; /**< X position of the glyph bitmap in the atlas */
+   unsigned int y; /**< Y position of the glyph bitmap in the atlas */
+   unsigned int w; /**< Width of the bitmap. 0 for blank glyphs */
+   unsigned int h; /**< Height of the bitmap. 0 for blank glyphs */
+   unsigned int x_offset; /**< X position of the bitmap from the pen */
+   unsigned int y_offset; /**< Y position of the bitmap from the top of the line */
+   unsigned int advance; /**< Move of the pen after the glyph. 0 if the
+                              font does not have the glyph */
+} War2_Font_Glyph;
+
+/**
+ * All the glyphs of a font decoded in a single RGBA image
+ * @since 1.0.0
+ */
+typedef struct
+{
+   War2_Font        font; /**< The decoded font */
+   unsigned int     line_height; /**< Distance between two lines of text */
+   unsigned int     w; /**< Width of the atlas, in pixels */
+   unsigned int     h; /**< Height of the atlas, in pixels */
+   Pud_Color       *rgba; /**< Pixels of the atlas. Unused pixels are transparent */
+   War2_Font_Glyph  glyphs[256]; /**< Glyphs, indexed by character */
+} War2_Font_Atlas;
+
 
 /**
  * @typedef War2_Tileset_Decode_Func
@@ -192,6 +565,85 @@ typedef void (*War2_Tileset_Decode_Func)(void *data,
                                          const War2_Tileset_Descriptor *ts,
                                          uint16_t tile_id);
 
+/**
+ * @typedef War2_Map_Renderer
+ * Opaque handle that keeps the rendered image of a map, to update it
+ * when the map changes
+ * @since 1.0.0
+ */
+typedef struct _War2_Map_Renderer War2_Map_Renderer;
+
+/**
+ * A cell of a map
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned int x; /**< Column of the cell */
+   unsigned int y; /**< Row of the cell */
+} War2_Map_Cell;
+
+/**
+ * A rectangle in the rendered image of a map, in pixels
+ * @since 1.0.0
+ */
+typedef struct
+{
+   unsigned int x; /**< X coordinate of the top-left corner */
+   unsigned int y; /**< Y coordinate of the top-left corner */
+   unsigned int w; /**< Width. 0 if the rectangle is empty */
+   unsigned int h; /**< Height. 0 if the rectangle is empty */
+} War2_Map_Rect;
+
+/**
+ * Count of zoom levels generated by war2_map_pyramid(). Level z has
+ * (1 << z) pixels per map tile: from 1 (minimap) to 32 (full resolution).
+ * @since 1.0.0
+ */
+#define WAR2_MAP_PYRAMID_LEVELS 6
+
+/**
+ * Width and height of the images generated by war2_map_pyramid()
+ * @since 1.0.0
+ */
+#define WAR2_MAP_PYRAMID_TILE_SIZE 256
+
+/**
+ * @typedef War2_Map_Pyramid_Func
+ * Callback that receives the images of a map pyramid
+ * @param data User provided data
+ * @param tile The pixels of the image (WAR2_MAP_PYRAMID_TILE_SIZE squared).
+ *             They are only valid during the execution of the callback.
+ * @param z The zoom level of the image
+ * @param x The column of the image in its level
+ * @param y The row of the image in its level
+ * @return PUD_TRUE on success, PUD_FALSE to make the generation fail
+ * @since 1.0.0
+ */
+typedef Pud_Bool (*War2_Map_Pyramid_Func)(void            *data,
+                                          const Pud_Color *tile,
+                                          unsigned int     z,
+                                          unsigned int     x,
+                                          unsigned int     y);
+
+/**
+ * @typedef War2_Map_Render_Func
+ * Callback that receives the rendered image of a map, band by band
+ * @param data User provided data
+ * @param band The pixels of the band (@p w * @p h). They are only valid
+ *             during the execution of the callback.
+ * @param y Vertical position of the band in the map image, in pixels
+ * @param w The width of the band (and of the map image), in pixels
+ * @param h The height of the band, in pixels
+ * @return PUD_TRUE to continue the rendering, PUD_FALSE to abort it
+ * @since 1.0.0
+ */
+typedef Pud_Bool (*War2_Map_Render_Func)(void            *data,
+                                         const Pud_Color *band,
+                                         unsigned int     y,
+                                         unsigned int     w,
+                                         unsigned int     h);
+
 /**
  * @typedef War2_Sprites_Decode_Func
  * Callback used fir each sprite to be decoded
@@ -288,6 +740,91 @@ PUDAPI void war2_verbosity_set(War2_Data *w2, int level);
  */
 PUDAPI unsigned char *war2_entry_extract(War2_Data *w2, unsigned int entry, size_t *size_ret);
 
+/**
+ * Create a new decoding context
+ *
+ * @return A decoder on success, NULL on failure
+ * @see war2_decoder_free()
+ * @since 1.0.0
+ */
+PUDAPI War2_Decoder *war2_decoder_new(void);
+
+/**
+ * Release a decoding context and all its buffers
+ *
+ * All data returned by functions that were given @p dec become invalid.
+ *
+ * @param dec The decoder to be freed. May be NULL.
+ * @see war2_decoder_new()
+ * @since 1.0.0
+ */
+PUDAPI void war2_decoder_free(War2_Decoder *dec);
+
+/**
+ * Set the format of the pixels produced by a decoder
+ *
+ * Decoding callbacks receive the pixels in this format through their
+ * descriptor (see War2_Sprites_Descriptor and War2_Tileset_Descriptor),
+ * and the pixels of the last UI element or cursor are given by
+ * war2_decoder_pixels_get(). Images are converted while they are
+ * decoded, so they can be handed to cairo or SDL as they are. RGBA
+ * images given as Pud_Color are always produced.
+ *
+ * @param dec A valid decoder
+ * @param pfmt The pixel format. PUD_PIXEL_FORMAT_RGBA by default.
+ * @return PUD_TRUE on success, PUD_FALSE if @p pfmt is invalid
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_decoder_pixel_format_set(War2_Decoder     *dec,
+                              Pud_Pixel_Format  pfmt);
+
+/**
+ * Get the format of the pixels produced by a decoder
+ *
+ * @param dec A valid decoder
+ * @return The pixel format of @p dec
+ * @since 1.0.0
+ */
+PUDAPI Pud_Pixel_Format
+war2_decoder_pixel_format_get(const War2_Decoder *dec);
+
+/**
+ * Get the pixels of the last UI element or cursor decoded by a decoder,
+ * in the pixel format of the decoder
+ *
+ * @param dec A valid decoder
+ * @return The pixels, owned by @p dec, with the size of the image
+ *         returned by war2_decoder_ui_decode() or
+ *         war2_decoder_cursors_decode(). They are valid until the next
+ *         decoding with @p dec. NULL if no UI element or cursor has been
+ *         decoded.
+ * @since 1.0.0
+ */
+PUDAPI const void *
+war2_decoder_pixels_get(const War2_Decoder *dec);
+
+/**
+ * Extract the contents of a data entry by using a decoder
+ *
+ * Unlike war2_entry_extract(), the returned data is owned by @p w2 or
+ * by @p dec and MUST NOT be freed. It is valid until the next call to
+ * war2_decoder_entry_extract() with the same decoder, or until @p w2 or
+ * @p dec are released.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param dec A valid decoder
+ * @param entry The ID of the entry to extract
+ * @param size_ret Used to return the size of the extracted data
+ * @return The contents of the entry @c entry. NULL on failure
+ * @since 1.0.0
+ */
+PUDAPI const unsigned char *
+war2_decoder_entry_extract(War2_Data     *w2,
+                           War2_Decoder  *dec,
+                           unsigned int   entry,
+                           size_t        *size_ret);
+
 /**
  * Extract a palette from a data file
  *
@@ -311,19 +848,299 @@ PUDAPI const Pud_Color *war2_palette_get(const War2_Data *w2, Pud_Era era);
 PUDAPI unsigned int war2_tileset_decode(War2_Data *w2, Pud_Era era, War2_Tileset_Decode_Func func, void *data);
 
 /**
- * Decode sprites for a given object, color and era
+ * Decode a tileset by using a decoder
  *
  * @param w2 A valid handle to Warcraft 2 data file
- * @param player_color The color of the sprites
- * @param era The era of the sprites
- * @param object The object to decode. To decode ICONS, pass WAR2_SPRITES_ICONS.
- * To decode units or buildings, pass the corresponding value of Pud_Unit.
- * @param func User callback to be called for each decoded sprite
- * @param data User data passed to @c func
- * @return PUD_TRUE on success, PUD_FALSE on failure
- * @since 1.0.0
- */
-PUDAPI Pud_Bool
+ * @param dec A valid decoder
+ * @param era The era of the tileset
+ * @param func A user callback to be called for each decoded tile
+ * @param data A user data passed to @c func
+ * @return How many tiles were decoded
+ * @see war2_tileset_decode()
+ * @since 1.0.0
+ */
+PUDAPI unsigned int
+war2_decoder_tileset_decode(War2_Data                *w2,
+                            War2_Decoder             *dec,
+                            Pud_Era                   era,
+                            War2_Tileset_Decode_Func  func,
+                            void                     *data);
+
+/**
+ * Get which tiles of an era render to the same image
+ *
+ * Tiles IDs that render to identical images (e.g. variants of solid
+ * tiles, or megatiles used several times) are equivalent. Each group of
+ * equivalent tiles is represented by its lowest tile ID.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param era The era of the tileset
+ * @param unique Where to store the count of distinct images. May be NULL.
+ * @return A table that gives, for each tile ID (minus
+ *         WAR2_TILESET_TILE_FIRST), the ID of its representative, or
+ *         WAR2_TILESET_TILE_NONE if the tile is not in the tileset. It is
+ *         owned by @p w2. NULL on failure.
+ * @since 1.0.0
+ */
+PUDAPI const uint16_t *
+war2_tileset_equivalences_get(War2_Data    *w2,
+                              Pud_Era       era,
+                              unsigned int *unique);
+
+/**
+ * Compute the minimap color of every tile of an era
+ *
+ * The color of a tile is the average of its pixels, packed as 0xRRGGBB.
+ * Tiles that are not in the tileset are black.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param era The era of the tileset
+ * @param colors Where to write WAR2_TILESET_TILE_LAST + 1 colors, indexed
+ *               by tile ID
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_tileset_minimap_colors_get(War2_Data *w2,
+                                Pud_Era    era,
+                                uint32_t  *colors);
+
+/**
+ * Decode all the tiles of an era in a single atlas
+ *
+ * The atlas is sized from the tiles actually populated in the tileset,
+ * and war2_tileset_atlas_rect_get() gives the position of a tile.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param era The era of the tileset
+ * @param flags Which images are generated
+ * @return The atlas, to be released with war2_tileset_atlas_free().
+ *         NULL on failure.
+ * @since 1.0.0
+ */
+PUDAPI War2_Tileset_Atlas *
+war2_tileset_atlas_new(War2_Data                *w2,
+                       Pud_Era                   era,
+                       War2_Tileset_Atlas_Flags  flags);
+
+/**
+ * Release an atlas
+ *
+ * @param atlas The atlas to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_tileset_atlas_free(War2_Tileset_Atlas *atlas);
+
+/**
+ * Create a tileset encoder for a given palette
+ *
+ * @param palette A palette of WAR2_PALETTE_SIZE colors (e.g. obtained
+ *                with war2_palette_get()). It is copied.
+ * @return A new encoder. NULL on failure.
+ * @see war2_tileset_encoder_free()
+ * @since 1.0.0
+ */
+PUDAPI War2_Tileset_Encoder *war2_tileset_encoder_new(const Pud_Color *palette);
+
+/**
+ * Release a tileset encoder
+ *
+ * @param enc The encoder to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_tileset_encoder_free(War2_Tileset_Encoder *enc);
+
+/**
+ * Add a tile to a tileset encoder
+ *
+ * The tile is split into 8x8 minitiles. Minitiles that are already known,
+ * as is or flipped, are not stored again, and neither are tiles that are
+ * made of the same minitiles as a previous one. Colors are mapped to the
+ * nearest color of the palette. Adding a tile ID twice replaces it.
+ *
+ * @param enc A valid encoder
+ * @param tile The ID of the tile (as stored in MTXM)
+ * @param img The 32x32 RGBA pixels of the tile, row by row
+ * @return PUD_TRUE on success, PUD_FALSE if the tile ID is invalid or if
+ *         there are too many different minitiles or megatiles
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_tileset_encoder_tile_add(War2_Tileset_Encoder *enc,
+                              uint16_t              tile,
+                              const Pud_Color      *img);
+
+/**
+ * Produce the entries of the tiles added to an encoder
+ *
+ * The entries can be decoded as the tileset entries of an era. The
+ * encoder may still be used afterwards.
+ *
+ * @param enc A valid encoder
+ * @param entries Where to store the entries
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_tileset_encoder_encode(War2_Tileset_Encoder *enc,
+                            War2_Tileset_Entries *entries);
+
+/**
+ * Render a map with its terrain, units and buildings
+ *
+ * The map image is 32 pixels per tile. It is never held in memory at
+ * once: it is rendered in horizontal bands, several at a time in
+ * parallel, that are given to @p func from top to bottom.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param pud The map to be rendered
+ * @param func User callback called for each band
+ * @param data User data passed to @p func
+ * @return PUD_TRUE on success, PUD_FALSE on failure or if @p func
+ *         aborted the rendering
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_map_render(War2_Data            *w2,
+                const Pud            *pud,
+                War2_Map_Render_Func  func,
+                void                 *data);
+
+/**
+ * Render a map in a PNG file
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param pud The map to be rendered
+ * @param file Path to the PNG file to be written
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @see war2_map_render()
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_map_render_png(War2_Data  *w2,
+                    const Pud  *pud,
+                    const char *file);
+
+/**
+ * Generate the zoom levels of a map, cut in square images
+ *
+ * The map is rendered once with war2_map_render(), and each level is
+ * obtained by downsampling the level above by 2. The two lowest levels
+ * (1 and 2 pixels per tile) are made from the minimap of the map
+ * instead (see pud_minimap_bitmap_generate()), so @p pud must be
+ * readable. Images on the right and bottom edges of a level are padded
+ * with transparent pixels.
+ *
+ * Images of a same row are generated in parallel: @p func may be called
+ * from several threads at the same time.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param pud The map to be rendered
+ * @param func User callback called for each image
+ * @param data User data passed to @p func
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_map_pyramid(War2_Data             *w2,
+                 const Pud             *pud,
+                 War2_Map_Pyramid_Func  func,
+                 void                  *data);
+
+/**
+ * Generate the zoom levels of a map as PNG files
+ *
+ * Files are named @p prefix_z_x_y.png.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param pud The map to be rendered
+ * @param prefix Prefix of the path of the files
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @see war2_map_pyramid()
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_map_pyramid_png(War2_Data  *w2,
+                     const Pud  *pud,
+                     const char *prefix);
+
+/**
+ * Render a map and keep its image, to update it as the map is edited
+ *
+ * The map is rendered as with war2_map_render(), but the whole image is
+ * kept in memory. @p pud must stay valid until the renderer is freed.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param pud The map to be rendered
+ * @return A renderer, to be released with war2_map_renderer_free().
+ *         NULL on failure.
+ * @see war2_map_renderer_update()
+ * @since 1.0.0
+ */
+PUDAPI War2_Map_Renderer *
+war2_map_renderer_new(War2_Data *w2,
+                      const Pud *pud);
+
+/**
+ * Release a map renderer
+ *
+ * @param r The renderer to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_map_renderer_free(War2_Map_Renderer *r);
+
+/**
+ * Get the rendered image of a map
+ *
+ * @param r A map renderer
+ * @param w Where to store the width of the image. May be NULL.
+ * @param h Where to store the height of the image. May be NULL.
+ * @return The pixels of the image, owned by @p r. They are modified by
+ *         war2_map_renderer_update().
+ * @since 1.0.0
+ */
+PUDAPI const Pud_Color *
+war2_map_renderer_pixels_get(const War2_Map_Renderer *r,
+                             unsigned int            *w,
+                             unsigned int            *h);
+
+/**
+ * Update the image of a map after some of its cells changed
+ *
+ * Only the changed cells and the cells covered by the units that
+ * occupy them (before or after the change) are drawn again. Units that
+ * have been added with pud_unit_add() or removed must be reported by
+ * one of the cells they occupy. If the map has been resized, it is
+ * rendered again entirely.
+ *
+ * @param r A map renderer
+ * @param cells The cells that changed (tiles or units)
+ * @param count Count of @p cells
+ * @param dirty Where to store the area of the image that has been
+ *              drawn again. May be NULL.
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_map_renderer_update(War2_Map_Renderer   *r,
+                         const War2_Map_Cell *cells,
+                         unsigned int         count,
+                         War2_Map_Rect       *dirty);
+
+/**
+ * Decode sprites for a given object, color and era
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param player_color The color of the sprites
+ * @param era The era of the sprites
+ * @param object The object to decode. To decode ICONS, pass WAR2_SPRITES_ICONS.
+ * To decode units or buildings, pass the corresponding value of Pud_Unit.
+ * @param func User callback to be called for each decoded sprite
+ * @param data User data passed to @c func
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
 war2_sprites_decode(War2_Data                *w2,
                     Pud_Player                player_color,
                     Pud_Era                   era,
@@ -332,11 +1149,103 @@ war2_sprites_decode(War2_Data                *w2,
                     void                     *data);
 
 
+/**
+ * Decode sprites for a given object, color and era by using a decoder
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param dec A valid decoder
+ * @param player_color The color of the sprites
+ * @param era The era of the sprites
+ * @param object The object to decode (see war2_sprites_decode())
+ * @param func User callback to be called for each decoded sprite
+ * @param data User data passed to @c func
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @see war2_sprites_decode()
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_decoder_sprites_decode(War2_Data                *w2,
+                            War2_Decoder             *dec,
+                            Pud_Player                player_color,
+                            Pud_Era                   era,
+                            unsigned int              object,
+                            War2_Sprites_Decode_Func  func,
+                            void                     *data);
+
+
 PUDAPI Pud_Bool
 war2_font_decode(War2_Data *w2,
                  War2_Font font_to_decode,
                  const War2_Font_Decoder *decoder);
 
+/**
+ * Decode all the glyphs of a font in an atlas
+ *
+ * The atlas is meant to be kept: text is then rendered from it with
+ * war2_text_render(), without decoding the font again.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param font_to_decode The font to be decoded
+ * @return The atlas, to be released with war2_font_atlas_free().
+ *         NULL on failure.
+ * @since 1.0.0
+ */
+PUDAPI War2_Font_Atlas *
+war2_font_atlas_new(War2_Data *w2,
+                    War2_Font  font_to_decode);
+
+/**
+ * Release a font atlas
+ *
+ * @param atlas The atlas to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_font_atlas_free(War2_Font_Atlas *atlas);
+
+/**
+ * Get the size of the box a text is rendered in
+ *
+ * @param atlas A valid font atlas
+ * @param text The text, in UTF-8 (see war2_text_render())
+ * @param w Where to store the width of the longest line. May be NULL.
+ * @param h Where to store the height of all the lines. May be NULL.
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_text_size_get(const War2_Font_Atlas *atlas,
+                   const char            *text,
+                   unsigned int          *w,
+                   unsigned int          *h);
+
+/**
+ * Render a text in an RGBA image
+ *
+ * Characters are decoded from UTF-8. Bytes that are not part of a valid
+ * UTF-8 sequence are taken as Latin-1 characters, so plain ASCII and
+ * Latin-1 strings are supported as well. Characters the font does not
+ * have are skipped, and '\n' starts a new line. The text is clipped to
+ * the image, and only the opaque pixels of the glyphs are drawn.
+ *
+ * @param atlas A valid font atlas
+ * @param text The text to be rendered
+ * @param img The image to draw in, @p img_w * @p img_h pixels
+ * @param img_w The width of @p img
+ * @param img_h The height of @p img
+ * @param x X position of the top-left corner of the text. May be negative.
+ * @param y Y position of the top-left corner of the text. May be negative.
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_text_render(const War2_Font_Atlas *atlas,
+                 const char            *text,
+                 Pud_Color             *img,
+                 unsigned int           img_w,
+                 unsigned int           img_h,
+                 int                    x,
+                 int                    y);
+
 /**
  * Decode sprites in a given entry
  *
@@ -355,6 +1264,27 @@ war2_sprites_decode_entry(War2_Data                *w2,
                           War2_Sprites_Decode_Func  func,
                           void                     *data);
 
+/**
+ * Decode sprites in a given entry by using a decoder
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param dec A valid decoder
+ * @param player_color The color of the sprites
+ * @param entry The entry to decode
+ * @param func User callback to be called for each decoded sprite
+ * @param data User data passed to @c func
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @see war2_sprites_decode_entry()
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_decoder_sprites_decode_entry(War2_Data                *w2,
+                                  War2_Decoder             *dec,
+                                  Pud_Player                player_color,
+                                  unsigned int              entry,
+                                  War2_Sprites_Decode_Func  func,
+                                  void                     *data);
+
 /**
  * Decode a cursor from an entry
  *
@@ -393,6 +1323,102 @@ war2_ui_decode(War2_Data *w2,
                unsigned int *w,
                unsigned int *h);
 
+/**
+ * Decode a cursor from an entry by using a decoder
+ *
+ * @param[in] w2 A valid handle to Warcract 2 data file
+ * @param[in] dec A valid decoder
+ * @param[in] entry An assumed valid entry to a cursor
+ * @param[out] x The hot X position of the decoded cursor
+ * @param[out] y The hot Y position of the decoded cursor
+ * @param[out] w The width of the cursor
+ * @param[out] h The height of the cursor
+ * @return The bitmap of the cursor. NULL on failure. It is owned by
+ *         @p dec and is valid until the next decoding of an UI element
+ *         or a cursor with @p dec.
+ * @see war2_cursors_decode()
+ * @since 1.0.0
+ */
+PUDAPI const Pud_Color *
+war2_decoder_cursors_decode(War2_Data    *w2,
+                            War2_Decoder *dec,
+                            unsigned int  entry,
+                            int          *x,
+                            int          *y,
+                            unsigned int *w,
+                            unsigned int *h);
+
+/**
+ * Decode a user interface (UI element) by using a decoder
+ *
+ * @param[in] w2 A valid handle to Warcract 2 data file
+ * @param[in] dec A valid decoder
+ * @param[in] entry An assumed valid entry to an UI item
+ * @param[out] w The width of the image
+ * @param[out] h The height of the image
+ * @return The decoded image for the UI element. NULL on failure. It is
+ *         owned by @p dec and is valid until the next decoding of an UI
+ *         element or a cursor with @p dec.
+ * @see war2_ui_decode()
+ * @since 1.0.0
+ */
+PUDAPI const Pud_Color *
+war2_decoder_ui_decode(War2_Data    *w2,
+                       War2_Decoder *dec,
+                       unsigned int  entry,
+                       unsigned int *w,
+                       unsigned int *h);
+
+/**
+ * Decode all the cursors and some UI elements in a single atlas
+ *
+ * Images are packed so the whole atlas can be uploaded at once. The
+ * first WAR2_CURSORS_COUNT images are the cursors, in the order of
+ * War2_Cursor (see war2_images_atlas_cursor_get()), then come the UI
+ * elements in the order of @p ui_entries.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param ui_entries Entries of the UI elements to be decoded. May be NULL
+ *                   if @p ui_count is 0.
+ * @param ui_count Count of elements in @p ui_entries
+ * @return The atlas, to be released with war2_images_atlas_free().
+ *         NULL on failure.
+ * @since 1.0.0
+ */
+PUDAPI War2_Images_Atlas *
+war2_cursors_atlas_new(War2_Data          *w2,
+                       const unsigned int *ui_entries,
+                       unsigned int        ui_count);
+
+/**
+ * Release an images atlas
+ *
+ * @param atlas The atlas to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_images_atlas_free(War2_Images_Atlas *atlas);
+
+/**
+ * Get an icon without decoding the icons entry
+ *
+ * All the icons of @p era are decoded on the first call and kept until
+ * war2_close(), so next calls are a simple lookup. Icons are given with the
+ * colors of the red player: use their indexes with a palette returned by
+ * war2_sprites_palette_colorize() for other players.
+ *
+ * @param w2 A valid handle to Warcraft 2 data file
+ * @param era The era of the icon
+ * @param icon The icon to get (e.g. from pud_unit_icon_get() or
+ *             pud_upgrade_icon_get())
+ * @return The icon, owned by @p w2. NULL if @p icon does not exist or
+ *         on failure.
+ * @since 1.0.0
+ */
+PUDAPI const War2_Icon *
+war2_icon_get(War2_Data *w2,
+              Pud_Era    era,
+              Pud_Icon   icon);
+
 /**
  * Write a bitmap as a PNG image on the filesystem.
  *
@@ -414,6 +1440,86 @@ PUDAPI Pud_Bool war2_png_write(const char          *file,
                                unsigned int         h,
                                const unsigned char *data);
 
+/**
+ * Fill PNG options with a profile
+ *
+ * @param opts The options to be filled
+ * @param profile The profile of the options
+ * @since 1.0.0
+ */
+PUDAPI void war2_png_options_init(War2_Png_Options *opts,
+                                  War2_Png_Profile  profile);
+
+/**
+ * Write a bitmap as a PNG image on the filesystem, with tuned encoding
+ *
+ * @param file The path where to save the png file
+ * @param w The width of the bitmap
+ * @param h The height of the bitmap
+ * @param data The bitmap data (see war2_png_write())
+ * @param opts The options of the encoder. May be NULL to use the
+ *             defaults, as war2_png_write() does.
+ * @return PUD_TRUE on success, PUD_FALSE on failure or if @p opts is invalid
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool war2_png_write_full(const char             *file,
+                                    unsigned int            w,
+                                    unsigned int            h,
+                                    const unsigned char    *data,
+                                    const War2_Png_Options *opts);
+
+/**
+ * Write a large bitmap as a PNG image, encoding it on several threads
+ *
+ * The image is cut in stripes of rows that are filtered and compressed
+ * in parallel, then gathered in a single PNG file. Each stripe is primed
+ * with the end of the previous one, so files are barely larger than the
+ * ones written by war2_png_write_full(). This is worth it for images of
+ * several megapixels, such as map renders.
+ *
+ * @param file The path where to save the png file
+ * @param w The width of the bitmap
+ * @param h The height of the bitmap
+ * @param data The bitmap data (see war2_png_write())
+ * @param opts The options of the encoder. May be NULL to use the
+ *             defaults. The buffer size is not used. The default filter
+ *             is the adaptive one.
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool war2_png_parallel_write(const char             *file,
+                                        unsigned int            w,
+                                        unsigned int            h,
+                                        const unsigned char    *data,
+                                        const War2_Png_Options *opts);
+
+/**
+ * Write palette indexes as an indexed PNG image on the filesystem
+ *
+ * The palette is stored in the file (PLTE), with the alpha of its colors
+ * (tRNS), so one byte is written per pixel instead of four. Decoders
+ * give the palette indexes of sprites (see War2_Sprites_Descriptor) and
+ * tilesets (see WAR2_TILESET_ATLAS_INDEXED) along with their palette.
+ *
+ * @param file The path where to save the png file
+ * @param w The width of the image
+ * @param h The height of the image
+ * @param indexes The @p w * @p h palette indexes of the image. They
+ *                must all be lower than @p colors.
+ * @param palette The palette of the image
+ * @param colors Count of colors in @p palette (at most 256)
+ * @param opts The options of the encoder. May be NULL to use the defaults.
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool war2_png_indexed_write(const char             *file,
+                                       unsigned int            w,
+                                       unsigned int            h,
+                                       const unsigned char    *indexes,
+                                       const Pud_Color        *palette,
+                                       unsigned int            colors,
+                                       const War2_Png_Options *opts);
+
 /**
  * Write a bitmap as a JPEG image on the filesystem.
  *
@@ -433,13 +1539,14 @@ PUDAPI Pud_Bool war2_jpeg_write(const char          *file,
                                 const unsigned char *data);
 
 /**
- * Write a bitmap as a PPM image on the filesystem.
+ * Write a bitmap as a binary (P6) PPM image on the filesystem.
  *
  * @param file The path where to save the ppm file
  * @param w The width of the bitmap
  * @param h The height of the bitmap
  * @param data The bitmap data
  * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @see war2_ppm_format_write()
  * @since 1.0.0
  */
 PUDAPI Pud_Bool war2_ppm_write(const char          *file,
@@ -447,6 +1554,201 @@ PUDAPI Pud_Bool war2_ppm_write(const char          *file,
                                unsigned int         h,
                                const unsigned char *data);
 
+/**
+ * Write a bitmap as a Netpbm image on the filesystem.
+ *
+ * @param file The path where to save the image
+ * @param w The width of the bitmap
+ * @param h The height of the bitmap
+ * @param data The bitmap data (RGBA)
+ * @param format The format of the file
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool war2_ppm_format_write(const char          *file,
+                                      unsigned int         w,
+                                      unsigned int         h,
+                                      const unsigned char *data,
+                                      War2_Ppm_Format      format);
+
+/**
+ * Write a bitmap as a QOI image on the filesystem.
+ *
+ * QOI (https://qoiformat.org) is a lossless format that is much faster
+ * to encode and decode than PNG, for files somewhat larger. It suits
+ * intermediate images that are written and read back by tools.
+ *
+ * @param file The path where to save the qoi file
+ * @param w The width of the bitmap
+ * @param h The height of the bitmap
+ * @param data The bitmap data (RGBA)
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool war2_qoi_write(const char          *file,
+                               unsigned int         w,
+                               unsigned int         h,
+                               const unsigned char *data);
+
+/**
+ * Decode a QOI image held in memory
+ *
+ * @param mem The QOI image
+ * @param size The size of @p mem, in bytes
+ * @param w_ret Where the width of the image is stored. May be NULL.
+ * @param h_ret Where the height of the image is stored. May be NULL.
+ * @return The RGBA pixels of the image, to be released with free(),
+ *         or NULL on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Color *war2_qoi_decode(const unsigned char *mem,
+                                  size_t               size,
+                                  unsigned int        *w_ret,
+                                  unsigned int        *h_ret);
+
+/**
+ * Read a QOI image from the filesystem
+ *
+ * @param file The path of the qoi file
+ * @param w_ret Where the width of the image is stored. May be NULL.
+ * @param h_ret Where the height of the image is stored. May be NULL.
+ * @return The RGBA pixels of the image, to be released with free(),
+ *         or NULL on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Color *war2_qoi_read(const char   *file,
+                                unsigned int *w_ret,
+                                unsigned int *h_ret);
+
+/**
+ * Create an encoder that gives the image it produces to a function
+ *
+ * @param format The format of the image
+ * @param w The width of the image
+ * @param h The height of the image
+ * @param func The function that receives the bytes of the image
+ * @param data The data passed to @p func
+ * @return The encoder, or NULL on failure
+ * @since 1.0.0
+ */
+PUDAPI War2_Image_Encoder *
+war2_image_encoder_new(War2_Image_Format      format,
+                       unsigned int           w,
+                       unsigned int           h,
+                       War2_Image_Write_Func  func,
+                       void                  *data);
+
+/**
+ * Create an encoder that writes the image it produces to a file
+ * descriptor. The descriptor is not closed by the encoder.
+ *
+ * @param format The format of the image
+ * @param w The width of the image
+ * @param h The height of the image
+ * @param fd The file descriptor (e.g. a socket or a pipe)
+ * @return The encoder, or NULL on failure
+ * @since 1.0.0
+ */
+PUDAPI War2_Image_Encoder *
+war2_image_encoder_fd_new(War2_Image_Format format,
+                          unsigned int      w,
+                          unsigned int      h,
+                          int               fd);
+
+/**
+ * Create an encoder that keeps the image it produces in memory
+ *
+ * @param format The format of the image
+ * @param w The width of the image
+ * @param h The height of the image
+ * @return The encoder, or NULL on failure
+ * @see war2_image_encoder_buffer_get()
+ * @since 1.0.0
+ */
+PUDAPI War2_Image_Encoder *
+war2_image_encoder_buffer_new(War2_Image_Format format,
+                              unsigned int      w,
+                              unsigned int      h);
+
+/**
+ * Set the options of a PNG encoder. They must be set before the first
+ * row is written.
+ *
+ * @param enc The encoder
+ * @param opts The options. NULL restores the defaults.
+ * @return PUD_TRUE on success, PUD_FALSE if the encoder does not write
+ *         PNG images or has already started
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_image_encoder_png_options_set(War2_Image_Encoder     *enc,
+                                   const War2_Png_Options *opts);
+
+/**
+ * Set the quality of a JPEG encoder. It must be set before the first
+ * row is written. The default is 100.
+ *
+ * @param enc The encoder
+ * @param quality The quality, from 1 to 100
+ * @return PUD_TRUE on success, PUD_FALSE if the encoder does not write
+ *         JPEG images, has already started or if @p quality is invalid
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_image_encoder_jpeg_quality_set(War2_Image_Encoder *enc,
+                                    int                 quality);
+
+/**
+ * Give rows of the image to an encoder
+ *
+ * @param enc The encoder
+ * @param rows @p count rows of RGBA pixels, each one as wide as the image
+ * @param count The count of rows. The total must not exceed the height
+ *              of the image.
+ * @return PUD_TRUE on success, PUD_FALSE on failure. Once it failed, the
+ *         encoder rejects any other row.
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_image_encoder_rows_write(War2_Image_Encoder *enc,
+                              const Pud_Color    *rows,
+                              unsigned int        count);
+
+/**
+ * Terminate the image of an encoder
+ *
+ * @param enc The encoder
+ * @return PUD_TRUE if all the rows of the image have been written and
+ *         the image has been fully produced, PUD_FALSE otherwise
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_image_encoder_finish(War2_Image_Encoder *enc);
+
+/**
+ * Get the image produced by an encoder created by
+ * war2_image_encoder_buffer_new(). It is complete once
+ * war2_image_encoder_finish() succeeded.
+ *
+ * @param enc The encoder
+ * @param size Where the size of the image is stored. Must not be NULL.
+ * @return The image, owned by the encoder. NULL if the encoder does not
+ *         write to memory.
+ * @since 1.0.0
+ */
+PUDAPI const unsigned char *
+war2_image_encoder_buffer_get(const War2_Image_Encoder *enc,
+                              size_t                   *size);
+
+/**
+ * Release an encoder. An unfinished image is discarded.
+ *
+ * @param enc The encoder
+ * @since 1.0.0
+ */
+PUDAPI void
+war2_image_encoder_free(War2_Image_Encoder *enc);
+
 /**
  * Convert a color from one player to another
  *
@@ -474,6 +1776,274 @@ war2_sprites_color_convert(Pud_Player     from,
                            unsigned char *out_g,
                            unsigned char *out_b);
 
+/**
+ * Decode sprites from a buffer that has the layout of a sprites entry
+ *
+ * The buffer is fully bounds-checked, so it may come from an untrusted
+ * source (e.g. the output of war2_sprites_encoder_encode()).
+ *
+ * @param dec A valid decoder
+ * @param buf The sprites data
+ * @param size The size of @p buf, in bytes
+ * @param palette The palette to be used to decode the sprites
+ * @param player_color The color of the sprites
+ * @param func User callback to be called for each decoded sprite
+ * @param data User data passed to @c func
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_decoder_sprites_buffer_decode(War2_Decoder             *dec,
+                                   const unsigned char      *buf,
+                                   size_t                    size,
+                                   const Pud_Color          *palette,
+                                   Pud_Player                player_color,
+                                   War2_Sprites_Decode_Func  func,
+                                   void                     *data);
+
+/**
+ * Create a sprites encoder for a given palette
+ *
+ * @param palette A palette of WAR2_PALETTE_SIZE colors (e.g. obtained
+ *                with war2_palette_get()). It is copied.
+ * @return A new encoder. NULL on failure.
+ * @see war2_sprites_encoder_free()
+ * @since 1.0.0
+ */
+PUDAPI War2_Sprites_Encoder *war2_sprites_encoder_new(const Pud_Color *palette);
+
+/**
+ * Release a sprites encoder
+ *
+ * @param enc The encoder to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_sprites_encoder_free(War2_Sprites_Encoder *enc);
+
+/**
+ * Get the palette index that an encoder uses for a color
+ *
+ * Pixels with an alpha lower than 128 are transparent (index 0). Colors
+ * of @p player_color are converted back to the red player colors, as
+ * sprites are stored in red. Other colors are mapped to the nearest
+ * color of the palette.
+ *
+ * @param enc A valid encoder
+ * @param player_color The color of the player the image was drawn for
+ * @param color The color to be converted
+ * @return The index of @p color in the palette of @p enc
+ * @since 1.0.0
+ */
+PUDAPI uint8_t
+war2_sprites_encoder_color_index(War2_Sprites_Encoder *enc,
+                                 Pud_Player            player_color,
+                                 Pud_Color             color);
+
+/**
+ * Encode RGBA frames as a sprites entry
+ *
+ * The result has the layout of the entries decoded by
+ * war2_sprites_decode().
+ *
+ * @param enc A valid encoder
+ * @param player_color The color of the player the frames were drawn for
+ * @param frames The frames to be encoded
+ * @param count The number of elements in @p frames
+ * @param size_ret Used to return the size of the encoded data
+ * @return The encoded data, to be released with free(). NULL on failure.
+ * @since 1.0.0
+ */
+PUDAPI unsigned char *
+war2_sprites_encoder_encode(War2_Sprites_Encoder    *enc,
+                            Pud_Player               player_color,
+                            const War2_Sprite_Frame *frames,
+                            unsigned int             count,
+                            size_t                  *size_ret);
+
+/**
+ * Apply the colors of a player to a palette
+ *
+ * Decoding the palette indexes of a sprite (see
+ * War2_Sprites_Descriptor::indexes) with the resulting palette gives the
+ * same colors as the decoded sprite.
+ *
+ * @param palette A palette of WAR2_PALETTE_SIZE colors
+ * @param player_color The color of the player
+ * @param out Where to write the WAR2_PALETTE_SIZE colors of the resulting
+ *            palette. May be @p palette.
+ * @since 1.0.0
+ */
+PUDAPI void
+war2_sprites_palette_colorize(const Pud_Color *palette,
+                              Pud_Player       player_color,
+                              Pud_Color       *out);
+
+/**
+ * Upscale an image made of palette indexes
+ *
+ * Scaling indexes is cheaper than scaling colors. The palette can then
+ * be applied on the scaled image. Rows are processed by several threads
+ * when threads are available.
+ *
+ * @param src The image to be scaled (@p w * @p h indexes)
+ * @param w The width of @p src
+ * @param h The height of @p src
+ * @param dst Where to write the scaled image. It must hold
+ *            (@p w * @p factor) * (@p h * @p factor) indexes.
+ * @param factor The scaling factor
+ * @param scaler The scaling algorithm
+ * @return PUD_TRUE on success, PUD_FALSE on failure (e.g. if @p factor
+ *         is not supported by @p scaler)
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_scale_indexed(const unsigned char *src,
+                   unsigned int         w,
+                   unsigned int         h,
+                   unsigned char       *dst,
+                   unsigned int         factor,
+                   War2_Scaler          scaler);
+
+/**
+ * Upscale an RGBA image (e.g. a decoded sprite or tile)
+ *
+ * @param src The image to be scaled (@p w * @p h pixels)
+ * @param w The width of @p src
+ * @param h The height of @p src
+ * @param dst Where to write the scaled image. It must hold
+ *            (@p w * @p factor) * (@p h * @p factor) pixels.
+ * @param factor The scaling factor
+ * @param scaler The scaling algorithm
+ * @return PUD_TRUE on success, PUD_FALSE on failure
+ * @see war2_scale_indexed()
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_scale_rgba(const Pud_Color *src,
+                unsigned int     w,
+                unsigned int     h,
+                Pud_Color       *dst,
+                unsigned int     factor,
+                War2_Scaler      scaler);
+
+/**
+ * Duplicate a sprite mask
+ *
+ * Masks given by the decoding callbacks are only valid during the
+ * callback. This function allows to keep a mask for later use (e.g.
+ * hit-testing).
+ *
+ * @param mask The mask to be copied
+ * @return A copy of @p mask, to be released with war2_sprite_mask_free().
+ *         NULL on failure.
+ * @see war2_sprite_mask_free()
+ * @since 1.0.0
+ */
+PUDAPI War2_Sprite_Mask *war2_sprite_mask_dup(const War2_Sprite_Mask *mask);
+
+/**
+ * Release a mask obtained with war2_sprite_mask_dup()
+ *
+ * @param mask The mask to be freed. May be NULL.
+ * @since 1.0.0
+ */
+PUDAPI void war2_sprite_mask_free(War2_Sprite_Mask *mask);
+
+/**
+ * Check whether two masks overlap
+ *
+ * Masks are placed at (@p ax, @p ay) and (@p bx, @p by) respectively,
+ * in a common coordinates system. Only opaque pixels are considered.
+ *
+ * @param a First mask
+ * @param ax X position of @p a
+ * @param ay Y position of @p a
+ * @param b Second mask
+ * @param bx X position of @p b
+ * @param by Y position of @p b
+ * @return PUD_TRUE if at least one opaque pixel of @p a covers an opaque
+ *         pixel of @p b, PUD_FALSE otherwise
+ * @since 1.0.0
+ */
+PUDAPI Pud_Bool
+war2_sprite_mask_overlap(const War2_Sprite_Mask *a,
+                         int                     ax,
+                         int                     ay,
+                         const War2_Sprite_Mask *b,
+                         int                     bx,
+                         int                     by);
+
+/**
+ * Check whether a pixel of a mask is opaque
+ *
+ * @param mask A sprite mask
+ * @param x X coordinate, relative to the mask origin
+ * @param y Y coordinate, relative to the mask origin
+ * @return PUD_TRUE if (@p x, @p y) is within @p mask and is opaque
+ * @since 1.0.0
+ */
+static inline Pud_Bool
+war2_sprite_mask_hit(const War2_Sprite_Mask *mask, int x, int y)
+{
+   const War2_Sprite_Span *span;
+
+   if ((x < 0) || (y < 0) ||
+       ((unsigned int)x >= mask->w) || ((unsigned int)y >= mask->h))
+     return PUD_FALSE;
+
+   span = &(mask->spans[y]);
+   if (((unsigned int)x < span->start) || ((unsigned int)x >= span->end))
+     return PUD_FALSE;
+
+   return (mask->bits[(y * mask->words_per_row) + (x / 64)] >> (x % 64)) & 1;
+}
+
+/**
+ * Get a cursor in an atlas created by war2_cursors_atlas_new()
+ *
+ * @param atlas A valid atlas
+ * @param cursor The cursor to be found
+ * @return The image of the cursor. NULL if @p cursor is not a cursor.
+ * @since 1.0.0
+ */
+static inline const War2_Atlas_Image *
+war2_images_atlas_cursor_get(const War2_Images_Atlas *atlas,
+                             War2_Cursor              cursor)
+{
+   if ((cursor < __WAR2_CURSOR_FIRST) || (cursor >= __WAR2_CURSOR_LAST))
+     return NULL;
+   return &(atlas->images[cursor - __WAR2_CURSOR_FIRST]);
+}
+
+/**
+ * Get the position of a tile in an atlas
+ *
+ * @param atlas A tileset atlas
+ * @param tile A tile ID, as stored in MTXM
+ * @param x Where to store the X coordinate of the tile, in pixels
+ * @param y Where to store the Y coordinate of the tile, in pixels
+ * @return PUD_TRUE if @p tile is in @p atlas, PUD_FALSE otherwise
+ * @since 1.0.0
+ */
+static inline Pud_Bool
+war2_tileset_atlas_rect_get(const War2_Tileset_Atlas *atlas,
+                            uint16_t                  tile,
+                            unsigned int             *x,
+                            unsigned int             *y)
+{
+   uint16_t slot;
+
+   if ((tile < WAR2_TILESET_TILE_FIRST) || (tile > WAR2_TILESET_TILE_LAST))
+     return PUD_FALSE;
+   slot = atlas->slots[tile - WAR2_TILESET_TILE_FIRST];
+   if (slot == WAR2_TILESET_ATLAS_NONE)
+     return PUD_FALSE;
+
+   *x = (slot % WAR2_TILESET_ATLAS_COLUMNS) * 32;
+   *y = (slot / WAR2_TILESET_ATLAS_COLUMNS) * 32;
+   return PUD_TRUE;
+}
+
 /**
  * @}
  */ /* End of War2_Core group */
@@ -30,6 +30,9 @@
 #include <errno.h>
 #include <stdint.h>
 #include <time.h>
+#ifdef HAVE_PTHREAD
+# include <pthread.h>
+#endif
 
 #include "pud.h"
 #include "pud_private.h"
@@ -52,13 +55,211 @@ struct _War2_Data
    Pud_Color wasteland[WAR2_PALETTE_SIZE];
    Pud_Color swamp[WAR2_PALETTE_SIZE];
 
+   /* Minitiles of each era, decoded on first use */
+   struct _War2_Minitiles *minitiles[4];
+
+   /* Tiles that render to the same image, decoded on first use */
+   uint16_t     *equivalences[4];
+   unsigned int  equivalences_unique[4];
+
+   /* Icons of each era, decoded on first use. Eras whose icons cannot
+    * be decoded are not tried again */
+   struct _War2_Icons *icons[4];
+   Pud_Bool            icons_failed[4];
+
    int verbose;
+
+#ifdef HAVE_PTHREAD
+   /* Protects the caches above, which are built on first use by any of
+    * the threads that share this handle */
+   pthread_mutex_t lock;
+#endif
 };
 
-#define WAR2_TRAP_SETUP(W2) COMMON_TRAP_SETUP(W2->mem_map)
-#define WAR2_READ8(W2) common_read8(w2->mem_map)
-#define WAR2_READ16(W2) common_read16(w2->mem_map)
-#define WAR2_READ32(W2) common_read32(w2->mem_map)
+#ifdef HAVE_PTHREAD
+# define WAR2_LOCK(w2) pthread_mutex_lock(&((w2)->lock))
+# define WAR2_UNLOCK(w2) pthread_mutex_unlock(&((w2)->lock))
+#else
+# define WAR2_LOCK(w2) do { (void) (w2); } while (0)
+# define WAR2_UNLOCK(w2) do { (void) (w2); } while (0)
+#endif
+
+/*
+ * Scratch buffers of a decoder. Each slot is used by a single step of the
+ * decoding, so buffers that must be alive at the same time never share
+ * a slot.
+ */
+typedef enum
+{
+   WAR2_DECODER_SLOT_ENTRY = 0, /* Main extracted entry */
+   WAR2_DECODER_SLOT_ENTRY_AUX1, /* Extra entries (e.g. tilesets) */
+   WAR2_DECODER_SLOT_ENTRY_AUX2,
+   WAR2_DECODER_SLOT_ENTRY_USER, /* war2_decoder_entry_extract() */
+   WAR2_DECODER_SLOT_INDEXES, /* Palette indexes of a sprite */
+   WAR2_DECODER_SLOT_RGBA, /* RGBA output (sprites, UI, cursors) */
+   WAR2_DECODER_SLOT_MASK_BITS,
+   WAR2_DECODER_SLOT_MASK_SPANS,
+   WAR2_DECODER_SLOT_PIXELS, /* Output in the pixel format of the decoder */
+
+   __WAR2_DECODER_SLOT_LAST
+} War2_Decoder_Slot;
+
+struct _War2_Decoder
+{
+   struct {
+      void   *mem;
+      size_t  size;
+   } slots[__WAR2_DECODER_SLOT_LAST];
+
+   Pud_Pixel_Format  format;
+   const void       *pixels; /* Last UI element or cursor */
+
+   /* Palette converted to the pixel format, to convert palette indexes
+    * in a single lookup (see war2_decoder_palette_set()) */
+   unsigned char     lut[WAR2_PALETTE_SIZE * 4];
+};
+
+PUDAPI_INTERNAL void *
+war2_decoder_buffer_get(War2_Decoder      *dec,
+                        War2_Decoder_Slot  slot,
+                        size_t             size);
+
+/* Palette used by war2_decoder_pixels_lookup() */
+PUDAPI_INTERNAL void
+war2_decoder_palette_set(War2_Decoder    *dec,
+                         const Pud_Color *palette);
+
+/* Convert palette indexes to the pixel format of the decoder. The result
+ * is in the WAR2_DECODER_SLOT_PIXELS slot */
+PUDAPI_INTERNAL const void *
+war2_decoder_pixels_lookup(War2_Decoder        *dec,
+                           const unsigned char *indexes,
+                           size_t               count);
+
+/* UI entries start with the width and the height of the image (2 bytes
+ * each), followed by its palette indexes. Returns the indexes, or NULL
+ * if the entry is too small */
+PUDAPI_INTERNAL const unsigned char *
+war2_ui_image_get(const unsigned char *ptr,
+                  size_t               size,
+                  unsigned int         entry,
+                  unsigned int        *w,
+                  unsigned int        *h);
+
+PUDAPI_INTERNAL const unsigned char *
+war2_decoder_entry_get(War2_Data         *w2,
+                       War2_Decoder      *dec,
+                       War2_Decoder_Slot  slot,
+                       unsigned int       entry,
+                       size_t            *size_ret);
+
+/*
+ * Split [0 ; count[ into contiguous ranges processed by several threads.
+ * Ranges are never smaller than grain. Returns when all ranges have been
+ * processed. Runs serially when threads are not available.
+ */
+typedef void (*War2_Parallel_Func)(void *data, unsigned int start, unsigned int end);
+
+PUDAPI_INTERNAL void
+war2_parallel_for(unsigned int        count,
+                  unsigned int        grain,
+                  War2_Parallel_Func  func,
+                  void               *data);
+
+/* Flags that the functions of war2_parallel_for() may set concurrently,
+ * e.g. to report a failure */
+PUDAPI_INTERNAL void
+war2_parallel_flag_set(Pud_Bool *flag);
+
+PUDAPI_INTERNAL Pud_Bool
+war2_parallel_flag_get(const Pud_Bool *flag);
+
+/*
+ * PNG writer that receives the rows of the image progressively, so the
+ * whole image never has to be in memory. opts may be NULL to use the
+ * defaults of libpng.
+ */
+typedef struct _War2_Png_Stream War2_Png_Stream;
+
+PUDAPI_INTERNAL War2_Png_Stream *
+war2_png_stream_new(const char             *file,
+                    unsigned int            w,
+                    unsigned int            h,
+                    const War2_Png_Options *opts);
+
+/* Stream that gives the PNG image to a function */
+PUDAPI_INTERNAL War2_Png_Stream *
+war2_png_stream_func_new(War2_Image_Write_Func   func,
+                         void                   *data,
+                         unsigned int            w,
+                         unsigned int            h,
+                         const War2_Png_Options *opts);
+
+/* Stream of an image made of palette indexes */
+PUDAPI_INTERNAL War2_Png_Stream *
+war2_png_stream_indexed_new(const char             *file,
+                            unsigned int            w,
+                            unsigned int            h,
+                            const Pud_Color        *palette,
+                            unsigned int            colors,
+                            const War2_Png_Options *opts);
+
+PUDAPI_INTERNAL Pud_Bool
+war2_png_stream_rows_write(War2_Png_Stream *s,
+                           const Pud_Color *rows,
+                           unsigned int     count);
+
+PUDAPI_INTERNAL Pud_Bool
+war2_png_stream_indexed_rows_write(War2_Png_Stream     *s,
+                                   const unsigned char *rows,
+                                   unsigned int         count);
+
+/* Returns PUD_TRUE only if all the rows have been written */
+PUDAPI_INTERNAL Pud_Bool
+war2_png_stream_close(War2_Png_Stream *s);
+
+/* JPEG writer that receives the rows of the image progressively */
+typedef struct _War2_Jpeg_Stream War2_Jpeg_Stream;
+
+PUDAPI_INTERNAL War2_Jpeg_Stream *
+war2_jpeg_stream_new(War2_Image_Write_Func  func,
+                     void                  *data,
+                     unsigned int           w,
+                     unsigned int           h,
+                     int                    quality);
+
+PUDAPI_INTERNAL Pud_Bool
+war2_jpeg_stream_rows_write(War2_Jpeg_Stream *s,
+                            const Pud_Color  *rows,
+                            unsigned int      count);
+
+/* Returns PUD_TRUE only if all the rows have been written */
+PUDAPI_INTERNAL Pud_Bool
+war2_jpeg_stream_close(War2_Jpeg_Stream *s);
+
+/* QOI writer that receives the rows of the image progressively */
+typedef struct _War2_Qoi_Stream War2_Qoi_Stream;
+
+PUDAPI_INTERNAL War2_Qoi_Stream *
+war2_qoi_stream_new(War2_Image_Write_Func  func,
+                    void                  *data,
+                    unsigned int           w,
+                    unsigned int           h);
+
+PUDAPI_INTERNAL Pud_Bool
+war2_qoi_stream_rows_write(War2_Qoi_Stream *s,
+                           const Pud_Color *rows,
+                           unsigned int     count);
+
+/* Returns PUD_TRUE only if all the rows have been written */
+PUDAPI_INTERNAL Pud_Bool
+war2_qoi_stream_close(War2_Qoi_Stream *s);
+
+/* War2_Image_Write_Func that writes to a FILE */
+PUDAPI_INTERNAL Pud_Bool
+war2_image_file_write(void                *data,
+                      const unsigned char *bytes,
+                      size_t               size);
 
 #define WAR2_VERBOSE(w2, lvl, msg, ...) \
    do { \
@@ -67,6 +268,104 @@ struct _War2_Data
       } \
    } while (0)
 
+/*
+ * Minitiles (8x8 pixels) of an era, decoded once with their flipped
+ * variants. Variant v of minitile m starts at (m * 4 + v) * 64 in both
+ * the palette indexes and the RGBA pixels. Megatiles (32x32) are then
+ * assembled with row copies.
+ */
+#define WAR2_MINITILE_VARIANTS 4
+#define WAR2_MINITILE_PIXELS (8 * 8)
+
+typedef struct _War2_Minitiles
+{
+   unsigned int   count;
+   unsigned char *indexes;
+   Pud_Color     *rgba;
+} War2_Minitiles;
+
+PUDAPI_INTERNAL War2_Minitiles *
+war2_minitiles_new(const unsigned char *data,
+                   size_t               size,
+                   const Pud_Color     *palette);
+
+PUDAPI_INTERNAL void
+war2_minitiles_free(War2_Minitiles *mt);
+
+/* Assemble the megatile described by 16 minitile words into img, whose
+ * rows are stride pixels apart */
+PUDAPI_INTERNAL void
+war2_minitiles_megatile_rgba(const War2_Minitiles *mt,
+                             const unsigned char  *words,
+                             Pud_Color            *img,
+                             unsigned int          stride);
+
+PUDAPI_INTERNAL void
+war2_minitiles_megatile_indexes(const War2_Minitiles *mt,
+                                const unsigned char  *words,
+                                unsigned char        *img,
+                                unsigned int          stride);
+
+PUDAPI_INTERNAL const War2_Minitiles *
+war2_tileset_minitiles_get(War2_Data    *w2,
+                           War2_Decoder *dec,
+                           Pud_Era       era);
+
+/*
+ * Entries of a tileset: the megatiles (16 minitile words each), their
+ * minitiles and the map from tile IDs to megatiles. Entries are owned by
+ * the decoder used to get them.
+ */
+typedef struct
+{
+   const War2_Minitiles *minitiles;
+   const unsigned char  *megatiles;
+   size_t                megatiles_size;
+   const unsigned char  *map;
+   size_t                map_size;
+} War2_Tileset_Data;
+
+PUDAPI_INTERNAL Pud_Bool
+war2_tileset_data_get(War2_Data         *w2,
+                      War2_Decoder      *dec,
+                      Pud_Era            era,
+                      War2_Tileset_Data *tsd);
+
+/* Whether a tile ID may be stored in a tileset */
+PUDAPI_INTERNAL Pud_Bool
+war2_tileset_tile_is_valid(uint16_t tile);
+
+/* Location of the megatile of a tile ID in the map entry */
+#define WAR2_TILESET_MAP_OFFSET(Tile) ((((Tile) >> 4) * 42) + (((Tile) & 0xf) * 2))
+
+/* Minitile words of the megatile of a tile ID. NULL if the tile is not
+ * populated */
+PUDAPI_INTERNAL const unsigned char *
+war2_tileset_megatile_get(const War2_Tileset_Data *tsd,
+                          uint16_t                 tile);
+
+typedef struct _War2_Icons War2_Icons;
+
+PUDAPI_INTERNAL void
+war2_icons_free(War2_Icons *icons);
+
+/* Shade (0 to 3, from dark to light) of color in the colors of a player,
+ * or -1 if color is not one of them */
+PUDAPI_INTERNAL int
+war2_sprites_player_shade_get(Pud_Player       player_color,
+                              const Pud_Color *color);
+
+/* Count of 64-bits words required to store a mask row of W pixels */
+#define WAR2_SPRITE_MASK_WORDS(W) (((W) + 63) / 64)
+
+PUDAPI_INTERNAL void
+war2_sprite_mask_build(War2_Sprite_Mask    *mask,
+                       uint64_t            *bits,
+                       War2_Sprite_Span    *spans,
+                       const unsigned char *img,
+                       unsigned int         w,
+                       unsigned int         h,
+                       const Pud_Color     *palette);
 
 
 #endif /* ! _WAR2_PRIVATE_H_ */
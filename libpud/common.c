@@ -76,7 +76,6 @@ common_file_mmap(const char *file)
         goto err_close;
      }
    map->size = s.st_size;
-   map->ptr = map->map;
 
    close(fd);
    return map;
@@ -140,7 +139,6 @@ free_map:
      }
    map->map = mem;
    map->size = total;
-   map->ptr = map->map;
 
    fclose(f);
    return map;
@@ -163,12 +161,6 @@ common_file_munmap(Pud_Mmap *map)
    free(map);
 }
 
-PUDAPI void
-common_mmap_ptr_reset(Pud_Mmap *map)
-{
-   map->ptr = map->map;
-}
-
 PUDAPI Pud_Bool
 common_file_exists(const char *path)
 {
@@ -197,41 +189,3 @@ common_file_exists(const char *path)
 
 #endif
 }
-
-PUDAPI void
-common_trap_hook(void)
-{
-   /* Do nothing. The debugger will hook there if need be. */
-}
-
-PUDAPI Pud_Bool
-common_mem_map_ok(const Pud_Mmap *map, size_t extra)
-{
-   return (map->ptr + extra <= (unsigned char *)map->map + map->size)
-      ? PUD_TRUE : PUD_FALSE;
-}
-
-PUDAPI void
-common_read_buffer(Pud_Mmap *map, void *buf, size_t bytes)
-{
-  if (! common_mem_map_ok(map, bytes))
-    COMMON_TRAP_RAISE(map, "Trying to read outside of the memory map");
-  memcpy(buf, map->ptr, bytes);
-  map->ptr += bytes;
-}
-
-#define READ_FUNCTION_TEMPLATE(Name, Type)                              \
-  PUDAPI Type Name(Pud_Mmap *map)                                       \
-  {                                                                     \
-    Type storage;                                                       \
-    if (! common_mem_map_ok(map, sizeof(Type))) {                       \
-      COMMON_TRAP_RAISE(map, "Trying to read outside of the memory map");  \
-    }                                                                   \
-    memcpy(&storage, map->ptr, sizeof(Type));                           \
-    map->ptr += sizeof(Type);                                           \
-    return storage;                                                     \
-  }
-
-READ_FUNCTION_TEMPLATE(common_read8, uint8_t)
-READ_FUNCTION_TEMPLATE(common_read16, uint16_t)
-READ_FUNCTION_TEMPLATE(common_read32, uint32_t)
@@ -29,35 +29,33 @@ pud_minimap_bitmap_generate(const Pud        *pud,
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, NULL);
 
-   unsigned char *map;
+   Pud_Color *map;
+   unsigned char *bitmap;
    Pud_Unit_Info *u;
    Pud_Color c;
+   const uint32_t *colors;
+   uint16_t tile;
    unsigned int i, j, k;
-   int idx;
-   unsigned int size;
+   unsigned int size, bpp;
    uint16_t w, h;
    const Pud_Era era = pud->era;
-   const unsigned int delta[2][4] = {
-      [PUD_PIXEL_FORMAT_RGBA] = {
-         0, 1, 2, 3
-      },
-      [PUD_PIXEL_FORMAT_ARGB] = {
-         2, 1, 0, 3
-      }
-   };
 
-   size = pud->tiles * 4;
-   map = malloc(size * sizeof(unsigned char));
+   bpp = pud_pixel_format_size(pfmt);
+   if (bpp == 0) DIE_RETURN(NULL, "Invalid pixel format %i", pfmt);
+
+   map = malloc(pud->tiles * sizeof(Pud_Color));
    if (!map) DIE_RETURN(NULL, "Failed to allocate memory");
 
-   for (i = 0, idx = 0; i < pud->tiles; i++, idx += 4)
+   /* A single table load per tile. Invalid tiles are reported by
+    * pud_minimap_tile_to_color() */
+   colors = minimap_colors_get(era);
+   for (i = 0; i < pud->tiles; i++)
      {
-        c = pud_minimap_tile_to_color(era, pud->tiles_map[i]);
-
-        map[idx + delta[pfmt][0]] = c.r;
-        map[idx + delta[pfmt][1]] = c.g;
-        map[idx + delta[pfmt][2]] = c.b;
-        map[idx + delta[pfmt][3]] = c.a;
+        tile = pud->tiles_map[i];
+        if ((colors) && (tile < MINIMAP_TILES))
+          map[i] = MINIMAP_COLOR_UNPACK(colors[tile]);
+        else
+          map[i] = pud_minimap_tile_to_color(era, tile);
      }
 
    for (i = 0; i < pud->units_count; i++)
@@ -69,20 +67,24 @@ pud_minimap_bitmap_generate(const Pud        *pud,
         h = pud->units_descr[u->type].size_h;
 
         for (j = 0; j < w; j++)
-          {
-             for (k = 0; k < h; k++)
-               {
-                  idx = (((u->y + k)* pud->map_w) + (u->x + j)) * 4;
+          for (k = 0; k < h; k++)
+            map[((u->y + k) * pud->map_w) + (u->x + j)] = c;
+     }
 
-                  map[idx + delta[pfmt][0]] = c.r;
-                  map[idx + delta[pfmt][1]] = c.g;
-                  map[idx + delta[pfmt][2]] = c.b;
-                  map[idx + delta[pfmt][3]] = c.a;
-               }
-          }
+   /* The map is built in RGBA, then converted in a single pass */
+   size = pud->tiles * bpp;
+   if (pfmt == PUD_PIXEL_FORMAT_RGBA)
+     bitmap = (unsigned char *)map;
+   else
+     {
+        bitmap = malloc(size);
+        if (bitmap)
+          pud_pixels_convert(map, bitmap, pud->tiles, pfmt);
+        free(map);
+        if (!bitmap) DIE_RETURN(NULL, "Failed to allocate memory");
      }
 
    if (size_ret) *size_ret = size;
 
-   return map;
+   return bitmap;
 }
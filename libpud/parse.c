@@ -20,6 +20,8 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <stddef.h>
+
 #include "pud_private.h"
 
 /*
@@ -28,11 +30,17 @@
 
 #define HAS_SECTION(sec) pud->private_data->sections |= (1 << sec)
 
+/* Reads of a section are checked once, after the last one */
+#define SECTION_CHECK(sec) \
+   if (common_cursor_error(&cur)) \
+     DIE_RETURN(PUD_FALSE, "Section %s is truncated", pud_section_to_string(sec))
+
 PUDAPI Pud_Bool
 pud_parse_type(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
 
+   Common_Cursor cur;
    char buf[16];
    uint32_t l;
    uint32_t chk;
@@ -40,20 +48,19 @@ pud_parse_type(Pud *pud)
       'W', 'A', 'R', '2', ' ', 'M', 'A', 'P', '\0', '\0'
    };
 
-   chk = pud_go_to_section(pud, PUD_SECTION_TYPE);
+   chk = pud_go_to_section(pud, PUD_SECTION_TYPE, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section TYPE");
    PUD_VERBOSE(pud, 2, "At section TYPE (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_TYPE);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   /* Read 10bytes + 2 unused */
-   PUD_READ_BUFFER(pud, buf, 12);
+   /* Read 10bytes + 2 unused, then the ID TAG */
+   common_cursor_read(&cur, buf, 12);
+   l = common_cursor_read32(&cur);
+   SECTION_CHECK(PUD_SECTION_TYPE);
+
    if (memcmp(buf, type, 10))
      DIE_RETURN(PUD_FALSE, "TYPE section has a wrong header (not a WAR2 MAP)");
 
-   /* Read ID TAG */
-   l = PUD_READ32(pud);
-
    pud->tag = l;
 
    return PUD_TRUE;
@@ -64,16 +71,17 @@ pud_parse_ver(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint16_t w;
    uint32_t chk;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_VER);
+   chk = pud_go_to_section(pud, PUD_SECTION_VER, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section VER");
    PUD_VERBOSE(pud, 2, "At section VER (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_VER);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   w = PUD_READ16(pud);
+   w = common_cursor_read16(&cur);
+   SECTION_CHECK(PUD_SECTION_VER);
 
    pud->version = w;
    return PUD_TRUE;
@@ -84,15 +92,16 @@ pud_parse_desc(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_DESC);
+   chk = pud_go_to_section(pud, PUD_SECTION_DESC, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section DESC");
    PUD_VERBOSE(pud, 2, "At section DESC (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_DESC);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   PUD_READ_BUFFER(pud, pud->description, 32);
+   common_cursor_read(&cur, pud->description, 32);
+   SECTION_CHECK(PUD_SECTION_DESC);
 
    return PUD_TRUE;
 }
@@ -102,17 +111,18 @@ pud_parse_ownr(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t len;
 
-   len = pud_go_to_section(pud, PUD_SECTION_OWNR);
+   len = pud_go_to_section(pud, PUD_SECTION_OWNR, &cur);
    if (!len) DIE_RETURN(PUD_FALSE, "Failed to reach section OWNR");
    PUD_VERBOSE(pud, 2, "At section OWNR (size = %u)", len);
    HAS_SECTION(PUD_SECTION_OWNR);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   PUD_READ_BUFFER(pud, pud->owner.players, 8);
-   PUD_READ_BUFFER(pud, pud->owner.unusable, 7);
-   PUD_READ_BUFFER(pud, &(pud->owner.neutral), 1);
+   common_cursor_read(&cur, pud->owner.players, 8);
+   common_cursor_read(&cur, pud->owner.unusable, 7);
+   common_cursor_read(&cur, &(pud->owner.neutral), 1);
+   SECTION_CHECK(PUD_SECTION_OWNR);
 
    return PUD_TRUE;
 }
@@ -122,15 +132,16 @@ pud_parse_side(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
-   const uint32_t len = pud_go_to_section(pud, PUD_SECTION_SIDE);
+   Common_Cursor cur;
+   const uint32_t len = pud_go_to_section(pud, PUD_SECTION_SIDE, &cur);
    if (!len) DIE_RETURN(PUD_FALSE, "Failed to reach section SIDE");
    PUD_VERBOSE(pud, 2, "At section SIDE (size = %u)", len);
    HAS_SECTION(PUD_SECTION_SIDE);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   PUD_READ_BUFFER(pud, pud->side.players, 8);
-   PUD_READ_BUFFER(pud, pud->side.unusable, 7);
-   PUD_READ_BUFFER(pud, &(pud->side.neutral), 1);
+   common_cursor_read(&cur, pud->side.players, 8);
+   common_cursor_read(&cur, pud->side.unusable, 7);
+   common_cursor_read(&cur, &(pud->side.neutral), 1);
+   SECTION_CHECK(PUD_SECTION_SIDE);
 
    return PUD_TRUE;
 }
@@ -140,15 +151,16 @@ pud_parse_era(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint16_t w;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_ERAX);
+   chk = pud_go_to_section(pud, PUD_SECTION_ERAX, &cur);
    if (!chk) // Optional section, use ERA by default
      {
         pud->private_data->has_erax = PUD_FALSE;
         PUD_VERBOSE(pud, 2, "Failed to find ERAX. Trying with ERA...");
-        chk = pud_go_to_section(pud, PUD_SECTION_ERA);
+        chk = pud_go_to_section(pud, PUD_SECTION_ERA, &cur);
         if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section ERA");
         PUD_VERBOSE(pud, 2, "At section ERA (size = %u)", chk);
         HAS_SECTION(PUD_SECTION_ERA);
@@ -160,8 +172,8 @@ pud_parse_era(Pud *pud)
         HAS_SECTION(PUD_SECTION_ERAX);
      }
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   w = PUD_READ16(pud);
+   w = common_cursor_read16(&cur);
+   SECTION_CHECK(pud->private_data->has_erax ? PUD_SECTION_ERAX : PUD_SECTION_ERA);
 
    if ((w == 0x00) || ((w >= 0x04) && (w <= 0xff)))
       pud->era = PUD_ERA_FOREST;
@@ -182,20 +194,20 @@ pud_parse_dim(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint16_t x, y;
    Pud_Dimensions dim;
    Pud_Open_Mode mode;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_DIM);
+   chk = pud_go_to_section(pud, PUD_SECTION_DIM, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section DIM");
    PUD_VERBOSE(pud, 2, "At section DIM (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_DIM);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-
-   x = PUD_READ16(pud);
-   y = PUD_READ16(pud);
+   x = common_cursor_read16(&cur);
+   y = common_cursor_read16(&cur);
+   SECTION_CHECK(PUD_SECTION_DIM);
 
    if ((x == 32) && (y == 32))
      dim = PUD_DIMENSIONS_32_32;
@@ -223,67 +235,67 @@ pud_parse_udta(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint16_t wb[512];
    uint32_t lb[128];
    uint8_t bb[128];
    int i;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_UDTA);
+   chk = pud_go_to_section(pud, PUD_SECTION_UDTA, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section UDTA");
    PUD_VERBOSE(pud, 2, "At section UDTA (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_UDTA);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
 
    /* Use default data */
-   pud->private_data->default_udta = !!PUD_READ16(pud);
+   pud->private_data->default_udta = !!common_cursor_read16(&cur);
 
    /* Overlap frames */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 110);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].overlap_frames = wb[i];
 
    /* Obsolete data */
-   PUD_READ_BUFFER(pud, pud->obsolete_udta, sizeof(uint16_t) * 508);
+   common_cursor_read(&cur, pud->obsolete_udta, sizeof(uint16_t) * 508);
 
    /* Sight (why the hell is it on 32 bits!?) */
-   PUD_READ_BUFFER(pud, lb, sizeof(uint32_t) * 110);
+   common_cursor_read(&cur, lb, sizeof(uint32_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].sight = lb[i];
 
    /* Hit points */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 110);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].hp = wb[i];
 
    /* Magic */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].has_magic = !!bb[i];
 
    /* Build time */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].build_time = bb[i];
 
    /* Gold cost */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].gold_cost = bb[i];
 
    /* Lumber cost */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].lumber_cost = bb[i];
 
    /* Oil cost */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].oil_cost = bb[i];
 
    /* Unit size */
-   PUD_READ_BUFFER(pud, lb, sizeof(uint32_t) * 110);
+   common_cursor_read(&cur, lb, sizeof(uint32_t) * 110);
    for (i = 0; i < 110; i++)
      {
         pud->units_descr[i].size_w = (lb[i] >> 16) & 0x0000ffff;
@@ -291,7 +303,7 @@ pud_parse_udta(Pud *pud)
      }
 
    /* Unit box */
-   PUD_READ_BUFFER(pud, lb, sizeof(uint32_t) * 110);
+   common_cursor_read(&cur, lb, sizeof(uint32_t) * 110);
    for (i = 0; i < 110; i++)
      {
         pud->units_descr[i].box_w = (lb[i] >> 16) & 0x0000ffff;
@@ -299,103 +311,104 @@ pud_parse_udta(Pud *pud)
      }
 
    /* Attack range */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].range = bb[i];
 
    /* React range (computer) */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].computer_react_range = bb[i];
 
    /* React range (human) */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].human_react_range = bb[i];
 
    /* Armor */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].armor = bb[i];
 
    /* Selectable via rectangle */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].rect_sel = !!bb[i];
 
    /* Priority */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].priority = bb[i];
 
    /* Basic damage */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].basic_damage = bb[i];
 
    /* Piercing damage */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].piercing_damage = bb[i];
 
    /* Weapons upgradable */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].weapons_upgradable = !!bb[i];
 
    /* Armor upgradable */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].armor_upgradable = !!bb[i];
 
    /* Missile weapon */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].missile_weapon = bb[i];
 
    /* Unit type */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].type = bb[i];
 
    /* Decay rate */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].decay_rate = bb[i];
 
    /* Annoy computer factor */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].annoy = bb[i];
 
    /* 2nd mouse button action */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 58);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 58);
    for (i = 0; i < 58; i++)
      pud->units_descr[i].mouse_right_btn = bb[i];
    for (; i < 110; i++)
      pud->units_descr[i].mouse_right_btn = 0xff;
 
    /* Point value for killing unit */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 110);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].point_value = wb[i];
 
    /* Can target */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 110);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].can_target = bb[i];
 
    /* Flags */
-   PUD_READ_BUFFER(pud, lb, sizeof(uint32_t) * 110);
+   common_cursor_read(&cur, lb, sizeof(uint32_t) * 110);
    for (i = 0; i < 110; i++)
      pud->units_descr[i].flags = lb[i];
 
    /* Obsolete */
    if (chk == 5950)
      {
-        PUD_READ_BUFFER(pud, lb, sizeof(uint16_t) * 127);
+        common_cursor_read(&cur, lb, sizeof(uint16_t) * 127);
         PUD_VERBOSE(pud, 1, "Obsolete section in UDTA found. Skipping...");
      }
+   SECTION_CHECK(PUD_SECTION_UDTA);
 
    return PUD_TRUE;
 }
@@ -405,6 +418,7 @@ pud_parse_alow(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint32_t buf[16];
    struct allow *ptrs[] = {
@@ -419,7 +433,7 @@ pud_parse_alow(Pud *pud)
    int i;
 
    pud->private_data->default_allow = 0; // Reset before checking
-   chk = pud_go_to_section(pud, PUD_SECTION_ALOW);
+   chk = pud_go_to_section(pud, PUD_SECTION_ALOW, &cur);
    if (!chk)
      {
         PUD_VERBOSE(pud, 2, "Section ALOW (optional) not present. Skipping...");
@@ -429,15 +443,15 @@ pud_parse_alow(Pud *pud)
    PUD_VERBOSE(pud, 2, "At section ALOW (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_ALOW);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
    for (i = 0; i < ptrs_count; i++)
      {
-        PUD_READ_BUFFER(pud, buf, sizeof(uint32_t) * 16);
+        common_cursor_read(&cur, buf, sizeof(uint32_t) * 16);
 
         memcpy(&(ptrs[i]->players[0]),  &(buf[0]),  sizeof(uint32_t) * 8);
         memcpy(&(ptrs[i]->unusable[0]), &(buf[8]),  sizeof(uint32_t) * 7);
         memcpy(&(ptrs[i]->neutral),     &(buf[15]), sizeof(uint32_t) * 1);
      }
+   SECTION_CHECK(PUD_SECTION_ALOW);
 
    return PUD_TRUE;
 }
@@ -447,57 +461,57 @@ pud_parse_ugrd(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    int i;
    uint8_t bb[64];
    uint16_t wb[64];
    uint32_t lb[64];
 
-   chk = pud_go_to_section(pud, PUD_SECTION_UGRD);
+   chk = pud_go_to_section(pud, PUD_SECTION_UGRD, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section UGRD");
    PUD_VERBOSE(pud, 2, "At section UGRD (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_UGRD);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-
    /* Use default data */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t));
+   common_cursor_read(&cur, wb, sizeof(uint16_t));
    pud->private_data->default_ugrd = !!wb[0];
 
    /* upgrades time */
-   PUD_READ_BUFFER(pud, bb, sizeof(uint8_t) * 52);
+   common_cursor_read(&cur, bb, sizeof(uint8_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].time = bb[i];
 
    /* Gold cost */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 52);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].gold = wb[i];
 
    /* Lumber cost */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 52);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].lumber = wb[i];
 
    /* Oil cost */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 52);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].oil = wb[i];
 
    /* Icon */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 52);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].icon = wb[i];
 
    /* Group */
-   PUD_READ_BUFFER(pud, wb, sizeof(uint16_t) * 52);
+   common_cursor_read(&cur, wb, sizeof(uint16_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].group = wb[i];
 
    /* Flags */
-   PUD_READ_BUFFER(pud, lb, sizeof(uint32_t) * 52);
+   common_cursor_read(&cur, lb, sizeof(uint32_t) * 52);
    for (i = 0; i < 52; i++)
      pud->upgrades[i].flags = lb[i];
+   SECTION_CHECK(PUD_SECTION_UGRD);
 
    return PUD_TRUE;
 }
@@ -507,16 +521,17 @@ pud_parse_sgld(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint16_t buf[16];
 
-   chk = pud_go_to_section(pud, PUD_SECTION_SGLD);
+   chk = pud_go_to_section(pud, PUD_SECTION_SGLD, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SGLD");
    PUD_VERBOSE(pud, 2, "At section SGLD (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_SGLD);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   PUD_READ_BUFFER(pud, buf, sizeof(uint16_t) * 16);
+   common_cursor_read(&cur, buf, sizeof(uint16_t) * 16);
+   SECTION_CHECK(PUD_SECTION_SGLD);
 
    memcpy(&(pud->sgld.players[0]),  &(buf[0]),  sizeof(uint16_t) * 8);
    memcpy(&(pud->sgld.unusable[0]), &(buf[8]),  sizeof(uint16_t) * 7);
@@ -530,16 +545,17 @@ pud_parse_slbr(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint16_t buf[16];
 
-   chk = pud_go_to_section(pud, PUD_SECTION_SLBR);
+   chk = pud_go_to_section(pud, PUD_SECTION_SLBR, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SLBR");
    PUD_VERBOSE(pud, 2, "At section SLBR (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_SLBR);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   PUD_READ_BUFFER(pud, buf, sizeof(uint16_t) * 16);
+   common_cursor_read(&cur, buf, sizeof(uint16_t) * 16);
+   SECTION_CHECK(PUD_SECTION_SLBR);
 
    memcpy(&(pud->slbr.players[0]),  &(buf[0]),  sizeof(uint16_t) * 8);
    memcpy(&(pud->slbr.unusable[0]), &(buf[8]),  sizeof(uint16_t) * 7);
@@ -553,16 +569,17 @@ pud_parse_soil(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint16_t buf[16];
 
-   chk = pud_go_to_section(pud, PUD_SECTION_SOIL);
+   chk = pud_go_to_section(pud, PUD_SECTION_SOIL, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SOIL");
    PUD_VERBOSE(pud, 2, "At section SOIL (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_SOIL);
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-   PUD_READ_BUFFER(pud, buf, sizeof(uint16_t) * 16);
+   common_cursor_read(&cur, buf, sizeof(uint16_t) * 16);
+   SECTION_CHECK(PUD_SECTION_SOIL);
 
    memcpy(&(pud->soil.players[0]),  &(buf[0]),  sizeof(uint16_t) * 8);
    memcpy(&(pud->soil.unusable[0]), &(buf[8]),  sizeof(uint16_t) * 7);
@@ -576,15 +593,17 @@ pud_parse_aipl(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    uint8_t buf[16];
 
-   chk = pud_go_to_section(pud, PUD_SECTION_AIPL);
+   chk = pud_go_to_section(pud, PUD_SECTION_AIPL, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section AIPL");
    PUD_VERBOSE(pud, 2, "At section AIPL (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_AIPL);
 
-   PUD_READ_BUFFER(pud, buf, sizeof(uint8_t) * 16);
+   common_cursor_read(&cur, buf, sizeof(uint8_t) * 16);
+   SECTION_CHECK(PUD_SECTION_AIPL);
 
    memcpy(&(pud->ai.players[0]),  &(buf[0]),  sizeof(uint8_t) * 8);
    memcpy(&(pud->ai.unusable[0]), &(buf[8]),  sizeof(uint8_t) * 7);
@@ -598,11 +617,10 @@ pud_parse_mtxm(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
-   uint16_t w;
-   unsigned int i;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_MTXM);
+   chk = pud_go_to_section(pud, PUD_SECTION_MTXM, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section MTXM");
    PUD_VERBOSE(pud, 2, "At section MTXM (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_MTXM);
@@ -611,11 +629,9 @@ pud_parse_mtxm(Pud *pud)
    if ((pud->tiles * sizeof(uint16_t)) != chk)
      DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
 
-   for (i = 0; i < pud->tiles; i++)
-     {
-        w = PUD_READ16(pud);
-        pud->tiles_map[i] = w;
-     }
+   /* The whole layer at once: a single bounds check, then a copy */
+   common_cursor_read(&cur, pud->tiles_map, chk);
+   SECTION_CHECK(PUD_SECTION_MTXM);
 
    return PUD_TRUE;
 }
@@ -625,11 +641,10 @@ pud_parse_sqm(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
-   uint16_t w;
-   unsigned int i;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_SQM);
+   chk = pud_go_to_section(pud, PUD_SECTION_SQM, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SQM ");
    PUD_VERBOSE(pud, 2, "At section SQM  (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_SQM);
@@ -638,11 +653,9 @@ pud_parse_sqm(Pud *pud)
    if ((pud->tiles * sizeof(uint16_t)) != chk)
      DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
 
-   for (i = 0; i < pud->tiles; i++)
-     {
-        w = PUD_READ16(pud);
-        pud->movement_map[i] = w;
-     }
+   /* The whole layer at once: a single bounds check, then a copy */
+   common_cursor_read(&cur, pud->movement_map, chk);
+   SECTION_CHECK(PUD_SECTION_SQM);
 
    return PUD_TRUE;
 }
@@ -652,21 +665,22 @@ pud_parse_oilm(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
-   unsigned int i;
-   uint8_t b;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_OILM);
+   chk = pud_go_to_section(pud, PUD_SECTION_OILM, &cur);
    if (!chk) PUD_VERBOSE(pud, 2, "Section OILM (obsolete) not present. Skipping...");
    else
      {
+        if (chk < pud->tiles)
+          DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
         if (!pud->oil_map)
-          pud->oil_map = malloc(pud->tiles * sizeof(uint8_t));
-        for (i = 0; i < pud->tiles; i++)
           {
-             b = PUD_READ8(pud);
-             pud->oil_map[i] = b;
+             pud->oil_map = malloc(pud->tiles * sizeof(uint8_t));
+             if (!pud->oil_map) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
           }
+        common_cursor_read(&cur, pud->oil_map, pud->tiles);
+        SECTION_CHECK(PUD_SECTION_OILM);
      }
 
    return PUD_TRUE;
@@ -677,13 +691,10 @@ pud_parse_regm(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
-   uint16_t w;
-   unsigned int i;
 
-   PUD_TRAP_SETUP(pud) { return PUD_FALSE; }
-
-   chk = pud_go_to_section(pud, PUD_SECTION_REGM);
+   chk = pud_go_to_section(pud, PUD_SECTION_REGM, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section REGM");
    PUD_VERBOSE(pud, 2, "At section REGM (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_REGM);
@@ -692,25 +703,35 @@ pud_parse_regm(Pud *pud)
    if ((pud->tiles * sizeof(uint16_t)) != chk)
      DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
 
-   for (i = 0; i < pud->tiles; i++)
-     {
-        w = PUD_READ16(pud);
-        pud->action_map[i] = w;
-     }
+   /* The whole layer at once: a single bounds check, then a copy */
+   common_cursor_read(&cur, pud->action_map, chk);
+   SECTION_CHECK(PUD_SECTION_REGM);
 
    return PUD_TRUE;
 }
 
+/* Pud_Unit_Info has the layout of the 8 bytes records of the UNIT section
+ * (x, y, type, player, alter), so all the units are copied at once. This
+ * fails to compile if the layout changes. */
+typedef char _pud_unit_info_layout_check[
+   ((sizeof(Pud_Unit_Info) == 8) &&
+    (offsetof(Pud_Unit_Info, x) == 0) &&
+    (offsetof(Pud_Unit_Info, y) == 2) &&
+    (offsetof(Pud_Unit_Info, type) == 4) &&
+    (offsetof(Pud_Unit_Info, player) == 5) &&
+    (offsetof(Pud_Unit_Info, alter) == 6)) ? 1 : -1];
+
 PUDAPI Pud_Bool
 pud_parse_unit(Pud *pud)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
+   Common_Cursor cur;
    uint32_t chk;
    int units, size, i;
    Pud_Unit_Info *u;
 
-   chk = pud_go_to_section(pud, PUD_SECTION_UNIT);
+   chk = pud_go_to_section(pud, PUD_SECTION_UNIT, &cur);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section UNIT");
    PUD_VERBOSE(pud, 2, "At section UNIT (size = %u)", chk);
    HAS_SECTION(PUD_SECTION_UNIT);
@@ -722,14 +743,9 @@ pud_parse_unit(Pud *pud)
    memset(pud->units, 0, size);
    pud->units_count = units;
 
-   for (i = 0; i < units; ++i)
-     {
-        pud->units[i].x      = PUD_READ16(pud);
-        pud->units[i].y      = PUD_READ16(pud);
-        pud->units[i].type   = PUD_READ8(pud);
-        pud->units[i].player = PUD_READ8(pud);
-        pud->units[i].alter  = PUD_READ16(pud);
-     }
+   /* Records are copied as is (see _pud_unit_info_layout_check) */
+   common_cursor_read(&cur, pud->units, units * 8);
+   SECTION_CHECK(PUD_SECTION_UNIT);
 
    pud->starting_points = 0;
    for (i = 0; i < units; i++)
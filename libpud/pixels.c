@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2014-2016 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "pud_private.h"
+
+/*
+ * Conversion kernels. Each one is a single loop without branches over
+ * plain bytes, so compilers can vectorize them. Native-endian words are
+ * built in registers and stored with memcpy(), which becomes a single
+ * (unaligned) store.
+ */
+
+/* Exact round(c * a / 255) */
+#define PREMUL(C, A) \
+   ((((unsigned int)(C) * (A) + 128) + (((unsigned int)(C) * (A) + 128) >> 8)) >> 8)
+
+static void
+_convert_argb(const unsigned char *src,
+              unsigned char       *dst,
+              size_t               count)
+{
+   size_t i;
+   uint32_t px;
+
+   for (i = 0; i < count; i++, src += 4, dst += 4)
+     {
+        px = ((uint32_t)src[3] << 24) | ((uint32_t)src[0] << 16) |
+             ((uint32_t)src[1] << 8) | (uint32_t)src[2];
+        memcpy(dst, &px, sizeof(px));
+     }
+}
+
+static void
+_convert_argb32_premul(const unsigned char *src,
+                       unsigned char       *dst,
+                       size_t               count)
+{
+   size_t i;
+   uint32_t px;
+   unsigned int a;
+
+   for (i = 0; i < count; i++, src += 4, dst += 4)
+     {
+        a = src[3];
+        px = ((uint32_t)a << 24) |
+             ((uint32_t)PREMUL(src[0], a) << 16) |
+             ((uint32_t)PREMUL(src[1], a) << 8) |
+             (uint32_t)PREMUL(src[2], a);
+        memcpy(dst, &px, sizeof(px));
+     }
+}
+
+static void
+_convert_bgra(const unsigned char *src,
+              unsigned char       *dst,
+              size_t               count)
+{
+   size_t i;
+
+   for (i = 0; i < count; i++, src += 4, dst += 4)
+     {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+        dst[3] = src[3];
+     }
+}
+
+static void
+_convert_rgb(const unsigned char *src,
+             unsigned char       *dst,
+             size_t               count)
+{
+   size_t i;
+
+   for (i = 0; i < count; i++, src += 4, dst += 3)
+     {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+     }
+}
+
+static void
+_convert_rgb565(const unsigned char *src,
+                unsigned char       *dst,
+                size_t               count)
+{
+   size_t i;
+   uint16_t px;
+
+   for (i = 0; i < count; i++, src += 4, dst += 2)
+     {
+        px = ((src[0] >> 3) << 11) | ((src[1] >> 2) << 5) | (src[2] >> 3);
+        memcpy(dst, &px, sizeof(px));
+     }
+}
+
+PUDAPI unsigned int
+pud_pixel_format_size(Pud_Pixel_Format pfmt)
+{
+   switch (pfmt)
+     {
+      case PUD_PIXEL_FORMAT_RGBA:
+      case PUD_PIXEL_FORMAT_ARGB:
+      case PUD_PIXEL_FORMAT_ARGB32_PREMUL:
+      case PUD_PIXEL_FORMAT_BGRA:
+         return 4;
+
+      case PUD_PIXEL_FORMAT_RGB:
+         return 3;
+
+      case PUD_PIXEL_FORMAT_RGB565:
+         return 2;
+
+      default:
+         break;
+     }
+   return 0;
+}
+
+PUDAPI Pud_Bool
+pud_pixels_convert(const Pud_Color  *src,
+                   void             *dst,
+                   size_t            count,
+                   Pud_Pixel_Format  pfmt)
+{
+   const unsigned char *const s = (const unsigned char *)src;
+   unsigned char *const d = dst;
+
+   switch (pfmt)
+     {
+      case PUD_PIXEL_FORMAT_RGBA:
+         if (d != s) memcpy(d, s, count * sizeof(Pud_Color));
+         break;
+
+      case PUD_PIXEL_FORMAT_ARGB:
+         _convert_argb(s, d, count);
+         break;
+
+      case PUD_PIXEL_FORMAT_ARGB32_PREMUL:
+         _convert_argb32_premul(s, d, count);
+         break;
+
+      case PUD_PIXEL_FORMAT_BGRA:
+         _convert_bgra(s, d, count);
+         break;
+
+      case PUD_PIXEL_FORMAT_RGB:
+         _convert_rgb(s, d, count);
+         break;
+
+      case PUD_PIXEL_FORMAT_RGB565:
+         _convert_rgb565(s, d, count);
+         break;
+
+      default:
+         DIE_RETURN(PUD_FALSE, "Invalid pixel format %i", pfmt);
+     }
+
+   return PUD_TRUE;
+}
@@ -33,7 +33,7 @@ static const char * const _pud_sections[] =
 PUDAPI const char *
 pud_section_to_string(Pud_Section section)
 {
-   return ((unsigned) section >= 20) ? NULL : _pud_sections[section];
+   return ((unsigned) section >= PUD_SECTIONS_COUNT) ? NULL : _pud_sections[section];
 }
 
 PUDAPI Pud_Bool
@@ -72,58 +72,98 @@ pud_shutdown(void)
    /* Nothing to do */
 }
 
-/*
- * TODO FIXME
- * Bad design (this file should not have been parsed like this)
- */
-PUDAPI_INTERNAL uint32_t
-pud_go_to_section(Pud         *pud,
-                  Pud_Section  sec)
+static int
+_section_from_tag(const unsigned char *tag)
 {
-   uint8_t b;
-   uint32_t l;
-   char buf[4];
-   const char *sec_str;
-
-   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
-   if (sec > 19) DIE_RETURN(0, "Invalid section ID [%i]", sec);
-
-   sec_str = _pud_sections[sec];
-
-   /* If the section to search for is before the current section,
-    * rewind the file to catch it. If it is after, do nothing */
-   if (sec <= pud->private_data->current_section)
-      common_mmap_ptr_reset(pud->private_data->mem_map);
-
-   /* Tell the PUD we are pointing at the last section.
-    * In case of success the pud will be pointing at the section
-    * it had to go.
-    * On failure, it will have to rewind itself on next call */
-   pud->private_data->current_section = PUD_SECTION_UNIT;
-
-   PUD_TRAP_SETUP(pud) {
-     return 0;
-   }
+   unsigned int i;
 
-   PUD_READ_BUFFER(pud, buf, 4);
+   for (i = 0; i < PUD_SECTIONS_COUNT; i++)
+     if (!memcmp(tag, _pud_sections[i], 4))
+       return i;
+   return -1;
+}
 
-   while (common_mem_map_ok(pud->private_data->mem_map, 4))
+PUDAPI_INTERNAL void
+pud_sections_index(Pud *pud)
+{
+   Pud_Private *const priv = pud->private_data;
+   const unsigned char *map;
+   size_t size, off;
+   uint32_t len;
+   int sec;
+
+   memset(priv->index, 0, sizeof(priv->index));
+   priv->unknown_sections = 0;
+   priv->trailing_bytes = 0;
+   if (!priv->mem_map) return;
+   map = priv->mem_map->map;
+   size = priv->mem_map->size;
+
+   /* Sections are chained: a 4 bytes tag, a 32 bits length, then the
+    * data. The chain is walked once, so each section is then a seek. */
+   for (off = 0; size - off >= 8; off += 8 + len)
      {
-        if (!strncmp(buf, sec_str, 4))
+        memcpy(&len, &(map[off + 4]), sizeof(uint32_t));
+        if (len > size - off - 8)
           {
-             /* Update current section */
-             pud->private_data->current_section = sec;
-
-             l = PUD_READ32(pud);
-             return l;
+             ERR("Section at offset %zu is truncated: %u bytes announced, "
+                 "%zu available", off, len, size - off - 8);
+             return;
           }
 
-        memmove(buf, &(buf[1]), 3 * sizeof(char));
-        b = PUD_READ8(pud);
-        buf[3] = b;
+        /* Unknown sections and trailing bytes are harmless: they are
+         * reported by pud_parse(), when verbosity can be set */
+        sec = _section_from_tag(&(map[off]));
+        if (sec < 0)
+          {
+             if (priv->unknown_sections++ == 0)
+               priv->unknown_offset = off;
+          }
+        else if (priv->index[sec].offset != 0)
+          ERR("Duplicate section [%s] at offset %zu. Using the first one.",
+              _pud_sections[sec], off);
+        else
+          {
+             priv->index[sec].offset = off + 8;
+             priv->index[sec].size = len;
+          }
      }
 
-   return 0;
+   priv->trailing_bytes = size - off;
+}
+
+static void
+_sections_report(const Pud *pud)
+{
+   const Pud_Private *const priv = pud->private_data;
+
+   if (priv->unknown_sections > 0)
+     PUD_VERBOSE(pud, 1, "Skipped %u unknown section(s). First one is [%.4s] "
+                 "at offset %zu", priv->unknown_sections,
+                 (const char *)priv->mem_map->map + priv->unknown_offset,
+                 priv->unknown_offset);
+   if (priv->trailing_bytes > 0)
+     PUD_VERBOSE(pud, 1, "Ignored %zu trailing bytes after the last section",
+                 priv->trailing_bytes);
+}
+
+PUDAPI_INTERNAL uint32_t
+pud_go_to_section(Pud           *pud,
+                  Pud_Section    sec,
+                  Common_Cursor *cur)
+{
+   const Pud_Section_Index *idx;
+
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
+   if ((unsigned int)sec >= PUD_SECTIONS_COUNT)
+     DIE_RETURN(0, "Invalid section ID [%i]", sec);
+
+   /* The cursor cannot go past the end of the section */
+   idx = &(pud->private_data->index[sec]);
+   if (idx->offset == 0) return 0;
+   common_cursor_init(cur, (unsigned char *)pud->private_data->mem_map->map + idx->offset,
+                      idx->size);
+   return idx->size;
 }
 
 PUDAPI uint32_t
@@ -179,6 +219,7 @@ pud_open(const char    *file,
           {
              pud->private_data->mem_map = common_file_mmap(file);
              if (!pud->private_data->mem_map) DIE_GOTO(err, "Failed to map file \"%s\"", file);
+             pud_sections_index(pud);
 
              if (!(mode & PUD_OPEN_MODE_NO_PARSE))
                {
@@ -227,10 +268,18 @@ pud_close(Pud *pud)
    free(pud);
 }
 
+PUDAPI void
+pud_verbosity_set(Pud *pud,
+                  int  level)
+{
+   if (pud) pud->private_data->verbose = level;
+}
+
 PUDAPI Pud_Bool
 pud_parse(Pud *pud)
 {
    pud->private_data->sections = 0;
+   _sections_report(pud);
 
 #define PARSE_SEC(sec) \
    if (!pud_parse_ ## sec(pud)) DIE_RETURN(PUD_FALSE, "Failed to parse " #sec)
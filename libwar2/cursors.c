@@ -23,6 +23,90 @@
 #include "war2_private.h"
 
 
+/*
+ * x, y, w and h are encoded in the first 2*4 = 8 bytes of the entry.
+ * What is left of the entry is the image data. Returns the palette
+ * indexes of the image, or NULL if the entry is too small.
+ */
+static const unsigned char *
+_cursor_image_get(const unsigned char *ptr,
+                  size_t               size,
+                  unsigned int         entry,
+                  int                 *x,
+                  int                 *y,
+                  unsigned int        *w,
+                  unsigned int        *h)
+{
+   uint16_t hotx, hoty, width, height;
+
+   if (size < 8) DIE_RETURN(NULL, "Entry [%u] is too small", entry);
+
+   memcpy(&hotx, &(ptr[0]), sizeof(uint16_t));
+   memcpy(&hoty, &(ptr[2]), sizeof(uint16_t));
+   memcpy(&width, &(ptr[4]), sizeof(uint16_t));
+   memcpy(&height, &(ptr[6]), sizeof(uint16_t));
+
+   if ((size_t)width * height > size - 8)
+     DIE_RETURN(NULL, "Entry [%u] is too small for a %ux%u cursor",
+                entry, width, height);
+
+   *x = hotx;
+   *y = hoty;
+   *w = width;
+   *h = height;
+   return ptr + 8;
+}
+
+PUDAPI const Pud_Color *
+war2_decoder_cursors_decode(War2_Data    *w2,
+                            War2_Decoder *dec,
+                            unsigned int  entry,
+                            int          *x,
+                            int          *y,
+                            unsigned int *w,
+                            unsigned int *h)
+{
+   size_t size, img_size;
+   int hotx, hoty;
+   unsigned int width, height;
+   Pud_Color *img_rgba;
+   unsigned int k;
+   const Pud_Color *palette;
+   const unsigned char *ptr;
+
+   if (! w2) DIE_RETURN(NULL, "NULL data");
+   if (! dec) DIE_RETURN(NULL, "NULL decoder");
+
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   ptr = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY, entry, &size);
+   if (! ptr) DIE_RETURN(NULL, "Failed to extract entry");
+   ptr = _cursor_image_get(ptr, size, entry, &hotx, &hoty, &width, &height);
+   if (! ptr) return NULL;
+
+   img_size = width * height;
+   img_rgba = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_RGBA,
+                                      img_size * sizeof(Pud_Color));
+   if (! img_rgba) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   for (k = 0; k < img_size; k++)
+     img_rgba[k] = palette[ptr[k]];
+
+   dec->pixels = img_rgba;
+   if (dec->format != PUD_PIXEL_FORMAT_RGBA)
+     {
+        war2_decoder_palette_set(dec, palette);
+        dec->pixels = war2_decoder_pixels_lookup(dec, ptr, img_size);
+        if (! dec->pixels) DIE_RETURN(NULL, "Failed to allocate memory");
+     }
+
+   if (x) *x = hotx;
+   if (y) *y = hoty;
+   if (w) *w = width;
+   if (h) *h = height;
+
+   return img_rgba;
+}
+
 PUDAPI Pud_Color *
 war2_cursors_decode(War2_Data *w2,
                     unsigned int entry,
@@ -31,27 +115,23 @@ war2_cursors_decode(War2_Data *w2,
                     unsigned int *h)
 {
    size_t size, img_size;
-   uint16_t hotx, hoty, width, height;
-   Pud_Color *img_rgba;
+   int hotx, hoty;
+   unsigned int width, height;
+   Pud_Color *img_rgba = NULL;
    unsigned int k;
    const Pud_Color *const palette = war2_palette_get(w2, PUD_ERA_FOREST);
-   unsigned char *const mem = war2_entry_extract(w2, entry, &size);
-   unsigned char *ptr = mem;
+   const unsigned char *ptr;
+   unsigned char *mem;
 
+   /* No decoder: the image is decoded directly in the returned buffer */
+   mem = war2_entry_extract(w2, entry, &size);
    if (! mem) DIE_RETURN(NULL, "Failed to extract entry");
-   /*
-    * x, y, w and h are encoded in the first 2*4 = 8 bytes of the entry.
-    * What is left of the entry is the image data.
-    */
-   memcpy(&hotx, &(ptr[0]), sizeof(uint16_t));
-   memcpy(&hoty, &(ptr[2]), sizeof(uint16_t));
-   memcpy(&width, &(ptr[4]), sizeof(uint16_t));
-   memcpy(&height, &(ptr[6]), sizeof(uint16_t));
-   ptr += 8;
+   ptr = _cursor_image_get(mem, size, entry, &hotx, &hoty, &width, &height);
+   if (! ptr) goto end;
 
    img_size = width * height;
    img_rgba = malloc(img_size * sizeof(Pud_Color));
-   if (! img_rgba) DIE_GOTO(fail, "Failed to allocate memory");
+   if (! img_rgba) DIE_GOTO(end, "Failed to allocate memory");
 
    for (k = 0; k < img_size; k++)
      img_rgba[k] = palette[ptr[k]];
@@ -60,11 +140,175 @@ war2_cursors_decode(War2_Data *w2,
    if (y) *y = hoty;
    if (w) *w = width;
    if (h) *h = height;
-
+end:
    free(mem);
    return img_rgba;
+}
+
+typedef struct
+{
+   size_t        offset; /* Of the palette indexes in the staging buffer */
+   unsigned int  index; /* In the images of the atlas */
+   unsigned int  h; /* Sort key */
+} Packed_Image;
+
+static int
+_height_cmp(const void *a,
+            const void *b)
+{
+   const Packed_Image *const pa = a;
+   const Packed_Image *const pb = b;
+
+   if (pa->h != pb->h) return (pa->h > pb->h) ? -1 : 1;
+   return (pa->index > pb->index) - (pa->index < pb->index);
+}
+
+/*
+ * Shelf packing: images are sorted by decreasing height and placed from
+ * left to right on rows as high as their first image. The width of the
+ * atlas is the side of a square of the same area, so it stays roughly
+ * square.
+ */
+static void
+_images_pack(War2_Images_Atlas *atlas,
+             Packed_Image      *packed)
+{
+   War2_Atlas_Image *img;
+   unsigned int i, x = 0, y = 0, row_h = 0, max_w = 1;
+   size_t area = 0;
+
+   for (i = 0; i < atlas->count; i++)
+     {
+        img = &(atlas->images[i]);
+        area += (size_t)img->w * img->h;
+        if (img->w > max_w) max_w = img->w;
+     }
+   for (atlas->w = 1; (size_t)atlas->w * atlas->w < area; atlas->w *= 2);
+   if (atlas->w < max_w) atlas->w = max_w;
+
+   qsort(packed, atlas->count, sizeof(Packed_Image), _height_cmp);
+
+   for (i = 0; i < atlas->count; i++)
+     {
+        img = &(atlas->images[packed[i].index]);
+        if (x + img->w > atlas->w)
+          {
+             x = 0;
+             y += row_h;
+             row_h = 0;
+          }
+        img->x = x;
+        img->y = y;
+        x += img->w;
+        if (img->h > row_h) row_h = img->h;
+     }
+   atlas->h = y + row_h;
+}
+
+PUDAPI War2_Images_Atlas *
+war2_cursors_atlas_new(War2_Data          *w2,
+                       const unsigned int *ui_entries,
+                       unsigned int        ui_count)
+{
+   War2_Decoder *dec;
+   War2_Images_Atlas *atlas = NULL;
+   War2_Atlas_Image *img;
+   Packed_Image *packed = NULL;
+   const Pud_Color *palette;
+   const unsigned char *ptr, *src;
+   unsigned char *staging = NULL, *mem;
+   size_t size, used = 0, alloc = 0, pixels;
+   Pud_Color *dst;
+   unsigned int i, x, row, count;
+
+   if (!w2) DIE_RETURN(NULL, "NULL data");
+   if ((ui_count > 0) && (!ui_entries)) DIE_RETURN(NULL, "NULL UI entries");
+
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(NULL, "Failed to create decoder");
+
+   count = WAR2_CURSORS_COUNT + ui_count;
+   atlas = calloc(1, sizeof(War2_Images_Atlas) + count * sizeof(War2_Atlas_Image));
+   packed = calloc(count, sizeof(Packed_Image));
+   if ((!atlas) || (!packed)) DIE_GOTO(fail, "Failed to allocate memory");
+   atlas->count = count;
+
+   /* The palette indexes of all the images are extracted in a single
+    * staging buffer, until their position in the atlas is known */
+   for (i = 0; i < count; i++)
+     {
+        img = &(atlas->images[i]);
+        img->entry = (i < WAR2_CURSORS_COUNT)
+           ? __WAR2_CURSOR_FIRST + i
+           : ui_entries[i - WAR2_CURSORS_COUNT];
+
+        ptr = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY,
+                                     img->entry, &size);
+        if (ptr)
+          {
+             if (i < WAR2_CURSORS_COUNT)
+               ptr = _cursor_image_get(ptr, size, img->entry,
+                                       &(img->hot_x), &(img->hot_y),
+                                       &(img->w), &(img->h));
+             else
+               ptr = war2_ui_image_get(ptr, size, img->entry,
+                                       &(img->w), &(img->h));
+          }
+        if (!ptr) DIE_GOTO(fail, "Failed to decode entry [%u]", img->entry);
+
+        pixels = (size_t)img->w * img->h;
+        if (used + pixels > alloc)
+          {
+             alloc = (alloc) ? alloc * 2 : 64 * 1024;
+             while (used + pixels > alloc) alloc *= 2;
+             mem = realloc(staging, alloc);
+             if (!mem) DIE_GOTO(fail, "Failed to allocate memory");
+             staging = mem;
+          }
+        memcpy(staging + used, ptr, pixels);
+
+        packed[i].offset = used;
+        packed[i].index = i;
+        packed[i].h = img->h;
+        used += pixels;
+     }
+
+   /* Images are then converted directly in the rows of the atlas */
+   _images_pack(atlas, packed);
+   atlas->rgba = calloc((size_t)atlas->w * atlas->h, sizeof(Pud_Color));
+   if (!atlas->rgba) DIE_GOTO(fail, "Failed to allocate memory");
+
+   for (i = 0; i < count; i++)
+     {
+        img = &(atlas->images[packed[i].index]);
+        src = staging + packed[i].offset;
+        for (row = 0; row < img->h; row++)
+          {
+             dst = &(atlas->rgba[(size_t)(img->y + row) * atlas->w + img->x]);
+             for (x = 0; x < img->w; x++)
+               dst[x] = palette[src[x]];
+             src += img->w;
+          }
+     }
+   free(staging);
+   free(packed);
+   war2_decoder_free(dec);
+
+   return atlas;
 
 fail:
-   free(mem);
+   free(staging);
+   free(packed);
+   war2_images_atlas_free(atlas);
+   war2_decoder_free(dec);
    return NULL;
 }
+
+PUDAPI void
+war2_images_atlas_free(War2_Images_Atlas *atlas)
+{
+   if (!atlas) return;
+   free(atlas->rgba);
+   free(atlas);
+}
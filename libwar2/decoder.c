@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+PUDAPI War2_Decoder *
+war2_decoder_new(void)
+{
+   War2_Decoder *dec;
+
+   dec = calloc(1, sizeof(War2_Decoder));
+   if (!dec) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   return dec;
+}
+
+PUDAPI void
+war2_decoder_free(War2_Decoder *dec)
+{
+   unsigned int i;
+
+   if (!dec) return;
+   for (i = 0; i < __WAR2_DECODER_SLOT_LAST; i++)
+     free(dec->slots[i].mem);
+   free(dec);
+}
+
+PUDAPI_INTERNAL void *
+war2_decoder_buffer_get(War2_Decoder      *dec,
+                        War2_Decoder_Slot  slot,
+                        size_t             size)
+{
+   void *mem;
+
+   /* Always provide a valid pointer, even for empty data */
+   if (size == 0) size = 1;
+
+   /* Buffers never shrink: after a few decodings, they are large enough
+    * for any entry and no allocation happens anymore */
+   if (size > dec->slots[slot].size)
+     {
+        mem = realloc(dec->slots[slot].mem, size);
+        if (!mem) DIE_RETURN(NULL, "Failed to allocate memory");
+        dec->slots[slot].mem = mem;
+        dec->slots[slot].size = size;
+     }
+   return dec->slots[slot].mem;
+}
+
+PUDAPI Pud_Bool
+war2_decoder_pixel_format_set(War2_Decoder     *dec,
+                              Pud_Pixel_Format  pfmt)
+{
+   if (pud_pixel_format_size(pfmt) == 0)
+     DIE_RETURN(PUD_FALSE, "Invalid pixel format %i", pfmt);
+
+   dec->format = pfmt;
+   dec->pixels = NULL;
+
+   return PUD_TRUE;
+}
+
+PUDAPI Pud_Pixel_Format
+war2_decoder_pixel_format_get(const War2_Decoder *dec)
+{
+   return dec->format;
+}
+
+PUDAPI const void *
+war2_decoder_pixels_get(const War2_Decoder *dec)
+{
+   return dec->pixels;
+}
+
+PUDAPI_INTERNAL void
+war2_decoder_palette_set(War2_Decoder    *dec,
+                         const Pud_Color *palette)
+{
+   pud_pixels_convert(palette, dec->lut, WAR2_PALETTE_SIZE, dec->format);
+}
+
+PUDAPI_INTERNAL const void *
+war2_decoder_pixels_lookup(War2_Decoder        *dec,
+                           const unsigned char *indexes,
+                           size_t               count)
+{
+   const unsigned char *const lut = dec->lut;
+   const unsigned int bpp = pud_pixel_format_size(dec->format);
+   unsigned char *pixels, *p;
+   size_t i;
+
+   pixels = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_PIXELS, count * bpp);
+   if (!pixels) return NULL;
+
+   /* One loop per size, so each copy is a single load and store */
+   p = pixels;
+   switch (bpp)
+     {
+      case 4:
+         for (i = 0; i < count; i++, p += 4)
+           memcpy(p, &(lut[indexes[i] * 4]), 4);
+         break;
+
+      case 3:
+         for (i = 0; i < count; i++, p += 3)
+           memcpy(p, &(lut[indexes[i] * 3]), 3);
+         break;
+
+      case 2:
+         for (i = 0; i < count; i++, p += 2)
+           memcpy(p, &(lut[indexes[i] * 2]), 2);
+         break;
+     }
+
+   return pixels;
+}
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+#ifdef HAVE_MSVC
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+struct _War2_Image_Encoder
+{
+   War2_Image_Format      format;
+   unsigned int           w;
+   unsigned int           h;
+   unsigned int           rows;
+
+   War2_Image_Write_Func  func;
+   void                  *data;
+   int                    fd;
+
+   /* Output of war2_image_encoder_buffer_new() */
+   struct {
+      unsigned char *mem;
+      size_t         size;
+      size_t         alloc;
+   } buffer;
+   Pud_Bool               buffered;
+
+   War2_Png_Options       png_opts;
+   Pud_Bool               png_opts_set;
+   int                    jpeg_quality;
+
+   /* Backends, created when the first row is written */
+   War2_Png_Stream       *png;
+   War2_Jpeg_Stream      *jpeg;
+   War2_Qoi_Stream       *qoi;
+   unsigned char         *rgb; /* One PPM row */
+
+   Pud_Bool               started;
+   Pud_Bool               finished;
+   Pud_Bool               failed;
+};
+
+PUDAPI_INTERNAL Pud_Bool
+war2_image_file_write(void                *data,
+                      const unsigned char *bytes,
+                      size_t               size)
+{
+   return (fwrite(bytes, 1, size, data) == size) ? PUD_TRUE : PUD_FALSE;
+}
+
+static Pud_Bool
+_fd_write(void                *data,
+          const unsigned char *bytes,
+          size_t               size)
+{
+   const War2_Image_Encoder *const enc = data;
+#ifdef HAVE_MSVC
+   int ret;
+#else
+   ssize_t ret;
+#endif
+
+   /* Pipes and sockets may accept less than what is asked */
+   while (size > 0)
+     {
+#ifdef HAVE_MSVC
+        ret = _write(enc->fd, bytes, (unsigned int)size);
+#else
+        ret = write(enc->fd, bytes, size);
+#endif
+        if (ret < 0)
+          {
+             if (errno == EINTR) continue;
+             DIE_RETURN(PUD_FALSE, "Failed to write to descriptor %i: %s",
+                        enc->fd, strerror(errno));
+          }
+        bytes += ret;
+        size -= ret;
+     }
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_buffer_write(void                *data,
+              const unsigned char *bytes,
+              size_t               size)
+{
+   War2_Image_Encoder *const enc = data;
+   unsigned char *mem;
+   size_t alloc;
+
+   if (size > enc->buffer.alloc - enc->buffer.size)
+     {
+        alloc = (enc->buffer.alloc) ? enc->buffer.alloc : 4096;
+        while (size > alloc - enc->buffer.size)
+          alloc *= 2;
+        mem = realloc(enc->buffer.mem, alloc);
+        if (!mem) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        enc->buffer.mem = mem;
+        enc->buffer.alloc = alloc;
+     }
+   memcpy(enc->buffer.mem + enc->buffer.size, bytes, size);
+   enc->buffer.size += size;
+
+   return PUD_TRUE;
+}
+
+PUDAPI War2_Image_Encoder *
+war2_image_encoder_new(War2_Image_Format      format,
+                       unsigned int           w,
+                       unsigned int           h,
+                       War2_Image_Write_Func  func,
+                       void                  *data)
+{
+   War2_Image_Encoder *enc;
+
+   if (!func) DIE_RETURN(NULL, "NULL write function");
+   if ((w == 0) || (h == 0))
+     DIE_RETURN(NULL, "Invalid image size %ux%u", w, h);
+
+   switch (format)
+     {
+      case WAR2_IMAGE_FORMAT_PNG:
+#if ! HAVE_PNG
+         DIE_RETURN(NULL, "PNG support is not available");
+#endif
+         break;
+
+      case WAR2_IMAGE_FORMAT_JPEG:
+#if ! HAVE_JPEG
+         DIE_RETURN(NULL, "JPEG support is not available");
+#endif
+         break;
+
+      case WAR2_IMAGE_FORMAT_PPM:
+      case WAR2_IMAGE_FORMAT_QOI:
+         break;
+
+      default:
+         DIE_RETURN(NULL, "Invalid image format %i", format);
+     }
+
+   enc = calloc(1, sizeof(War2_Image_Encoder));
+   if (!enc) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   enc->format = format;
+   enc->w = w;
+   enc->h = h;
+   enc->func = func;
+   enc->data = data;
+   enc->fd = -1;
+   enc->jpeg_quality = 100;
+
+   return enc;
+}
+
+PUDAPI War2_Image_Encoder *
+war2_image_encoder_fd_new(War2_Image_Format format,
+                          unsigned int      w,
+                          unsigned int      h,
+                          int               fd)
+{
+   War2_Image_Encoder *enc;
+
+   if (fd < 0) DIE_RETURN(NULL, "Invalid file descriptor %i", fd);
+
+   enc = war2_image_encoder_new(format, w, h, _fd_write, NULL);
+   if (!enc) return NULL;
+   enc->data = enc;
+   enc->fd = fd;
+
+   return enc;
+}
+
+PUDAPI War2_Image_Encoder *
+war2_image_encoder_buffer_new(War2_Image_Format format,
+                              unsigned int      w,
+                              unsigned int      h)
+{
+   War2_Image_Encoder *enc;
+
+   enc = war2_image_encoder_new(format, w, h, _buffer_write, NULL);
+   if (!enc) return NULL;
+   enc->data = enc;
+   enc->buffered = PUD_TRUE;
+
+   return enc;
+}
+
+PUDAPI Pud_Bool
+war2_image_encoder_png_options_set(War2_Image_Encoder     *enc,
+                                   const War2_Png_Options *opts)
+{
+   if (enc->format != WAR2_IMAGE_FORMAT_PNG)
+     DIE_RETURN(PUD_FALSE, "The encoder does not write PNG images");
+   if (enc->started)
+     DIE_RETURN(PUD_FALSE, "Options must be set before writing rows");
+
+   if (opts) enc->png_opts = *opts;
+   enc->png_opts_set = (opts) ? PUD_TRUE : PUD_FALSE;
+
+   return PUD_TRUE;
+}
+
+PUDAPI Pud_Bool
+war2_image_encoder_jpeg_quality_set(War2_Image_Encoder *enc,
+                                    int                 quality)
+{
+   if (enc->format != WAR2_IMAGE_FORMAT_JPEG)
+     DIE_RETURN(PUD_FALSE, "The encoder does not write JPEG images");
+   if (enc->started)
+     DIE_RETURN(PUD_FALSE, "Quality must be set before writing rows");
+   if ((quality < 1) || (quality > 100))
+     DIE_RETURN(PUD_FALSE, "Invalid quality %i", quality);
+
+   enc->jpeg_quality = quality;
+
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_encoder_start(War2_Image_Encoder *enc)
+{
+   char header[64];
+   int len;
+
+   enc->started = PUD_TRUE;
+   switch (enc->format)
+     {
+      case WAR2_IMAGE_FORMAT_PNG:
+         enc->png = war2_png_stream_func_new(enc->func, enc->data, enc->w, enc->h,
+                                             (enc->png_opts_set) ? &(enc->png_opts) : NULL);
+         return (enc->png) ? PUD_TRUE : PUD_FALSE;
+
+      case WAR2_IMAGE_FORMAT_JPEG:
+         enc->jpeg = war2_jpeg_stream_new(enc->func, enc->data, enc->w, enc->h,
+                                          enc->jpeg_quality);
+         return (enc->jpeg) ? PUD_TRUE : PUD_FALSE;
+
+      case WAR2_IMAGE_FORMAT_PPM:
+         enc->rgb = malloc(enc->w * 3);
+         if (!enc->rgb) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+         len = snprintf(header, sizeof(header), "P6\n%u %u\n255\n", enc->w, enc->h);
+         return enc->func(enc->data, (const unsigned char *)header, len);
+
+      case WAR2_IMAGE_FORMAT_QOI:
+         enc->qoi = war2_qoi_stream_new(enc->func, enc->data, enc->w, enc->h);
+         return (enc->qoi) ? PUD_TRUE : PUD_FALSE;
+     }
+
+   return PUD_FALSE;
+}
+
+static Pud_Bool
+_ppm_rows_write(War2_Image_Encoder *enc,
+                const Pud_Color    *rows,
+                unsigned int        count)
+{
+   unsigned int i, x;
+   unsigned char *p;
+
+   for (i = 0; i < count; i++, rows += enc->w)
+     {
+        for (x = 0, p = enc->rgb; x < enc->w; x++, p += 3)
+          {
+             p[0] = rows[x].r;
+             p[1] = rows[x].g;
+             p[2] = rows[x].b;
+          }
+        if (!enc->func(enc->data, enc->rgb, enc->w * 3))
+          return PUD_FALSE;
+     }
+   return PUD_TRUE;
+}
+
+PUDAPI Pud_Bool
+war2_image_encoder_rows_write(War2_Image_Encoder *enc,
+                              const Pud_Color    *rows,
+                              unsigned int        count)
+{
+   Pud_Bool chk = PUD_FALSE;
+
+   if ((enc->failed) || (enc->finished)) return PUD_FALSE;
+   if (count > enc->h - enc->rows)
+     DIE_RETURN(PUD_FALSE, "Too many rows written (%u + %u > %u)",
+                enc->rows, count, enc->h);
+   if ((!enc->started) && (!_encoder_start(enc)))
+     goto fail;
+
+   switch (enc->format)
+     {
+      case WAR2_IMAGE_FORMAT_PNG:
+         chk = war2_png_stream_rows_write(enc->png, rows, count);
+         break;
+
+      case WAR2_IMAGE_FORMAT_JPEG:
+         chk = war2_jpeg_stream_rows_write(enc->jpeg, rows, count);
+         break;
+
+      case WAR2_IMAGE_FORMAT_PPM:
+         chk = _ppm_rows_write(enc, rows, count);
+         break;
+
+      case WAR2_IMAGE_FORMAT_QOI:
+         chk = war2_qoi_stream_rows_write(enc->qoi, rows, count);
+         break;
+     }
+   if (!chk) goto fail;
+   enc->rows += count;
+
+   return PUD_TRUE;
+
+fail:
+   enc->failed = PUD_TRUE;
+   return PUD_FALSE;
+}
+
+PUDAPI Pud_Bool
+war2_image_encoder_finish(War2_Image_Encoder *enc)
+{
+   Pud_Bool chk;
+
+   if ((enc->failed) || (enc->finished)) return PUD_FALSE;
+   enc->finished = PUD_TRUE;
+   if (enc->rows != enc->h)
+     DIE_GOTO(fail, "Image finished after %u rows out of %u", enc->rows, enc->h);
+
+   switch (enc->format)
+     {
+      case WAR2_IMAGE_FORMAT_PNG:
+         chk = war2_png_stream_close(enc->png);
+         enc->png = NULL;
+         if (!chk) goto fail;
+         break;
+
+      case WAR2_IMAGE_FORMAT_JPEG:
+         chk = war2_jpeg_stream_close(enc->jpeg);
+         enc->jpeg = NULL;
+         if (!chk) goto fail;
+         break;
+
+      case WAR2_IMAGE_FORMAT_QOI:
+         chk = war2_qoi_stream_close(enc->qoi);
+         enc->qoi = NULL;
+         if (!chk) goto fail;
+         break;
+
+      case WAR2_IMAGE_FORMAT_PPM:
+         break;
+     }
+
+   return PUD_TRUE;
+
+fail:
+   enc->failed = PUD_TRUE;
+   return PUD_FALSE;
+}
+
+PUDAPI const unsigned char *
+war2_image_encoder_buffer_get(const War2_Image_Encoder *enc,
+                              size_t                   *size)
+{
+   if (!enc->buffered)
+     DIE_RETURN(NULL, "The encoder does not write to memory");
+
+   *size = enc->buffer.size;
+   return enc->buffer.mem;
+}
+
+PUDAPI void
+war2_image_encoder_free(War2_Image_Encoder *enc)
+{
+   if (!enc) return;
+
+   /* Closing incomplete streams only releases them */
+   if (enc->png) war2_png_stream_close(enc->png);
+   if (enc->jpeg) war2_jpeg_stream_close(enc->jpeg);
+   if (enc->qoi) war2_qoi_stream_close(enc->qoi);
+   free(enc->rgb);
+   free(enc->buffer.mem);
+   free(enc);
+}
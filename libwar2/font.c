@@ -2,51 +2,97 @@
 
 #include "war2_private.h"
 
+// Fonts lie between entries 279 and 283 (included). By carefully
+// crafting the value of War2_Font, we can immediately
+// deduce the entry from the enumeration value of the font.
+#define FONT_ENTRY(Font) ((unsigned)(Font) + 279u)
+
+// Largest possible glyph, as dimensions are stored on 8 bits
+#define GLYPH_MAX_PIXELS (255 * 255)
+
+typedef struct
+{
+  unsigned char *mem;
+  size_t size;
+  uint8_t low_index;
+  uint8_t high_index;
+  size_t max_width;
+  size_t max_height;
+} Font;
+
+// Header of a glyph, NULL if the glyph has no pixels (e.g. a space)
+static const unsigned char *
+_font_glyph_get(const Font *font, unsigned int i)
+{
+  uint32_t pointer;
+  memcpy(&pointer, font->mem + 8 + (i * sizeof(uint32_t)), sizeof(uint32_t));
+  if ((pointer == 0) || (pointer > font->size - 4)) { return NULL; }
+  return font->mem + pointer;
+}
+
 static Pud_Bool
-_decode_glyph(const War2_Font_Decoder *const decoder, uint8_t glyph, const unsigned char *const mem, const Pud_Color *const palette)
+_font_open(War2_Data *w2, War2_Font font_to_open, Font *font)
 {
-  if (mem == NULL)
-  {
-    printf("Char 0x%x has no pixels\n", glyph);
-    decoder->glyph_empty(decoder->data, glyph);
-    return PUD_TRUE;
-  }
+  // Decode the entry. We expect a header of 8 bytes.
+  font->mem = war2_entry_extract(w2, FONT_ENTRY(font_to_open), &font->size);
+  if (! font->mem) { DIE_RETURN(PUD_FALSE, "Failed to extract font entry"); }
+  if (font->size < 8) { DIE_GOTO(fail, "Entry is too small"); }
 
-  const size_t width = (size_t)(mem[0]);
-  const size_t height = (size_t)(mem[1]);
-  const size_t x_offset = (size_t)(mem[2]);
-  const size_t y_offset = (size_t)(mem[3]);
+  // This is indeed a FONT entry if the first four bytes are "FONT"
+  uint32_t header;
+  memcpy(&header, font->mem, sizeof(uint32_t));
+  if (header != 0x544e4f46) /* "FONT" in ASCII */
+  { DIE_GOTO(fail, "Bad magic; expected \"FONT\""); }
 
-  const size_t nb_pixels = width * height;
-  const unsigned char *pixels = mem + 4;
+  // Remaining four bytes of the header:
+  // - low_index: lowest value contained in the font
+  // - high_index: highest value contained in the font
+  // - max width and height: maximum size of a glyph
+  //
+  // A "value" is probably a regular ASCII value... To handle non-english
+  // languages, not sure how it's done...
+  font->low_index = font->mem[4];
+  font->high_index = font->mem[5];
+  font->max_width = (size_t)(font->mem[6]);
+  font->max_height = (size_t)(font->mem[7]);
 
-  const Pud_Color empty_pixel = { .r = 0, .g = 0, .b = 0, .a = 0, };
+  if (font->low_index >= font->high_index)
+  { DIE_GOTO(fail, "Incoherent font header"); }
 
-  decoder->glyph_start(decoder->data, glyph, width, height, x_offset, y_offset);
-  printf("---------------------------------: w=%zu, h=%zu\n",width,height);
+  // The remaining is a contiguous list of 4-bytes pointers. One pointer
+  // per glyph. If a pointer is NULL, there are no data for the glyph
+  // (typically: a space).
+  const size_t nb_glyphs = font->high_index - font->low_index + 1u;
+  if (font->size < 8 + nb_glyphs * sizeof(uint32_t))
+  { DIE_GOTO(fail, "Entry is too small for %zu glyphs", nb_glyphs); }
+
+  return PUD_TRUE;
+fail:
+  free(font->mem);
+  return PUD_FALSE;
+}
 
+// Decode the pixels of a glyph into rows that are stride pixels apart.
+// Each byte skips (byte / 8) transparent pixels, then gives the color
+// of the next pixel.
+static Pud_Bool
+_glyph_pixels_decode(const unsigned char *pixels, const unsigned char *end, size_t width, size_t height, const Pud_Color *palette, Pud_Color *out, size_t stride)
+{
+  const Pud_Color empty_pixel = { .r = 0, .g = 0, .b = 0, .a = 0, };
+  const size_t nb_pixels = width * height;
   size_t decoded_pixels = 0;
-  size_t x = 0;
-  size_t y = 0;
+
   while (decoded_pixels < nb_pixels)
   {
-    uint8_t byte = *pixels;
-    while (byte >= 8)
+    if (pixels >= end) { DIE_RETURN(PUD_FALSE, "Glyph data is truncated"); }
+    uint8_t byte = *(pixels++);
+    while ((byte >= 8) && (decoded_pixels < nb_pixels))
     {
+      out[(decoded_pixels / width) * stride + (decoded_pixels % width)] = empty_pixel;
       decoded_pixels += 1;
       byte -= 8;
-      decoder->glyph_pixel(decoder->data, glyph, x, y, empty_pixel);
-      printf("_");
-      x += 1;
-      if (x >= width)
-      {
-        printf("\n");
-        x = 0;
-        y += 1;
-      }
-      if (decoded_pixels >= nb_pixels)
-      { goto done_decoding; }
     }
+    if (decoded_pixels >= nb_pixels) { break; }
 
     Pud_Color color = empty_pixel;
     switch (byte)
@@ -56,26 +102,10 @@ _decode_glyph(const War2_Font_Decoder *const decoder, uint8_t glyph, const unsig
       case 0x04: color = palette[0xc0]; break;
       case 0x05: color = palette[0x00]; break;
     }
+    out[(decoded_pixels / width) * stride + (decoded_pixels % width)] = color;
     decoded_pixels += 1;
-    decoder->glyph_pixel(decoder->data, glyph, x, y, color);
-    printf("%c", byte + '0');
-    x += 1;
-    if (x >= width)
-    {
-        printf("\n");
-      x = 0;
-      y += 1;
-    }
-    pixels++;
   }
 
-done_decoding:
-  printf("\n");
-
-  printf("--------------------------------- => %zu\n", decoded_pixels);
-  fflush(stdout);
-  decoder->glyph_end(decoder->data, glyph);
-
   return PUD_TRUE;
 }
 
@@ -87,67 +117,235 @@ war2_font_decode(
   const War2_Font_Decoder *decoder)
 {
   Pud_Bool status = PUD_FALSE;
+  Font font;
+  Pud_Color *img = NULL;
+
   if (! decoder) { DIE_GOTO(end, "decoder must not be NULL"); };
   if (! decoder->glyph_start) { DIE_GOTO(end, "decoder->glyph_start must not be NULL"); };
   if (! decoder->glyph_end) { DIE_GOTO(end, "decoder->glyph_end must not be NULL"); };
   if (! decoder->glyph_pixel) { DIE_GOTO(end, "decoder->glyph_pixel must not be NULL"); };
   if (! decoder->glyph_empty) { DIE_GOTO(end, "decoder->glyph_empty must not be NULL"); };
 
-  // Fonts lie between entries 279 and 283 (included). By carefully
-  // crafting the value of War2_Font, we can immediately
-  // deduce the entry from the enumeration value of the font.
-  const unsigned int entry = (unsigned)font_to_decode + 279u;
-
-  // Decode the entry. We expect a header of 8 bytes.
-  size_t entry_size;
-  unsigned char *const mem = war2_entry_extract(w2, entry, &entry_size);
-  if (entry_size < 8) { DIE_GOTO(end, "Entry is too small"); }
-
-  // This is indeed a FONT entry if the first four bytes are "FONT"
-  uint32_t header;
-  memcpy(&header, mem, sizeof(uint32_t));
-  if (header != 0x544e4f46) /* "FONT" in ASCII */
-  { DIE_GOTO(end_free, "Bad magic; expected \"FONT\""); }
-
-  // Remaining four bytes of the header:
-  // - low_index: lowest value contained in the font
-  // - high_index: highest value contained in the font
-  // - max width and height: maximum size of a glyph
-  //
-  // A "value" is probably a regular ASCII value... To handle non-english
-  // languages, not sure how it's done...
-  const uint8_t low_index = mem[4];
-  const uint8_t high_index = mem[5];
-  const size_t max_width = (size_t)(mem[6]);
-  const size_t max_height = (size_t)(mem[7]);
+  if (! _font_open(w2, font_to_decode, &font)) { goto end; }
 
-  if (low_index >= high_index)
-  { DIE_GOTO(end_free, "Incoherent font header"); }
+  img = malloc(GLYPH_MAX_PIXELS * sizeof(Pud_Color));
+  if (! img) { DIE_GOTO(end_free, "Failed to allocate memory"); }
 
   // We can use any color palette to decode fonts. Let's use the first one.
   const Pud_Color *const palette = w2->forest;
+  const unsigned int nb_glyphs = font.high_index - font.low_index + 1u;
 
-  // The remaining is a contiguous list of 4-bytes pointers. One pointer
-  // per glyph. If a pointer is NULL, there are no data for the glyph
-  // (typically: a space).
-  const uint8_t nb_glyphs = high_index - low_index + 1;
-
-  if (decoder->start) { decoder->start(decoder->data, nb_glyphs, max_width, max_height); }
+  if (decoder->start) { decoder->start(decoder->data, nb_glyphs, font.max_width, font.max_height); }
 
-  for (uint8_t i = 0; i < nb_glyphs; i++)
+  for (unsigned int i = 0; i < nb_glyphs; i++)
   {
-    uint32_t pointer;
-    const uint8_t value = low_index + i;
-    const uint8_t *ptr = mem + 8 + (i * sizeof(uint32_t));
-    memcpy(&pointer, ptr, sizeof(uint32_t));
-    _decode_glyph(decoder, value, (pointer == 0) ? NULL : (mem + pointer), palette);
+    const uint8_t value = font.low_index + i;
+    const unsigned char *const mem = _font_glyph_get(&font, i);
+    if (mem == NULL)
+    {
+      decoder->glyph_empty(decoder->data, value);
+      continue;
+    }
+
+    const size_t width = (size_t)(mem[0]);
+    const size_t height = (size_t)(mem[1]);
+    if (! _glyph_pixels_decode(mem + 4, font.mem + font.size, width, height, palette, img, width))
+    { goto end_free; }
+
+    decoder->glyph_start(decoder->data, value, width, height, (size_t)(mem[2]), (size_t)(mem[3]));
+    for (size_t k = 0; k < width * height; k++)
+    { decoder->glyph_pixel(decoder->data, value, k % width, k / width, img[k]); }
+    decoder->glyph_end(decoder->data, value);
   }
 
   if (decoder->end) { decoder->end(decoder->data); }
 
   status = PUD_TRUE;
 end_free:
-  free(mem);
+  free(img);
+  free(font.mem);
 end:
   return status;
 }
+
+PUDAPI War2_Font_Atlas *
+war2_font_atlas_new(
+  War2_Data *w2,
+  War2_Font font_to_decode)
+{
+  War2_Font_Atlas *atlas = NULL;
+  Font font;
+
+  if (! w2) { DIE_RETURN(NULL, "NULL data"); }
+  if (! _font_open(w2, font_to_decode, &font)) { return NULL; }
+
+  atlas = calloc(1, sizeof(War2_Font_Atlas));
+  if (! atlas) { DIE_GOTO(fail, "Failed to allocate memory"); }
+  atlas->font = font_to_decode;
+  atlas->line_height = font.max_height;
+
+  // Glyphs are stored in cells large enough for any of them, laid out
+  // WAR2_FONT_ATLAS_COLUMNS per row
+  const unsigned int nb_glyphs = font.high_index - font.low_index + 1u;
+  unsigned int cell_w = 1, cell_h = 1;
+  for (unsigned int i = 0; i < nb_glyphs; i++)
+  {
+    const unsigned char *const mem = _font_glyph_get(&font, i);
+    if (! mem) { continue; }
+    if (mem[0] > cell_w) { cell_w = mem[0]; }
+    if (mem[1] > cell_h) { cell_h = mem[1]; }
+  }
+  atlas->w = cell_w * WAR2_FONT_ATLAS_COLUMNS;
+  atlas->h = cell_h * ((nb_glyphs + WAR2_FONT_ATLAS_COLUMNS - 1) / WAR2_FONT_ATLAS_COLUMNS);
+  atlas->rgba = calloc(atlas->w * atlas->h, sizeof(Pud_Color));
+  if (! atlas->rgba) { DIE_GOTO(fail, "Failed to allocate memory"); }
+
+  for (unsigned int i = 0; i < nb_glyphs; i++)
+  {
+    War2_Font_Glyph *const g = &(atlas->glyphs[font.low_index + i]);
+    const unsigned char *const mem = _font_glyph_get(&font, i);
+    if (mem == NULL)
+    {
+      // Glyphs without pixels are blanks
+      g->advance = (font.max_width + 1) / 2;
+      continue;
+    }
+
+    g->x = (i % WAR2_FONT_ATLAS_COLUMNS) * cell_w;
+    g->y = (i / WAR2_FONT_ATLAS_COLUMNS) * cell_h;
+    g->w = mem[0];
+    g->h = mem[1];
+    g->x_offset = mem[2];
+    g->y_offset = mem[3];
+    g->advance = g->x_offset + g->w + 1;
+    if (! _glyph_pixels_decode(mem + 4, font.mem + font.size, g->w, g->h, w2->forest,
+                               &(atlas->rgba[g->y * atlas->w + g->x]), atlas->w))
+    { goto fail; }
+  }
+
+  free(font.mem);
+  return atlas;
+
+fail:
+  war2_font_atlas_free(atlas);
+  free(font.mem);
+  return NULL;
+}
+
+PUDAPI void
+war2_font_atlas_free(War2_Font_Atlas *atlas)
+{
+  if (! atlas) { return; }
+  free(atlas->rgba);
+  free(atlas);
+}
+
+// Next character of a string. Valid UTF-8 sequences give their code
+// point, other bytes are taken as Latin-1 characters.
+static uint32_t
+_text_char_next(const unsigned char **str)
+{
+  const unsigned char *const s = *str;
+  unsigned int len, i;
+  uint32_t cp;
+
+  if (s[0] < 0x80) { len = 1; cp = s[0]; }
+  else if ((s[0] & 0xe0) == 0xc0) { len = 2; cp = s[0] & 0x1f; }
+  else if ((s[0] & 0xf0) == 0xe0) { len = 3; cp = s[0] & 0x0f; }
+  else if ((s[0] & 0xf8) == 0xf0) { len = 4; cp = s[0] & 0x07; }
+  else { len = 0; cp = 0; }
+
+  for (i = 1; i < len; i++)
+  {
+    if ((s[i] & 0xc0) != 0x80) { len = 0; break; }
+    cp = (cp << 6) | (s[i] & 0x3f);
+  }
+  if (len == 0)
+  {
+    *str = s + 1;
+    return s[0];
+  }
+
+  *str = s + len;
+  return cp;
+}
+
+PUDAPI Pud_Bool
+war2_text_size_get(
+  const War2_Font_Atlas *atlas,
+  const char *text,
+  unsigned int *w,
+  unsigned int *h)
+{
+  if ((! atlas) || (! text)) { DIE_RETURN(PUD_FALSE, "Invalid NULL parameter"); }
+
+  const unsigned char *s = (const unsigned char *)text;
+  unsigned int line_w = 0, max_w = 0, lines = 1;
+  while (*s)
+  {
+    const uint32_t c = _text_char_next(&s);
+    if (c == '\n')
+    {
+      lines++;
+      line_w = 0;
+    }
+    else if (c < 256)
+    {
+      line_w += atlas->glyphs[c].advance;
+      if (line_w > max_w) { max_w = line_w; }
+    }
+  }
+
+  if (w) { *w = max_w; }
+  if (h) { *h = lines * atlas->line_height; }
+  return PUD_TRUE;
+}
+
+PUDAPI Pud_Bool
+war2_text_render(
+  const War2_Font_Atlas *atlas,
+  const char *text,
+  Pud_Color *img,
+  unsigned int img_w,
+  unsigned int img_h,
+  int x,
+  int y)
+{
+  if ((! atlas) || (! text) || (! img)) { DIE_RETURN(PUD_FALSE, "Invalid NULL parameter"); }
+
+  const unsigned char *s = (const unsigned char *)text;
+  int pen_x = x, pen_y = y;
+  while (*s)
+  {
+    const uint32_t c = _text_char_next(&s);
+    if (c == '\n')
+    {
+      pen_x = x;
+      pen_y += (int)atlas->line_height;
+      continue;
+    }
+    if (c >= 256) { continue; }
+
+    // Glyphs are blitted row by row, clipped to the image. Transparent
+    // pixels of the glyph leave the image untouched.
+    const War2_Font_Glyph *const g = &(atlas->glyphs[c]);
+    const int gx = pen_x + (int)g->x_offset;
+    const int gy = pen_y + (int)g->y_offset;
+    const int x0 = (gx < 0) ? -gx : 0;
+    const int y0 = (gy < 0) ? -gy : 0;
+    const int x1 = ((long)gx + g->w > (long)img_w) ? (int)img_w - gx : (int)g->w;
+    const int y1 = ((long)gy + g->h > (long)img_h) ? (int)img_h - gy : (int)g->h;
+    for (int row = y0; (row < y1) && (x0 < x1); row++)
+    {
+      const Pud_Color *const src = &(atlas->rgba[(g->y + row) * atlas->w + g->x + x0]);
+      Pud_Color *const dst = &(img[(size_t)(gy + row) * img_w + gx + x0]);
+      for (int col = 0; col < x1 - x0; col++)
+      {
+        if (src[col].a >= 0x80) { dst[col] = src[col]; }
+      }
+    }
+    pen_x += (int)g->advance;
+  }
+
+  return PUD_TRUE;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+/*
+ * Icons of an era are decoded once, with the colors of the red player,
+ * in a single sheet. Frames are stored one after the other, so icon i
+ * is a plain index in the icons array.
+ */
+struct _War2_Icons
+{
+   unsigned int   count;
+   War2_Icon     *icons;
+   Pud_Color     *rgba;
+   unsigned char *indexes;
+   size_t         pixels; /* Pixels used in rgba and indexes */
+   size_t         alloc; /* Pixels allocated in rgba and indexes */
+   Pud_Bool       failed;
+};
+
+static Pud_Bool
+_icons_reserve(War2_Icons   *icons,
+               unsigned int  frame,
+               size_t        pixels)
+{
+   War2_Icon *frames;
+   Pud_Color *rgba;
+   unsigned char *indexes;
+   size_t alloc;
+
+   if (frame >= icons->count)
+     {
+        frames = realloc(icons->icons, (frame + 1) * sizeof(War2_Icon));
+        if (!frames) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        memset(&(frames[icons->count]), 0,
+               (frame + 1 - icons->count) * sizeof(War2_Icon));
+        icons->icons = frames;
+        icons->count = frame + 1;
+     }
+
+   if (icons->pixels + pixels > icons->alloc)
+     {
+        alloc = (icons->alloc) ? icons->alloc * 2 : 64 * 1024;
+        while (icons->pixels + pixels > alloc)
+          alloc *= 2;
+
+        rgba = realloc(icons->rgba, alloc * sizeof(Pud_Color));
+        if (!rgba) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        icons->rgba = rgba;
+        indexes = realloc(icons->indexes, alloc);
+        if (!indexes) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        icons->indexes = indexes;
+        icons->alloc = alloc;
+     }
+
+   return PUD_TRUE;
+}
+
+static void
+_icons_frame_cb(void                          *data,
+                const Pud_Color               *img,
+                int                            x,
+                int                            y,
+                unsigned int                   w,
+                unsigned int                   h,
+                const War2_Sprites_Descriptor *ud,
+                uint16_t                       img_nb)
+{
+   War2_Icons *const icons = data;
+   War2_Icon *icon;
+   const size_t pixels = (size_t)w * h;
+
+   if (icons->failed) return;
+   if (!_icons_reserve(icons, img_nb, pixels))
+     {
+        icons->failed = PUD_TRUE;
+        return;
+     }
+
+   /* Pixels are referenced once the sheet is complete, as it may be
+    * moved when growing */
+   icon = &(icons->icons[img_nb]);
+   icon->x = x;
+   icon->y = y;
+   icon->w = w;
+   icon->h = h;
+
+   memcpy(&(icons->rgba[icons->pixels]), img, pixels * sizeof(Pud_Color));
+   memcpy(&(icons->indexes[icons->pixels]), ud->indexes, pixels);
+   icons->pixels += pixels;
+}
+
+static War2_Icons *
+_icons_new(War2_Data *w2,
+           Pud_Era    era)
+{
+   War2_Icons *icons;
+   War2_Icon *icon;
+   unsigned int i;
+   size_t offset = 0;
+
+   icons = calloc(1, sizeof(*icons));
+   if (!icons) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   if ((!war2_sprites_decode(w2, PUD_PLAYER_RED, era, WAR2_SPRITES_ICONS,
+                             _icons_frame_cb, icons)) ||
+       (icons->failed))
+     DIE_GOTO(fail, "Failed to decode the icons of era %s",
+              pud_era_to_string(era));
+
+   /* Frames are decoded in order, so they are stored in order */
+   for (i = 0; i < icons->count; i++)
+     {
+        icon = &(icons->icons[i]);
+        if (icon->w == 0) continue;
+        icon->pixels = &(icons->rgba[offset]);
+        icon->indexes = &(icons->indexes[offset]);
+        offset += (size_t)icon->w * icon->h;
+     }
+   return icons;
+
+fail:
+   war2_icons_free(icons);
+   return NULL;
+}
+
+PUDAPI_INTERNAL void
+war2_icons_free(War2_Icons *icons)
+{
+   if (!icons) return;
+   free(icons->icons);
+   free(icons->rgba);
+   free(icons->indexes);
+   free(icons);
+}
+
+PUDAPI const War2_Icon *
+war2_icon_get(War2_Data *w2,
+              Pud_Era    era,
+              Pud_Icon   icon)
+{
+   War2_Icons *icons;
+
+   if (!w2) DIE_RETURN(NULL, "NULL data");
+   if ((unsigned int)era > PUD_ERA_SWAMP)
+     DIE_RETURN(NULL, "Invalid era %i", era);
+
+   /* The sheet is decoded once per era and kept until war2_close() */
+   WAR2_LOCK(w2);
+   if ((!w2->icons[era]) && (!w2->icons_failed[era]))
+     {
+        w2->icons[era] = _icons_new(w2, era);
+        w2->icons_failed[era] = !w2->icons[era];
+     }
+   icons = w2->icons[era];
+   WAR2_UNLOCK(w2);
+   if (!icons) return NULL;
+
+   if (((unsigned int)icon >= icons->count) || (icons->icons[icon].w == 0))
+     return NULL;
+   return &(icons->icons[icon]);
+}
@@ -27,74 +27,198 @@
 # include <jpeglib.h>
 #endif
 
-PUDAPI Pud_Bool
-war2_jpeg_write(const char          *file,
-                unsigned int         w,
-                unsigned int         h,
-                const unsigned char *data)
+/* Size of the chunks of compressed data given to the output */
+#define JPEG_OUTPUT_SIZE (16 * 1024)
+
+struct _War2_Jpeg_Stream
 {
 #if HAVE_JPEG
    struct jpeg_compress_struct cinfo;
-   struct jpeg_error_mgr jerr;
-   JSAMPROW row_pointer[1];
-   int row_stride;
-   FILE *f;
-   unsigned char *data_rgb;
-   int i, k, size;
-   const JSAMPLE *p;
+   struct jpeg_error_mgr       jerr;
+   struct jpeg_destination_mgr dest;
+   JOCTET                      out[JPEG_OUTPUT_SIZE];
+#endif
+   War2_Image_Write_Func  func;
+   void                  *data;
+   unsigned char         *rgb; /* One row, without alpha */
+   unsigned int           w;
+   unsigned int           h;
+   unsigned int           rows;
+   Pud_Bool               failed; /* The output could not be written */
+};
 
-   data_rgb = malloc(sizeof(unsigned char) * 3 * w * h);
-   if (!data_rgb) DIE_RETURN(PUD_FALSE, "Failed to allocate rgb buffer");
+#if HAVE_JPEG
+static void
+_dest_init(j_compress_ptr cinfo)
+{
+   War2_Jpeg_Stream *const s = cinfo->client_data;
 
-   /* data is RGBA. JPEG does not like alpha */
-   size = w * h * 4;
-   for (i = 0, k = 0; i < size; i += 4, k += 3)
-     {
-        data_rgb[k + 0] = data[i + 0];
-        data_rgb[k + 1] = data[i + 1];
-        data_rgb[k + 2] = data[i + 2];
-     }
-   p = data_rgb;
+   s->dest.next_output_byte = s->out;
+   s->dest.free_in_buffer = JPEG_OUTPUT_SIZE;
+}
 
-   f = fopen(file, "wb");
-   if (!f)
-     {
-        free(data_rgb);
-        DIE_RETURN(PUD_FALSE, "Failed to open file [%s]", file);
-     }
+static boolean
+_dest_empty(j_compress_ptr cinfo)
+{
+   War2_Jpeg_Stream *const s = cinfo->client_data;
+
+   /* libjpeg wants the whole buffer to be emptied */
+   if ((!s->failed) && (!s->func(s->data, s->out, JPEG_OUTPUT_SIZE)))
+     s->failed = PUD_TRUE;
+   _dest_init(cinfo);
+   return TRUE;
+}
 
-   cinfo.err = jpeg_std_error(&jerr);
-   jpeg_create_compress(&cinfo);
-   jpeg_stdio_dest(&cinfo, f);
+static void
+_dest_term(j_compress_ptr cinfo)
+{
+   War2_Jpeg_Stream *const s = cinfo->client_data;
+   const size_t size = JPEG_OUTPUT_SIZE - s->dest.free_in_buffer;
 
-   cinfo.image_width = w;
-   cinfo.image_height = h;
-   cinfo.input_components = 3;
-   cinfo.in_color_space = JCS_RGB;
+   if ((!s->failed) && (size > 0) && (!s->func(s->data, s->out, size)))
+     s->failed = PUD_TRUE;
+}
+#endif
 
-   row_stride = w * 3;
+PUDAPI_INTERNAL War2_Jpeg_Stream *
+war2_jpeg_stream_new(War2_Image_Write_Func  func,
+                     void                  *data,
+                     unsigned int           w,
+                     unsigned int           h,
+                     int                    quality)
+{
+#if HAVE_JPEG
+   War2_Jpeg_Stream *s;
 
-   jpeg_set_defaults(&cinfo);
-   jpeg_set_quality(&cinfo, 100, TRUE);
-   jpeg_start_compress(&cinfo, TRUE);
+   if ((quality < 1) || (quality > 100))
+     DIE_RETURN(NULL, "Invalid quality %i", quality);
 
-   while (cinfo.next_scanline < cinfo.image_height)
+   s = calloc(1, sizeof(War2_Jpeg_Stream));
+   if (!s) DIE_RETURN(NULL, "Failed to allocate memory");
+   s->rgb = malloc(w * 3);
+   if (!s->rgb)
      {
-        row_pointer[0] = (JSAMPROW)(&p[cinfo.next_scanline * row_stride]);
-        jpeg_write_scanlines(&cinfo, row_pointer, 1);
+        free(s);
+        DIE_RETURN(NULL, "Failed to allocate memory");
      }
+   s->func = func;
+   s->data = data;
+   s->w = w;
+   s->h = h;
 
-   jpeg_finish_compress(&cinfo);
-   fclose(f);
-   jpeg_destroy_compress(&cinfo);
-   free(data_rgb);
+   s->cinfo.err = jpeg_std_error(&(s->jerr));
+   jpeg_create_compress(&(s->cinfo));
+   s->cinfo.client_data = s;
+   s->dest.init_destination = _dest_init;
+   s->dest.empty_output_buffer = _dest_empty;
+   s->dest.term_destination = _dest_term;
+   s->cinfo.dest = &(s->dest);
 
-   return PUD_TRUE;
+   s->cinfo.image_width = w;
+   s->cinfo.image_height = h;
+   s->cinfo.input_components = 3;
+   s->cinfo.in_color_space = JCS_RGB;
+
+   jpeg_set_defaults(&(s->cinfo));
+   jpeg_set_quality(&(s->cinfo), quality, TRUE);
+   jpeg_start_compress(&(s->cinfo), TRUE);
+
+   return s;
 #else
-   (void) file;
+   (void) func;
+   (void) data;
    (void) w;
    (void) h;
-   (void) data;
+   (void) quality;
+   DIE_RETURN(NULL, "JPEG support is not available");
+#endif
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_jpeg_stream_rows_write(War2_Jpeg_Stream *s,
+                            const Pud_Color  *rows,
+                            unsigned int      count)
+{
+#if HAVE_JPEG
+   JSAMPROW row_pointer[1];
+   const Pud_Color *c;
+   unsigned int i, x;
+
+   if (count > s->h - s->rows)
+     DIE_RETURN(PUD_FALSE, "Too many rows written (%u + %u > %u)",
+                s->rows, count, s->h);
+   if (s->failed) return PUD_FALSE;
+
+   /* JPEG does not like alpha */
+   row_pointer[0] = s->rgb;
+   for (i = 0; i < count; i++)
+     {
+        c = &(rows[i * s->w]);
+        for (x = 0; x < s->w; x++)
+          {
+             s->rgb[x * 3 + 0] = c[x].r;
+             s->rgb[x * 3 + 1] = c[x].g;
+             s->rgb[x * 3 + 2] = c[x].b;
+          }
+        jpeg_write_scanlines(&(s->cinfo), row_pointer, 1);
+     }
+   s->rows += count;
+
+   return (s->failed) ? PUD_FALSE : PUD_TRUE;
+#else
+   (void) s;
+   (void) rows;
+   (void) count;
    return PUD_FALSE;
 #endif
 }
+
+PUDAPI_INTERNAL Pud_Bool
+war2_jpeg_stream_close(War2_Jpeg_Stream *s)
+{
+   Pud_Bool ret = PUD_FALSE;
+
+   if (!s) return PUD_FALSE;
+
+#if HAVE_JPEG
+   /* libjpeg cannot finish an incomplete image */
+   if (s->rows == s->h)
+     {
+        jpeg_finish_compress(&(s->cinfo));
+        ret = (s->failed) ? PUD_FALSE : PUD_TRUE;
+     }
+   else
+     ERR("JPEG stream closed after %u rows out of %u", s->rows, s->h);
+   jpeg_destroy_compress(&(s->cinfo));
+#endif
+   free(s->rgb);
+   free(s);
+
+   return ret;
+}
+
+PUDAPI Pud_Bool
+war2_jpeg_write(const char          *file,
+                unsigned int         w,
+                unsigned int         h,
+                const unsigned char *data)
+{
+   War2_Jpeg_Stream *s;
+   Pud_Bool ret;
+   FILE *f;
+
+   f = fopen(file, "wb");
+   if (!f) DIE_RETURN(PUD_FALSE, "Failed to open file [%s]", file);
+
+   s = war2_jpeg_stream_new(war2_image_file_write, f, w, h, 100);
+   if (!s)
+     {
+        fclose(f);
+        return PUD_FALSE;
+     }
+   war2_jpeg_stream_rows_write(s, (const Pud_Color *)data, h);
+   ret = war2_jpeg_stream_close(s);
+   if (fclose(f) != 0) ret = PUD_FALSE;
+
+   return ret;
+}
@@ -0,0 +1,715 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+/* Bands are one row of tiles high. Several bands are rendered in
+ * parallel, then given to the user in order */
+#define MAP_BAND_H       32
+#define MAP_WAVE_BANDS   16
+#define MAP_SPRITE_TYPES 256
+#define MAP_PLAYERS      8
+
+typedef struct
+{
+   Pud_Color    *pixels; /* NULL if the unit has no sprite */
+   int           x; /* Offset from the top-left pixel of the unit cell */
+   int           y;
+   unsigned int  w;
+   unsigned int  h;
+   unsigned int  wanted; /* Frame to be kept */
+   unsigned int  size; /* Size of the unit, in cells */
+   Pud_Bool      decoded;
+} Map_Sprite;
+
+typedef struct
+{
+   const Map_Sprite *sprite;
+   int               x; /* Position of the sprite on the map, in pixels */
+   int               y;
+   unsigned int      cx; /* Cell of the unit */
+   unsigned int      cy;
+   uint64_t          key; /* Drawing order */
+} Map_Unit;
+
+/*
+ * Everything needed to render any area of a map. The tileset entries are
+ * owned by their own decoder, as decoding sprites would overwrite them.
+ */
+typedef struct
+{
+   War2_Data          *w2;
+   const Pud          *pud;
+   War2_Decoder       *ts_dec;
+   War2_Decoder       *dec;
+   War2_Tileset_Data   tsd;
+   Map_Sprite         *sprites; /* [type][player] */
+   Map_Unit           *units;
+   unsigned int        units_count;
+   unsigned int        units_alloc;
+   unsigned int        map_w; /* In cells */
+   unsigned int        map_h;
+   unsigned int        w; /* In pixels */
+   unsigned int        h;
+
+   Pud_Color          *pixels; /* Destination of the parallel rendering */
+   unsigned int        first_row;
+} Map_Render;
+
+struct _War2_Map_Renderer
+{
+   Map_Render     mr;
+   unsigned char *dirty; /* One byte per cell */
+   unsigned char *changed; /* Cells reported to the current update */
+   Map_Unit      *added; /* Units that occupy a changed cell */
+   unsigned int   added_alloc;
+
+   /* Bounding box of the dirty cells, [x0 ; x1[ x [y0 ; y1[ */
+   unsigned int   x0;
+   unsigned int   y0;
+   unsigned int   x1;
+   unsigned int   y1;
+};
+
+static void
+_sprite_frame_cb(void                          *data,
+                 const Pud_Color               *img,
+                 int                            x,
+                 int                            y,
+                 unsigned int                   w,
+                 unsigned int                   h,
+                 const War2_Sprites_Descriptor *ud,
+                 uint16_t                       img_nb)
+{
+   Map_Sprite *const sprite = data;
+   Pud_Color *pixels;
+
+   /* The first frame is kept until the wanted one shows up */
+   if ((img_nb != 0) && (img_nb != sprite->wanted)) return;
+   if ((w == 0) || (h == 0)) return;
+
+   pixels = realloc(sprite->pixels, w * h * sizeof(Pud_Color));
+   if (!pixels)
+     {
+        ERR("Failed to allocate memory");
+        return;
+     }
+   memcpy(pixels, img, w * h * sizeof(Pud_Color));
+
+   /* Frames are centered on the cells occupied by the unit */
+   sprite->pixels = pixels;
+   sprite->x = x + (((int)sprite->size * 32) - (int)ud->max_w) / 2;
+   sprite->y = y + (((int)sprite->size * 32) - (int)ud->max_h) / 2;
+   sprite->w = w;
+   sprite->h = h;
+}
+
+static const Map_Sprite *
+_sprite_get(Map_Render   *mr,
+            Pud_Unit      type,
+            unsigned int  player)
+{
+   Map_Sprite *sprite;
+   Pud_Player color;
+
+   /* Neutral units have no player color */
+   color = (player < MAP_PLAYERS) ? player : PUD_PLAYER_RED;
+   sprite = &(mr->sprites[(type * MAP_PLAYERS) + color]);
+   if (sprite->decoded) return sprite;
+   sprite->decoded = PUD_TRUE;
+
+   if (!pud_unit_valid_is(type)) return sprite;
+
+   /* Units are drawn facing south (5th frame), buildings are drawn
+    * finished (1st frame) */
+   sprite->size = pud_unit_size_get(type);
+   sprite->wanted = pud_unit_building_is(type) ? 0 : 4;
+   if (!war2_decoder_sprites_decode(mr->w2, mr->dec, color, mr->pud->era, type,
+                                    _sprite_frame_cb, sprite))
+     ERR("Failed to decode sprites of unit 0x%x", type);
+
+   return sprite;
+}
+
+static int
+_unit_cmp(const void *a,
+          const void *b)
+{
+   const Map_Unit *const ua = a, *const ub = b;
+
+   if (ua->key < ub->key) return -1;
+   if (ua->key > ub->key) return 1;
+   return 0;
+}
+
+/*
+ * Fill the drawing information of the unit at index i of the Pud.
+ * Returns PUD_FALSE if the unit is not drawn.
+ */
+static Pud_Bool
+_unit_init(Map_Render   *mr,
+           Map_Unit     *unit,
+           unsigned int  i)
+{
+   const Pud_Unit_Info *const info = &(mr->pud->units[i]);
+   unsigned int layer;
+
+   unit->sprite = _sprite_get(mr, info->type, info->player);
+   if (!unit->sprite->pixels) return PUD_FALSE;
+
+   unit->cx = info->x;
+   unit->cy = info->y;
+   unit->x = (info->x * 32) + unit->sprite->x;
+   unit->y = (info->y * 32) + unit->sprite->y;
+
+   /* Buildings first, then ground and sea units, then flying units.
+    * Within a layer, what is lower on the map is drawn last. The
+    * original order breaks ties, so rendering is deterministic. */
+   if (pud_unit_flying_is(info->type)) layer = 2;
+   else if (pud_unit_building_is(info->type)) layer = 0;
+   else layer = 1;
+   unit->key = ((uint64_t)layer << 48) | ((uint64_t)info->y << 32) |
+      ((uint64_t)info->x << 16) | (i & 0xffff);
+
+   return PUD_TRUE;
+}
+
+/* Build the list of the units to be drawn, in drawing order */
+static Pud_Bool
+_units_prepare(Map_Render *mr)
+{
+   const Pud *const pud = mr->pud;
+   unsigned int i;
+
+   mr->units_alloc = pud->units_count + 1;
+   mr->units = malloc(mr->units_alloc * sizeof(Map_Unit));
+   if (!mr->units) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   mr->units_count = 0;
+
+   for (i = 0; i < pud->units_count; i++)
+     {
+        if (_unit_init(mr, &(mr->units[mr->units_count]), i))
+          mr->units_count++;
+     }
+
+   qsort(mr->units, mr->units_count, sizeof(Map_Unit), _unit_cmp);
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_map_render_init(Map_Render *mr,
+                 War2_Data  *w2,
+                 const Pud  *pud)
+{
+   memset(mr, 0, sizeof(*mr));
+
+   if ((!w2) || (!pud))
+     DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+   if ((pud->map_w == 0) || (pud->map_h == 0) || (!pud->tiles_map))
+     DIE_RETURN(PUD_FALSE, "Pud has no map");
+
+   mr->w2 = w2;
+   mr->pud = pud;
+   mr->map_w = pud->map_w;
+   mr->map_h = pud->map_h;
+   mr->w = pud->map_w * 32;
+   mr->h = pud->map_h * 32;
+
+   mr->ts_dec = war2_decoder_new();
+   mr->dec = war2_decoder_new();
+   if ((!mr->ts_dec) || (!mr->dec))
+     DIE_RETURN(PUD_FALSE, "Failed to create decoders");
+   mr->sprites = calloc(MAP_SPRITE_TYPES * MAP_PLAYERS, sizeof(Map_Sprite));
+   if (!mr->sprites) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+
+   /* Everything that is shared by the rendered areas is decoded upfront:
+    * areas can then be rendered concurrently without locking */
+   if (!war2_tileset_data_get(w2, mr->ts_dec, pud->era, &(mr->tsd)))
+     DIE_RETURN(PUD_FALSE, "Failed to get the tileset of the map");
+   if (!_units_prepare(mr))
+     DIE_RETURN(PUD_FALSE, "Failed to prepare the units of the map");
+
+   return PUD_TRUE;
+}
+
+static void
+_map_render_clear(Map_Render *mr)
+{
+   unsigned int i;
+
+   if (mr->sprites)
+     {
+        for (i = 0; i < MAP_SPRITE_TYPES * MAP_PLAYERS; i++)
+          free(mr->sprites[i].pixels);
+     }
+   free(mr->sprites);
+   free(mr->units);
+   war2_decoder_free(mr->ts_dec);
+   war2_decoder_free(mr->dec);
+}
+
+/*
+ * Render the cells [cx0 ; cx1[ x [cy0 ; cy1[ in buf, which points to the
+ * top-left pixel of cell (cx0, cy0) and whose rows are stride pixels
+ * apart. Units are clipped to the area.
+ */
+static void
+_area_render(const Map_Render *mr,
+             Pud_Color        *buf,
+             unsigned int      stride,
+             unsigned int      cx0,
+             unsigned int      cy0,
+             unsigned int      cx1,
+             unsigned int      cy1)
+{
+   const Pud *const pud = mr->pud;
+   const unsigned char *words;
+   const Map_Unit *unit;
+   const Pud_Color *src;
+   Pud_Color *dst;
+   unsigned int tx, ty, i, x, row;
+   int px0, py0, px1, py1, y, y_end, sx, sx0, sx1;
+   const Pud_Color black = { 0, 0, 0, 0xff };
+
+   /* Terrain. Tiles that are not in the tileset are drawn black */
+   for (ty = cy0; ty < cy1; ty++)
+     for (tx = cx0; tx < cx1; tx++)
+       {
+          dst = &(buf[((ty - cy0) * 32 * stride) + ((tx - cx0) * 32)]);
+          words = war2_tileset_megatile_get(&(mr->tsd), pud->tiles_map[ty * pud->map_w + tx]);
+          if (words)
+            war2_minitiles_megatile_rgba(mr->tsd.minitiles, words, dst, stride);
+          else
+            {
+               for (row = 0; row < 32; row++)
+                 for (x = 0; x < 32; x++)
+                   dst[row * stride + x] = black;
+            }
+       }
+
+   /* Units, clipped to the area */
+   px0 = cx0 * 32;
+   py0 = cy0 * 32;
+   px1 = cx1 * 32;
+   py1 = cy1 * 32;
+   for (i = 0; i < mr->units_count; i++)
+     {
+        unit = &(mr->units[i]);
+        if ((unit->y >= py1) || (unit->y + (int)unit->sprite->h <= py0) ||
+            (unit->x >= px1) || (unit->x + (int)unit->sprite->w <= px0))
+          continue;
+
+        y = (unit->y < py0) ? py0 : unit->y;
+        y_end = unit->y + (int)unit->sprite->h;
+        if (y_end > py1) y_end = py1;
+        sx0 = (unit->x < px0) ? px0 - unit->x : 0;
+        sx1 = unit->sprite->w;
+        if (unit->x + sx1 > px1) sx1 = px1 - unit->x;
+
+        for (; y < y_end; y++)
+          {
+             src = &(unit->sprite->pixels[(y - unit->y) * unit->sprite->w]);
+             dst = &(buf[(y - py0) * stride]);
+             for (sx = sx0; sx < sx1; sx++)
+               if (src[sx].a != 0) dst[unit->x + sx - px0] = src[sx];
+          }
+     }
+}
+
+static void
+_rows_render(void         *data,
+             unsigned int  start,
+             unsigned int  end)
+{
+   const Map_Render *const mr = data;
+   unsigned int i;
+
+   for (i = start; i < end; i++)
+     _area_render(mr, &(mr->pixels[i * mr->w * MAP_BAND_H]), mr->w,
+                  0, mr->first_row + i, mr->map_w, mr->first_row + i + 1);
+}
+
+PUDAPI Pud_Bool
+war2_map_render(War2_Data            *w2,
+                const Pud            *pud,
+                War2_Map_Render_Func  func,
+                void                 *data)
+{
+   Map_Render mr;
+   unsigned int count, i;
+   Pud_Bool ret = PUD_FALSE;
+
+   if (!func) DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+   if (!_map_render_init(&mr, w2, pud)) goto end;
+
+   mr.pixels = malloc(MAP_WAVE_BANDS * mr.w * MAP_BAND_H * sizeof(Pud_Color));
+   if (!mr.pixels) DIE_GOTO(end, "Failed to allocate memory");
+
+   for (mr.first_row = 0; mr.first_row < mr.map_h; mr.first_row += count)
+     {
+        count = mr.map_h - mr.first_row;
+        if (count > MAP_WAVE_BANDS) count = MAP_WAVE_BANDS;
+        war2_parallel_for(count, 1, _rows_render, &mr);
+
+        for (i = 0; i < count; i++)
+          {
+             if (!func(data, &(mr.pixels[i * mr.w * MAP_BAND_H]),
+                       (mr.first_row + i) * MAP_BAND_H, mr.w, MAP_BAND_H))
+               goto end;
+          }
+     }
+   ret = PUD_TRUE;
+
+end:
+   free(mr.pixels);
+   _map_render_clear(&mr);
+   return ret;
+}
+
+static Pud_Bool
+_png_band_cb(void            *data,
+             const Pud_Color *band,
+             unsigned int     y,
+             unsigned int     w,
+             unsigned int     h)
+{
+   (void) y;
+   (void) w;
+   return war2_png_stream_rows_write(data, band, h);
+}
+
+PUDAPI Pud_Bool
+war2_map_render_png(War2_Data  *w2,
+                    const Pud  *pud,
+                    const char *file)
+{
+   War2_Png_Stream *s;
+   Pud_Bool ret;
+
+   if ((!pud) || (!file))
+     DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+
+   s = war2_png_stream_new(file, pud->map_w * 32, pud->map_h * 32, NULL);
+   if (!s) return PUD_FALSE;
+   ret = war2_map_render(w2, pud, _png_band_cb, s);
+   if (!war2_png_stream_close(s)) ret = PUD_FALSE;
+
+   return ret;
+}
+
+static void
+_renderer_full_render(War2_Map_Renderer *r)
+{
+   r->mr.first_row = 0;
+   war2_parallel_for(r->mr.map_h, 1, _rows_render, &(r->mr));
+}
+
+PUDAPI War2_Map_Renderer *
+war2_map_renderer_new(War2_Data *w2,
+                      const Pud *pud)
+{
+   War2_Map_Renderer *r;
+
+   r = calloc(1, sizeof(War2_Map_Renderer));
+   if (!r) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   if (!_map_render_init(&(r->mr), w2, pud)) goto fail;
+   r->mr.pixels = malloc(r->mr.w * r->mr.h * sizeof(Pud_Color));
+   r->dirty = calloc(r->mr.map_w * r->mr.map_h, sizeof(unsigned char));
+   r->changed = calloc(r->mr.map_w * r->mr.map_h, sizeof(unsigned char));
+   if ((!r->mr.pixels) || (!r->dirty) || (!r->changed))
+     DIE_GOTO(fail, "Failed to allocate memory");
+
+   _renderer_full_render(r);
+   return r;
+
+fail:
+   war2_map_renderer_free(r);
+   return NULL;
+}
+
+PUDAPI void
+war2_map_renderer_free(War2_Map_Renderer *r)
+{
+   if (!r) return;
+   free(r->mr.pixels);
+   free(r->dirty);
+   free(r->changed);
+   free(r->added);
+   _map_render_clear(&(r->mr));
+   free(r);
+}
+
+PUDAPI const Pud_Color *
+war2_map_renderer_pixels_get(const War2_Map_Renderer *r,
+                             unsigned int            *w,
+                             unsigned int            *h)
+{
+   if (!r) DIE_RETURN(NULL, "NULL renderer");
+   if (w) *w = r->mr.w;
+   if (h) *h = r->mr.h;
+   return r->mr.pixels;
+}
+
+/* Mark as dirty the cells [cx0 ; cx1[ x [cy0 ; cy1[, clipped to the map */
+static void
+_renderer_cells_dirty(War2_Map_Renderer *r,
+                      int                cx0,
+                      int                cy0,
+                      int                cx1,
+                      int                cy1)
+{
+   int x, y;
+
+   if (cx0 < 0) cx0 = 0;
+   if (cy0 < 0) cy0 = 0;
+   if (cx1 > (int)r->mr.map_w) cx1 = r->mr.map_w;
+   if (cy1 > (int)r->mr.map_h) cy1 = r->mr.map_h;
+   if ((cx0 >= cx1) || (cy0 >= cy1)) return;
+
+   for (y = cy0; y < cy1; y++)
+     for (x = cx0; x < cx1; x++)
+       r->dirty[y * r->mr.map_w + x] = 1;
+
+   if ((unsigned int)cx0 < r->x0) r->x0 = cx0;
+   if ((unsigned int)cy0 < r->y0) r->y0 = cy0;
+   if ((unsigned int)cx1 > r->x1) r->x1 = cx1;
+   if ((unsigned int)cy1 > r->y1) r->y1 = cy1;
+}
+
+/* Mark as dirty all the cells covered by a sprite */
+static void
+_renderer_unit_dirty(War2_Map_Renderer *r,
+                     const Map_Unit    *unit)
+{
+   /* Sprites may start before the map, round towards -infinity */
+   _renderer_cells_dirty(r,
+                         (unit->x < 0) ? -1 : unit->x / 32,
+                         (unit->y < 0) ? -1 : unit->y / 32,
+                         (unit->x + (int)unit->sprite->w + 31) / 32,
+                         (unit->y + (int)unit->sprite->h + 31) / 32);
+}
+
+/*
+ * Whether a unit of the given size at (cx, cy) occupies a changed cell.
+ * cells_box is the bounding box of the changed cells.
+ */
+static Pud_Bool
+_renderer_unit_changed(const War2_Map_Renderer *r,
+                       unsigned int             cx,
+                       unsigned int             cy,
+                       unsigned int             size,
+                       const unsigned int      *cells_box)
+{
+   unsigned int x, y, x1, y1;
+
+   if ((cx >= cells_box[2]) || (cx + size <= cells_box[0]) ||
+       (cy >= cells_box[3]) || (cy + size <= cells_box[1]))
+     return PUD_FALSE;
+
+   x1 = (cx + size > r->mr.map_w) ? r->mr.map_w : cx + size;
+   y1 = (cy + size > r->mr.map_h) ? r->mr.map_h : cy + size;
+   for (y = cy; y < y1; y++)
+     for (x = cx; x < x1; x++)
+       if (r->changed[y * r->mr.map_w + x]) return PUD_TRUE;
+   return PUD_FALSE;
+}
+
+/*
+ * Units that occupy a changed cell may have been added, removed or
+ * modified: they are removed from the drawing list, then the units of
+ * the Pud that occupy a changed cell are inserted back at their place.
+ * Other units are neither sorted nor modified again.
+ */
+static Pud_Bool
+_renderer_units_update(War2_Map_Renderer  *r,
+                       const unsigned int *cells_box)
+{
+   Map_Render *const mr = &(r->mr);
+   const Pud *const pud = mr->pud;
+   const Pud_Unit_Info *info;
+   Map_Unit *units;
+   unsigned int i, k, added = 0, kept, alloc;
+
+   /* Units of the Pud, as they are now */
+   for (i = 0; i < pud->units_count; i++)
+     {
+        info = &(pud->units[i]);
+        if (!_renderer_unit_changed(r, info->x, info->y,
+                                    pud_unit_size_get(info->type), cells_box))
+          continue;
+
+        if (added == r->added_alloc)
+          {
+             alloc = (r->added_alloc) ? r->added_alloc * 2 : 16;
+             units = realloc(r->added, alloc * sizeof(Map_Unit));
+             if (!units) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+             r->added = units;
+             r->added_alloc = alloc;
+          }
+        if (_unit_init(mr, &(r->added[added]), i))
+          {
+             _renderer_unit_dirty(r, &(r->added[added]));
+             added++;
+          }
+     }
+
+   /* Reserve before modifying the list, so it is left intact on failure */
+   if (mr->units_count + added > mr->units_alloc)
+     {
+        units = realloc(mr->units, (mr->units_count + added) * 2 * sizeof(Map_Unit));
+        if (!units) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        mr->units = units;
+        mr->units_alloc = (mr->units_count + added) * 2;
+     }
+
+   /* Units of the list, as they were before */
+   for (i = 0, k = 0; i < mr->units_count; i++)
+     {
+        if (_renderer_unit_changed(r, mr->units[i].cx, mr->units[i].cy,
+                                   mr->units[i].sprite->size, cells_box))
+          _renderer_unit_dirty(r, &(mr->units[i]));
+        else
+          mr->units[k++] = mr->units[i];
+     }
+   kept = k;
+   mr->units_count = kept;
+   if (added == 0) return PUD_TRUE;
+
+   /* Merge the sorted new units in the list, from the end */
+   qsort(r->added, added, sizeof(Map_Unit), _unit_cmp);
+   i = kept;
+   k = added;
+   while (k > 0)
+     {
+        if ((i > 0) && (_unit_cmp(&(mr->units[i - 1]), &(r->added[k - 1])) > 0))
+          {
+             mr->units[i + k - 1] = mr->units[i - 1];
+             i--;
+          }
+        else
+          {
+             mr->units[i + k - 1] = r->added[k - 1];
+             k--;
+          }
+     }
+   mr->units_count = kept + added;
+
+   return PUD_TRUE;
+}
+
+PUDAPI Pud_Bool
+war2_map_renderer_update(War2_Map_Renderer   *r,
+                         const War2_Map_Cell *cells,
+                         unsigned int         count,
+                         War2_Map_Rect       *dirty)
+{
+   Map_Render *mr;
+   unsigned int i, x, y, cells_box[4];
+   War2_Map_Rect bbox = { 0, 0, 0, 0 };
+   Pud_Bool ret;
+
+   if (!r) DIE_RETURN(PUD_FALSE, "NULL renderer");
+   if ((count > 0) && (!cells)) DIE_RETURN(PUD_FALSE, "NULL cells");
+   mr = &(r->mr);
+
+   /* The map has been resized: everything must be rendered again */
+   if ((mr->pud->map_w != mr->map_w) || (mr->pud->map_h != mr->map_h))
+     {
+        War2_Data *const w2 = mr->w2;
+        const Pud *const pud = mr->pud;
+        War2_Map_Renderer *nr;
+
+        nr = war2_map_renderer_new(w2, pud);
+        if (!nr) DIE_RETURN(PUD_FALSE, "Failed to render the resized map");
+        free(r->mr.pixels);
+        free(r->dirty);
+        free(r->changed);
+        free(r->added);
+        _map_render_clear(&(r->mr));
+        *r = *nr;
+        free(nr);
+        if (dirty)
+          {
+             dirty->x = dirty->y = 0;
+             dirty->w = r->mr.w;
+             dirty->h = r->mr.h;
+          }
+        return PUD_TRUE;
+     }
+
+   /* Changed cells are dirty. Their bounding box allows to skip quickly
+    * the units that are far from them */
+   r->x0 = cells_box[0] = mr->map_w;
+   r->y0 = cells_box[1] = mr->map_h;
+   r->x1 = r->y1 = cells_box[2] = cells_box[3] = 0;
+   for (i = 0; i < count; i++)
+     {
+        x = cells[i].x;
+        y = cells[i].y;
+        if ((x >= mr->map_w) || (y >= mr->map_h)) continue;
+        r->changed[y * mr->map_w + x] = 1;
+        _renderer_cells_dirty(r, x, y, x + 1, y + 1);
+        if (x < cells_box[0]) cells_box[0] = x;
+        if (y < cells_box[1]) cells_box[1] = y;
+        if (x >= cells_box[2]) cells_box[2] = x + 1;
+        if (y >= cells_box[3]) cells_box[3] = y + 1;
+     }
+
+   /* The sprites of the units that occupy a changed cell, before and
+    * after the changes, are dirty */
+   ret = (cells_box[2] == 0) ? PUD_TRUE : _renderer_units_update(r, cells_box);
+   for (i = 0; i < count; i++)
+     {
+        if ((cells[i].x < mr->map_w) && (cells[i].y < mr->map_h))
+          r->changed[cells[i].y * mr->map_w + cells[i].x] = 0;
+     }
+
+   /* Redraw the runs of dirty cells of each row of the dirty area */
+   for (y = r->y0; y < r->y1; y++)
+     {
+        for (x = r->x0; x < r->x1;)
+          {
+             if (!r->dirty[y * mr->map_w + x])
+               {
+                  x++;
+                  continue;
+               }
+             for (i = x; (i < r->x1) && (r->dirty[y * mr->map_w + i]); i++)
+               r->dirty[y * mr->map_w + i] = 0;
+             _area_render(mr, &(mr->pixels[(y * 32 * mr->w) + (x * 32)]), mr->w,
+                          x, y, i, y + 1);
+             x = i;
+          }
+     }
+
+   if (r->x1 > 0)
+     {
+        bbox.x = r->x0 * 32;
+        bbox.y = r->y0 * 32;
+        bbox.w = (r->x1 - r->x0) * 32;
+        bbox.h = (r->y1 - r->y0) * 32;
+     }
+   if (dirty) *dirty = bbox;
+
+   return ret;
+}
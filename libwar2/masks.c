@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+PUDAPI_INTERNAL void
+war2_sprite_mask_build(War2_Sprite_Mask    *mask,
+                       uint64_t            *bits,
+                       War2_Sprite_Span    *spans,
+                       const unsigned char *img,
+                       unsigned int         w,
+                       unsigned int         h,
+                       const Pud_Color     *palette)
+{
+   const unsigned int wpr = WAR2_SPRITE_MASK_WORDS(w);
+   unsigned int x, y, start, end;
+   uint64_t *row;
+
+   memset(bits, 0, wpr * h * sizeof(uint64_t));
+
+   for (y = 0; y < h; y++, img += w)
+     {
+        row = &(bits[y * wpr]);
+        start = w;
+        end = 0;
+        for (x = 0; x < w; x++)
+          {
+             /* Index 0 is the transparent color, but rely on the palette
+              * alpha to stay consistent with the RGBA output */
+             if (palette[img[x]].a != 0)
+               {
+                  row[x / 64] |= (uint64_t)1 << (x % 64);
+                  if (start == w) start = x;
+                  end = x + 1;
+               }
+          }
+        if (start == w) start = end = 0;
+        spans[y].start = start;
+        spans[y].end = end;
+     }
+
+   mask->w = w;
+   mask->h = h;
+   mask->words_per_row = wpr;
+   mask->bits = bits;
+   mask->spans = spans;
+}
+
+PUDAPI War2_Sprite_Mask *
+war2_sprite_mask_dup(const War2_Sprite_Mask *mask)
+{
+   War2_Sprite_Mask *dup;
+   size_t bits_size, spans_size;
+   unsigned char *mem;
+
+   if (!mask) DIE_RETURN(NULL, "NULL mask");
+
+   bits_size = mask->words_per_row * mask->h * sizeof(uint64_t);
+   spans_size = mask->h * sizeof(War2_Sprite_Span);
+
+   /* Single allocation: the mask header, then the bits (which are
+    * correctly aligned after the header), then the spans */
+   mem = malloc(sizeof(War2_Sprite_Mask) + bits_size + spans_size);
+   if (!mem) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   dup = (War2_Sprite_Mask *)mem;
+   memcpy(mem + sizeof(War2_Sprite_Mask), mask->bits, bits_size);
+   memcpy(mem + sizeof(War2_Sprite_Mask) + bits_size, mask->spans, spans_size);
+
+   dup->w = mask->w;
+   dup->h = mask->h;
+   dup->words_per_row = mask->words_per_row;
+   dup->bits = (const uint64_t *)(mem + sizeof(War2_Sprite_Mask));
+   dup->spans = (const War2_Sprite_Span *)(mem + sizeof(War2_Sprite_Mask) + bits_size);
+
+   return dup;
+}
+
+PUDAPI void
+war2_sprite_mask_free(War2_Sprite_Mask *mask)
+{
+   free(mask);
+}
+
+/*
+ * Get the 64 bits of a mask row starting at bit 'offset'. Bits that lie
+ * outside of the row are transparent (0).
+ */
+static uint64_t
+_mask_word_get(const War2_Sprite_Mask *mask,
+               unsigned int            y,
+               int                     offset)
+{
+   const uint64_t *const row = &(mask->bits[y * mask->words_per_row]);
+   const int words = (int)mask->words_per_row;
+   int idx, shift;
+   uint64_t lo = 0, hi = 0;
+
+   /* Floor division, as offset may be negative */
+   idx = (offset >= 0) ? (offset / 64) : -((-offset + 63) / 64);
+   shift = offset - (idx * 64);
+
+   if ((idx >= 0) && (idx < words)) lo = row[idx];
+   if ((idx + 1 >= 0) && (idx + 1 < words)) hi = row[idx + 1];
+
+   if (shift == 0) return lo;
+   return (lo >> shift) | (hi << (64 - shift));
+}
+
+PUDAPI Pud_Bool
+war2_sprite_mask_overlap(const War2_Sprite_Mask *a,
+                         int                     ax,
+                         int                     ay,
+                         const War2_Sprite_Mask *b,
+                         int                     bx,
+                         int                     by)
+{
+   int x0, x1, y0, y1, y, x, sx0, sx1;
+   const War2_Sprite_Span *sa, *sb;
+   uint64_t wa, wb;
+
+   if ((!a) || (!b)) return PUD_FALSE;
+
+   /* Intersection of the bounding boxes */
+   x0 = (ax > bx) ? ax : bx;
+   y0 = (ay > by) ? ay : by;
+   x1 = ((ax + (int)a->w) < (bx + (int)b->w)) ? (ax + (int)a->w) : (bx + (int)b->w);
+   y1 = ((ay + (int)a->h) < (by + (int)b->h)) ? (ay + (int)a->h) : (by + (int)b->h);
+   if ((x0 >= x1) || (y0 >= y1)) return PUD_FALSE;
+
+   for (y = y0; y < y1; y++)
+     {
+        /* Use the spans to reject rows without touching the bits */
+        sa = &(a->spans[y - ay]);
+        sb = &(b->spans[y - by]);
+        sx0 = ((ax + sa->start) > (bx + sb->start)) ? (ax + sa->start) : (bx + sb->start);
+        sx1 = ((ax + sa->end) < (bx + sb->end)) ? (ax + sa->end) : (bx + sb->end);
+        if (sx0 < x0) sx0 = x0;
+        if (sx1 > x1) sx1 = x1;
+        if (sx0 >= sx1) continue;
+
+        for (x = sx0; x < sx1; x += 64)
+          {
+             wa = _mask_word_get(a, y - ay, x - ax);
+             wb = _mask_word_get(b, y - by, x - bx);
+             if (sx1 - x < 64)
+               wa &= ((uint64_t)1 << (sx1 - x)) - 1;
+             if (wa & wb) return PUD_TRUE;
+          }
+     }
+
+   return PUD_FALSE;
+}
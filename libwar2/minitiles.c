@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+PUDAPI_INTERNAL War2_Minitiles *
+war2_minitiles_new(const unsigned char *data,
+                   size_t               size,
+                   const Pud_Color     *palette)
+{
+   War2_Minitiles *mt;
+   const unsigned char *src, *row;
+   unsigned char *idx;
+   unsigned int m, v, x, y, count, total;
+
+   count = size / WAR2_MINITILE_PIXELS;
+   if (count == 0) DIE_RETURN(NULL, "No minitiles in entry");
+
+   /* One more minitile, that stays blank, is used in place of minitiles
+    * referenced by megatiles but absent from the data */
+   total = (count + 1) * WAR2_MINITILE_VARIANTS * WAR2_MINITILE_PIXELS;
+   mt = malloc(sizeof(War2_Minitiles) +
+               total * (sizeof(Pud_Color) + sizeof(unsigned char)));
+   if (!mt) DIE_RETURN(NULL, "Failed to allocate memory");
+   mt->count = count;
+   mt->rgba = (Pud_Color *)(mt + 1);
+   mt->indexes = (unsigned char *)(mt->rgba + total);
+
+   /* Bit 0 of the variant flips the minitile on its Y axis, bit 1 on
+    * its X axis, as in the megatile words */
+   idx = mt->indexes;
+   for (m = 0; m < count; m++)
+     {
+        src = &(data[m * WAR2_MINITILE_PIXELS]);
+        for (v = 0; v < WAR2_MINITILE_VARIANTS; v++)
+          {
+             for (y = 0; y < 8; y++, idx += 8)
+               {
+                  row = &(src[((v & 1) ? 7 - y : y) * 8]);
+                  if (v & 2)
+                    for (x = 0; x < 8; x++) idx[x] = row[7 - x];
+                  else
+                    memcpy(idx, row, 8);
+               }
+          }
+     }
+   memset(idx, 0, WAR2_MINITILE_VARIANTS * WAR2_MINITILE_PIXELS);
+
+   for (m = 0; m < total; m++)
+     mt->rgba[m] = palette[mt->indexes[m]];
+
+   return mt;
+}
+
+PUDAPI_INTERNAL void
+war2_minitiles_free(War2_Minitiles *mt)
+{
+   free(mt);
+}
+
+static inline unsigned int
+_minitile_offset(const War2_Minitiles *mt,
+                 const unsigned char  *words,
+                 unsigned int          i)
+{
+   unsigned int o, m;
+
+   o = words[i * 2] | (words[i * 2 + 1] << 8);
+   m = o >> 2;
+   if (m > mt->count) m = mt->count;
+   return ((m * WAR2_MINITILE_VARIANTS) + (o & 3)) * WAR2_MINITILE_PIXELS;
+}
+
+PUDAPI_INTERNAL void
+war2_minitiles_megatile_rgba(const War2_Minitiles *mt,
+                             const unsigned char  *words,
+                             Pud_Color            *img,
+                             unsigned int          stride)
+{
+   const Pud_Color *src;
+   Pud_Color *dst;
+   unsigned int i, y;
+
+   /* A megatile is made of 4x4 minitiles. Each row of a minitile is
+    * 8 pixels (32 bytes) that are copied at once */
+   for (i = 0; i < 16; i++)
+     {
+        src = &(mt->rgba[_minitile_offset(mt, words, i)]);
+        dst = &(img[((i / 4) * 8 * stride) + ((i % 4) * 8)]);
+        for (y = 0; y < 8; y++, src += 8, dst += stride)
+          memcpy(dst, src, 8 * sizeof(Pud_Color));
+     }
+}
+
+PUDAPI_INTERNAL void
+war2_minitiles_megatile_indexes(const War2_Minitiles *mt,
+                                const unsigned char  *words,
+                                unsigned char        *img,
+                                unsigned int          stride)
+{
+   const unsigned char *src;
+   unsigned char *dst;
+   unsigned int i, y;
+
+   for (i = 0; i < 16; i++)
+     {
+        src = &(mt->indexes[_minitile_offset(mt, words, i)]);
+        dst = &(img[((i / 4) * 8 * stride) + ((i % 4) * 8)]);
+        for (y = 0; y < 8; y++, src += 8, dst += stride)
+          memcpy(dst, src, 8);
+     }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+#ifdef HAVE_PTHREAD
+# include <pthread.h>
+# include <unistd.h>
+#endif
+
+/* There is no point in spawning more threads than this */
+#define PARALLEL_MAX_THREADS 16
+
+#ifdef HAVE_PTHREAD
+typedef struct
+{
+   War2_Parallel_Func  func;
+   void               *data;
+   unsigned int        start;
+   unsigned int        end;
+} Parallel_Job;
+
+static void *
+_parallel_job_run(void *data)
+{
+   Parallel_Job *const job = data;
+   job->func(job->data, job->start, job->end);
+   return NULL;
+}
+
+static unsigned int
+_cpus_count(void)
+{
+   long cpus = 1;
+# ifdef _SC_NPROCESSORS_ONLN
+   cpus = sysconf(_SC_NPROCESSORS_ONLN);
+# endif
+   if (cpus < 1) cpus = 1;
+   if (cpus > PARALLEL_MAX_THREADS) cpus = PARALLEL_MAX_THREADS;
+   return cpus;
+}
+#endif
+
+PUDAPI_INTERNAL void
+war2_parallel_for(unsigned int        count,
+                  unsigned int        grain,
+                  War2_Parallel_Func  func,
+                  void               *data)
+{
+#ifdef HAVE_PTHREAD
+   pthread_t threads[PARALLEL_MAX_THREADS];
+   Parallel_Job jobs[PARALLEL_MAX_THREADS];
+   Pud_Bool started[PARALLEL_MAX_THREADS];
+   unsigned int n, i, chunk;
+
+   if (count == 0) return;
+   if (grain == 0) grain = 1;
+
+   /* Do not split work that is too small to be worth a thread */
+   n = _cpus_count();
+   if (count / grain < n) n = count / grain;
+   if (n <= 1)
+     {
+        func(data, 0, count);
+        return;
+     }
+
+   chunk = (count + n - 1) / n;
+   for (i = 0; i < n; i++)
+     {
+        jobs[i].func = func;
+        jobs[i].data = data;
+        jobs[i].start = i * chunk;
+        jobs[i].end = (i + 1) * chunk;
+        if (jobs[i].end > count) jobs[i].end = count;
+        if (jobs[i].start > count) jobs[i].start = count;
+     }
+
+   /* The calling thread processes the first chunk. If a thread cannot be
+    * created, its chunk is processed by the calling thread as well */
+   for (i = 1; i < n; i++)
+     started[i] = (pthread_create(&(threads[i]), NULL,
+                                  _parallel_job_run, &(jobs[i])) == 0);
+   _parallel_job_run(&(jobs[0]));
+   for (i = 1; i < n; i++)
+     {
+        if (started[i])
+          pthread_join(threads[i], NULL);
+        else
+          _parallel_job_run(&(jobs[i]));
+     }
+#else
+   (void) grain;
+   if (count > 0) func(data, 0, count);
+#endif
+}
+
+PUDAPI_INTERNAL void
+war2_parallel_flag_set(Pud_Bool *flag)
+{
+#if defined(HAVE_PTHREAD) && defined(__GNUC__)
+   __atomic_store_n(flag, PUD_TRUE, __ATOMIC_RELAXED);
+#else
+   *flag = PUD_TRUE;
+#endif
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_parallel_flag_get(const Pud_Bool *flag)
+{
+#if defined(HAVE_PTHREAD) && defined(__GNUC__)
+   return __atomic_load_n(flag, __ATOMIC_RELAXED);
+#else
+   return *flag;
+#endif
+}
@@ -25,61 +25,386 @@
 
 #if HAVE_PNG
 # include <png.h>
+# include <zlib.h>
 #endif
 
-PUDAPI Pud_Bool
-war2_png_write(const char          *file,
-               unsigned int          w,
-               unsigned int          h,
-               const unsigned char *data)
+struct _War2_Png_Stream
 {
 #if HAVE_PNG
-   FILE *f;
-   int i;
-   png_structp png_ptr;
-   png_infop info_ptr;
-   png_bytepp row_pointers;
+   png_structp  png_ptr;
+   png_infop    info_ptr;
+#endif
+   War2_Image_Write_Func  func;
+   void                  *data;
+   FILE                  *f; /* Owned by the stream if not NULL */
+   unsigned int           w;
+   unsigned int           h;
+   unsigned int           rows;
+   unsigned int           stride; /* Bytes per row */
+   Pud_Bool               failed; /* The output could not be written */
+};
 
-   f = fopen(file, "wb");
-   if (!f) DIE_RETURN(PUD_FALSE, "Failed to open [%s]", file);
+PUDAPI void
+war2_png_options_init(War2_Png_Options *opts,
+                      War2_Png_Profile  profile)
+{
+   if (!opts) return;
 
-   png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-   if (!png_ptr) DIE_GOTO(err, "Failed to create png struct");
+   switch (profile)
+     {
+      case WAR2_PNG_PROFILE_FAST:
+         /* Trying every filter on each row costs more than the deflate
+          * itself at low levels. SUB alone suits sprites and tiles, whose
+          * pixels often repeat their left neighbour */
+         opts->compression_level = 1;
+         opts->filter = WAR2_PNG_FILTER_SUB;
+         opts->strategy = WAR2_PNG_STRATEGY_DEFAULT;
+         opts->buffer_size = 64 * 1024;
+         break;
 
-   info_ptr = png_create_info_struct(png_ptr);
-   if (!info_ptr) DIE_GOTO(errf, "Failed to create png info struct");
+      case WAR2_PNG_PROFILE_SMALL:
+         opts->compression_level = 9;
+         opts->filter = WAR2_PNG_FILTER_ADAPTIVE;
+         opts->strategy = WAR2_PNG_STRATEGY_DEFAULT;
+         opts->buffer_size = 64 * 1024;
+         break;
 
-   png_init_io(png_ptr, f);
+      case WAR2_PNG_PROFILE_DEFAULT:
+      default:
+         opts->compression_level = -1;
+         opts->filter = WAR2_PNG_FILTER_DEFAULT;
+         opts->strategy = WAR2_PNG_STRATEGY_DEFAULT;
+         opts->buffer_size = 0;
+         break;
+     }
+}
 
-   png_set_IHDR(png_ptr, info_ptr, w, h, 8, PNG_COLOR_TYPE_RGBA,
-                PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
-                PNG_FILTER_TYPE_BASE);
-   png_write_info(png_ptr, info_ptr);
+#if HAVE_PNG
+static Pud_Bool
+_png_options_apply(png_structp             png_ptr,
+                   const War2_Png_Options *opts)
+{
+   int filter, strategy;
+
+   if ((opts->compression_level < -1) || (opts->compression_level > 9))
+     DIE_RETURN(PUD_FALSE, "Invalid compression level %i",
+                opts->compression_level);
 
-   row_pointers = malloc(h * sizeof(unsigned char *));
-   if (!row_pointers) DIE_GOTO(errf, "Failed to allocate memory");
-   for (i = 0; i < h; i++)
-     row_pointers[i] = (png_bytep)(&(data[i * w * 4]));
+   switch (opts->filter)
+     {
+      case WAR2_PNG_FILTER_DEFAULT:  filter = -1; break;
+      case WAR2_PNG_FILTER_NONE:     filter = PNG_FILTER_NONE; break;
+      case WAR2_PNG_FILTER_SUB:      filter = PNG_FILTER_SUB; break;
+      case WAR2_PNG_FILTER_PAETH:    filter = PNG_FILTER_PAETH; break;
+      case WAR2_PNG_FILTER_ADAPTIVE: filter = PNG_ALL_FILTERS; break;
+      default: DIE_RETURN(PUD_FALSE, "Invalid filter %i", opts->filter);
+     }
 
-   png_write_image(png_ptr, row_pointers);
-   png_write_end(png_ptr, NULL);
-   png_destroy_write_struct(&png_ptr, &info_ptr);
-   free(row_pointers);
-   fclose(f);
+   switch (opts->strategy)
+     {
+      case WAR2_PNG_STRATEGY_DEFAULT:      strategy = -1; break;
+      case WAR2_PNG_STRATEGY_FILTERED:     strategy = Z_FILTERED; break;
+      case WAR2_PNG_STRATEGY_HUFFMAN_ONLY: strategy = Z_HUFFMAN_ONLY; break;
+      case WAR2_PNG_STRATEGY_RLE:          strategy = Z_RLE; break;
+      default: DIE_RETURN(PUD_FALSE, "Invalid strategy %i", opts->strategy);
+     }
+
+   /* Settings left to their default let libpng make its own choices */
+   if (opts->compression_level >= 0)
+     png_set_compression_level(png_ptr, opts->compression_level);
+   if (filter >= 0)
+     png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filter);
+   if (strategy >= 0)
+     png_set_compression_strategy(png_ptr, strategy);
+   if (opts->buffer_size > 0)
+     png_set_compression_buffer_size(png_ptr, opts->buffer_size);
 
    return PUD_TRUE;
+}
+#endif
 
-errf:
-   png_destroy_write_struct(&png_ptr, &info_ptr);
-err:
-   fclose(f);
-   return PUD_FALSE;
+#if HAVE_PNG
+static void
+_png_write_cb(png_structp png_ptr,
+              png_bytep   bytes,
+              png_size_t  size)
+{
+   War2_Png_Stream *const s = png_get_io_ptr(png_ptr);
+
+   /* png_error() cannot be used, as there is no jump buffer. Next writes
+    * are ignored, and the stream fails when closed */
+   if (s->failed) return;
+   if (!s->func(s->data, bytes, size))
+     s->failed = PUD_TRUE;
+}
+
+static void
+_png_flush_cb(png_structp png_ptr)
+{
+   (void) png_ptr;
+}
+#endif
+
+/* RGBA stream if palette is NULL, indexed stream otherwise */
+static War2_Png_Stream *
+_png_stream_new(War2_Image_Write_Func   func,
+                void                   *data,
+                unsigned int            w,
+                unsigned int            h,
+                const Pud_Color        *palette,
+                unsigned int            colors,
+                const War2_Png_Options *opts)
+{
+#if HAVE_PNG
+   War2_Png_Stream *s;
+   png_color plte[256];
+   png_byte trns[256];
+   unsigned int i, trns_count = 0;
+
+   if ((palette) && ((colors == 0) || (colors > 256)))
+     DIE_RETURN(NULL, "Invalid count of colors %u", colors);
+
+   s = calloc(1, sizeof(War2_Png_Stream));
+   if (!s) DIE_RETURN(NULL, "Failed to allocate memory");
+   s->w = w;
+   s->h = h;
+   s->stride = (palette) ? w : w * sizeof(Pud_Color);
+   s->func = func;
+   s->data = data;
+
+   s->png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+   if (!s->png_ptr) DIE_GOTO(err, "Failed to create png struct");
+
+   s->info_ptr = png_create_info_struct(s->png_ptr);
+   if (!s->info_ptr) DIE_GOTO(errp, "Failed to create png info struct");
+
+   png_set_write_fn(s->png_ptr, s, _png_write_cb, _png_flush_cb);
+   if ((opts) && (!_png_options_apply(s->png_ptr, opts)))
+     goto errp;
+
+   png_set_IHDR(s->png_ptr, s->info_ptr, w, h, 8,
+                (palette) ? PNG_COLOR_TYPE_PALETTE : PNG_COLOR_TYPE_RGBA,
+                PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
+                PNG_FILTER_TYPE_BASE);
+   if (palette)
+     {
+        /* tRNS only needs to go up to the last color that is not opaque */
+        for (i = 0; i < colors; i++)
+          {
+             plte[i].red = palette[i].r;
+             plte[i].green = palette[i].g;
+             plte[i].blue = palette[i].b;
+             trns[i] = palette[i].a;
+             if (palette[i].a != 0xff) trns_count = i + 1;
+          }
+        png_set_PLTE(s->png_ptr, s->info_ptr, plte, colors);
+        if (trns_count > 0)
+          png_set_tRNS(s->png_ptr, s->info_ptr, trns, trns_count, NULL);
+     }
+   png_write_info(s->png_ptr, s->info_ptr);
 
+   return s;
+
+errp:
+   png_destroy_write_struct(&(s->png_ptr), &(s->info_ptr));
+err:
+   free(s);
+   return NULL;
 #else
-   (void) file;
+   (void) func;
+   (void) data;
    (void) w;
    (void) h;
-   (void) data;
+   (void) palette;
+   (void) colors;
+   (void) opts;
+   DIE_RETURN(NULL, "PNG support is not available");
+#endif
+}
+
+static War2_Png_Stream *
+_png_stream_file_new(const char             *file,
+                     unsigned int            w,
+                     unsigned int            h,
+                     const Pud_Color        *palette,
+                     unsigned int            colors,
+                     const War2_Png_Options *opts)
+{
+   War2_Png_Stream *s;
+   FILE *f;
+
+   f = fopen(file, "wb");
+   if (!f) DIE_RETURN(NULL, "Failed to open [%s]", file);
+
+   s = _png_stream_new(war2_image_file_write, f, w, h, palette, colors, opts);
+   if (!s)
+     {
+        fclose(f);
+        return NULL;
+     }
+   s->f = f;
+   return s;
+}
+
+PUDAPI_INTERNAL War2_Png_Stream *
+war2_png_stream_new(const char             *file,
+                    unsigned int            w,
+                    unsigned int            h,
+                    const War2_Png_Options *opts)
+{
+   return _png_stream_file_new(file, w, h, NULL, 0, opts);
+}
+
+PUDAPI_INTERNAL War2_Png_Stream *
+war2_png_stream_func_new(War2_Image_Write_Func   func,
+                         void                   *data,
+                         unsigned int            w,
+                         unsigned int            h,
+                         const War2_Png_Options *opts)
+{
+   return _png_stream_new(func, data, w, h, NULL, 0, opts);
+}
+
+PUDAPI_INTERNAL War2_Png_Stream *
+war2_png_stream_indexed_new(const char             *file,
+                            unsigned int            w,
+                            unsigned int            h,
+                            const Pud_Color        *palette,
+                            unsigned int            colors,
+                            const War2_Png_Options *opts)
+{
+   if (!palette) DIE_RETURN(NULL, "NULL palette");
+   return _png_stream_file_new(file, w, h, palette, colors, opts);
+}
+
+static Pud_Bool
+_png_stream_rows_write(War2_Png_Stream     *s,
+                       const unsigned char *rows,
+                       unsigned int         stride,
+                       unsigned int         count)
+{
+#if HAVE_PNG
+   unsigned int i;
+
+   if (stride != s->stride)
+     DIE_RETURN(PUD_FALSE, "Rows do not match the format of the stream");
+   if (s->failed) return PUD_FALSE;
+   if (count > s->h - s->rows)
+     DIE_RETURN(PUD_FALSE, "Too many rows written (%u + %u > %u)",
+                s->rows, count, s->h);
+
+   for (i = 0; i < count; i++)
+     png_write_row(s->png_ptr, (png_bytep)(&(rows[i * stride])));
+   s->rows += count;
+
+   return PUD_TRUE;
+#else
+   (void) s;
+   (void) rows;
+   (void) stride;
+   (void) count;
    return PUD_FALSE;
 #endif
 }
+
+PUDAPI_INTERNAL Pud_Bool
+war2_png_stream_rows_write(War2_Png_Stream *s,
+                           const Pud_Color *rows,
+                           unsigned int     count)
+{
+   return _png_stream_rows_write(s, (const unsigned char *)rows,
+                                 s->w * sizeof(Pud_Color), count);
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_png_stream_indexed_rows_write(War2_Png_Stream     *s,
+                                   const unsigned char *rows,
+                                   unsigned int         count)
+{
+   return _png_stream_rows_write(s, rows, s->w, count);
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_png_stream_close(War2_Png_Stream *s)
+{
+   Pud_Bool ret = PUD_FALSE;
+
+   if (!s) return PUD_FALSE;
+
+#if HAVE_PNG
+   /* An image that has not been fully written is left truncated */
+   if (s->rows == s->h)
+     {
+        png_write_end(s->png_ptr, NULL);
+        ret = PUD_TRUE;
+     }
+   else
+     ERR("PNG stream closed after %u rows out of %u", s->rows, s->h);
+   png_destroy_write_struct(&(s->png_ptr), &(s->info_ptr));
+#endif
+   if (s->failed)
+     {
+        ERR("Failed to write the PNG image");
+        ret = PUD_FALSE;
+     }
+   if ((s->f) && (fclose(s->f) != 0)) ret = PUD_FALSE;
+   free(s);
+
+   return ret;
+}
+
+PUDAPI Pud_Bool
+war2_png_write_full(const char             *file,
+                    unsigned int            w,
+                    unsigned int            h,
+                    const unsigned char    *data,
+                    const War2_Png_Options *opts)
+{
+   War2_Png_Stream *s;
+
+   s = war2_png_stream_new(file, w, h, opts);
+   if (!s) return PUD_FALSE;
+   war2_png_stream_rows_write(s, (const Pud_Color *)data, h);
+   return war2_png_stream_close(s);
+}
+
+PUDAPI Pud_Bool
+war2_png_write(const char          *file,
+               unsigned int          w,
+               unsigned int          h,
+               const unsigned char *data)
+{
+   return war2_png_write_full(file, w, h, data, NULL);
+}
+
+PUDAPI Pud_Bool
+war2_png_indexed_write(const char             *file,
+                       unsigned int            w,
+                       unsigned int            h,
+                       const unsigned char    *indexes,
+                       const Pud_Color        *palette,
+                       unsigned int            colors,
+                       const War2_Png_Options *opts)
+{
+   War2_Png_Stream *s;
+   const size_t size = (size_t)w * h;
+   unsigned int used = 0;
+   size_t i;
+
+   if (!indexes) DIE_RETURN(PUD_FALSE, "NULL indexes");
+   if (colors > 256) DIE_RETURN(PUD_FALSE, "Invalid count of colors %u", colors);
+
+   /* Small images (e.g. sprite frames) often use only the beginning of
+    * the palette, the end of which is then not written */
+   for (i = 0; i < size; i++)
+     if (indexes[i] >= used) used = indexes[i] + 1u;
+   if (used > colors)
+     DIE_RETURN(PUD_FALSE, "Index %u is not in the palette (%u colors)",
+                used - 1, colors);
+   if (used > 0) colors = used;
+
+   s = war2_png_stream_indexed_new(file, w, h, palette, colors, opts);
+   if (!s) return PUD_FALSE;
+   war2_png_stream_indexed_rows_write(s, indexes, h);
+   return war2_png_stream_close(s);
+}
@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+#if HAVE_PNG
+# include <zlib.h>
+#endif
+
+/*
+ * PNG encoder that deflates stripes of rows on several threads, as pigz
+ * does. Rows are filtered first, then each stripe is deflated on its own,
+ * primed with the 32 KiB of filtered data that precede it so the
+ * compression ratio stays close to a single stream. Stripes but the last
+ * end with a sync flush, which ends them on a byte boundary without
+ * ending the deflate stream: they can be concatenated as is. The adler32
+ * of the zlib stream is combined from the ones of the stripes.
+ */
+
+/* Size of the filtered data of a stripe. Much smaller stripes lose
+ * compression, much larger ones do not spread over enough threads */
+#define STRIPE_SIZE (256 * 1024)
+#define WINDOW_SIZE (32 * 1024)
+#define BPP 4
+
+#if HAVE_PNG
+
+typedef struct
+{
+   unsigned char *out;
+   size_t         size;
+   uLong          adler;
+   Pud_Bool       ok;
+} Stripe;
+
+typedef struct
+{
+   const unsigned char *pixels;
+   unsigned char       *filtered;
+   size_t               row_size; /* Filter type byte + pixels */
+   unsigned int         w;
+   unsigned int         h;
+   unsigned int         rows_per_stripe;
+   unsigned int         stripes_count;
+   Stripe              *stripes;
+   unsigned char       *zeros; /* Row above the first one */
+   Pud_Bool             failed;
+   int                  filter; /* PNG filter type, -1 for adaptive */
+   int                  level;
+   int                  strategy;
+} Png_Job;
+
+static inline unsigned char
+_paeth(unsigned char a,
+       unsigned char b,
+       unsigned char c)
+{
+   const int p = (int)a + b - c;
+   const int pa = abs(p - a);
+   const int pb = abs(p - b);
+   const int pc = abs(p - c);
+
+   if ((pa <= pb) && (pa <= pc)) return a;
+   return (pb <= pc) ? b : c;
+}
+
+/* Applies a filter type to a row of len bytes. prev is a row of zeros
+ * for the first row of the image. Each filter has its own loop so the
+ * compiler can vectorize it */
+static void
+_row_filter(int                  type,
+            const unsigned char *row,
+            const unsigned char *prev,
+            size_t               len,
+            unsigned char       *out)
+{
+   size_t i;
+
+   switch (type)
+     {
+      case 0:
+         memcpy(out, row, len);
+         break;
+
+      case 1:
+         memcpy(out, row, BPP);
+         for (i = BPP; i < len; i++)
+           out[i] = row[i] - row[i - BPP];
+         break;
+
+      case 2:
+         for (i = 0; i < len; i++)
+           out[i] = row[i] - prev[i];
+         break;
+
+      case 3:
+         for (i = 0; i < BPP; i++)
+           out[i] = row[i] - (prev[i] >> 1);
+         for (i = BPP; i < len; i++)
+           out[i] = row[i] - ((row[i - BPP] + prev[i]) >> 1);
+         break;
+
+      default:
+         for (i = 0; i < BPP; i++)
+           out[i] = row[i] - prev[i];
+         for (i = BPP; i < len; i++)
+           out[i] = row[i] - _paeth(row[i - BPP], prev[i], prev[i - BPP]);
+         break;
+     }
+}
+
+/* Sum of the filtered bytes seen as signed values, which is the heuristic
+ * advised by the PNG specification to choose a filter. Stops once limit
+ * is exceeded */
+static unsigned long
+_row_cost(const unsigned char *out,
+          size_t               len,
+          unsigned long        limit)
+{
+   unsigned long sum = 0;
+   size_t i;
+
+   for (i = 0; (i < len) && (sum <= limit); i++)
+     sum += (out[i] < 128) ? out[i] : 256 - out[i];
+   return sum;
+}
+
+static void
+_rows_filter(void         *data,
+             unsigned int  start,
+             unsigned int  end)
+{
+   Png_Job *const job = data;
+   const size_t len = job->row_size - 1;
+   const unsigned char *row, *prev;
+   unsigned char *out, *candidates = NULL, *best_row;
+   unsigned long sum, best_sum;
+   unsigned int y;
+   int type, best;
+
+   /* Adaptive filtering tries every filter in a row of its own */
+   if (job->filter < 0)
+     {
+        candidates = malloc(5 * len);
+        if (!candidates)
+          {
+             ERR("Failed to allocate memory");
+             war2_parallel_flag_set(&(job->failed));
+             return;
+          }
+     }
+
+   for (y = start; y < end; y++)
+     {
+        row = &(job->pixels[y * len]);
+        prev = (y > 0) ? row - len : job->zeros;
+        out = &(job->filtered[y * job->row_size]);
+
+        if (job->filter >= 0)
+          {
+             out[0] = job->filter;
+             _row_filter(job->filter, row, prev, len, out + 1);
+             continue;
+          }
+
+        best = 0;
+        best_sum = ~0UL;
+        for (type = 0; type <= 4; type++)
+          {
+             _row_filter(type, row, prev, len, &(candidates[type * len]));
+             sum = _row_cost(&(candidates[type * len]), len, best_sum);
+             if (sum < best_sum)
+               {
+                  best_sum = sum;
+                  best = type;
+               }
+          }
+        best_row = &(candidates[best * len]);
+        out[0] = best;
+        memcpy(out + 1, best_row, len);
+     }
+
+   free(candidates);
+}
+
+static void
+_stripes_deflate(void         *data,
+                 unsigned int  start,
+                 unsigned int  end)
+{
+   Png_Job *const job = data;
+   const unsigned char *in;
+   Stripe *stripe;
+   unsigned int i, first_row, last_row;
+   size_t len, dict, offset;
+   z_stream z;
+   int status;
+
+   for (i = start; i < end; i++)
+     {
+        stripe = &(job->stripes[i]);
+        first_row = i * job->rows_per_stripe;
+        last_row = first_row + job->rows_per_stripe;
+        if (last_row > job->h) last_row = job->h;
+        offset = (size_t)first_row * job->row_size;
+        in = &(job->filtered[offset]);
+        len = (size_t)(last_row - first_row) * job->row_size;
+
+        stripe->adler = adler32(adler32(0L, Z_NULL, 0), in, len);
+
+        memset(&z, 0, sizeof(z));
+        if (deflateInit2(&z, job->level, Z_DEFLATED, -15, 8,
+                         job->strategy) != Z_OK)
+          continue;
+
+        /* Matches may reach back in the previous stripe */
+        if (i > 0)
+          {
+             dict = (offset < WINDOW_SIZE) ? offset : WINDOW_SIZE;
+             deflateSetDictionary(&z, in - dict, dict);
+          }
+
+        /* The sync flush marker (5 bytes) is not in the bound */
+        stripe->size = deflateBound(&z, len) + 16;
+        stripe->out = malloc(stripe->size);
+        if (!stripe->out)
+          {
+             deflateEnd(&z);
+             continue;
+          }
+
+        z.next_in = (Bytef *)in;
+        z.avail_in = len;
+        z.next_out = stripe->out;
+        z.avail_out = stripe->size;
+        status = deflate(&z, (i == job->stripes_count - 1) ? Z_FINISH : Z_SYNC_FLUSH);
+        /* Output is complete if it did not fill the buffer */
+        if (((status == Z_OK) || (status == Z_STREAM_END)) &&
+            (z.avail_in == 0) && (z.avail_out > 0))
+          {
+             stripe->size -= z.avail_out;
+             stripe->ok = PUD_TRUE;
+          }
+        deflateEnd(&z);
+     }
+}
+
+static void
+_be32_store(unsigned char *p,
+            uint32_t       v)
+{
+   p[0] = v >> 24;
+   p[1] = v >> 16;
+   p[2] = v >> 8;
+   p[3] = v;
+}
+
+/* Writes a chunk whose data is made of two pieces, either of which may
+ * be empty */
+static Pud_Bool
+_chunk_write(FILE                *f,
+             const char          *type,
+             const unsigned char *data,
+             size_t               size,
+             const unsigned char *data2,
+             size_t               size2)
+{
+   unsigned char buf[4];
+   uLong crc;
+
+   _be32_store(buf, size + size2);
+   if (fwrite(buf, 4, 1, f) != 1) return PUD_FALSE;
+   if (fwrite(type, 4, 1, f) != 1) return PUD_FALSE;
+   crc = crc32(crc32(0L, Z_NULL, 0), (const Bytef *)type, 4);
+   if (size > 0)
+     {
+        if (fwrite(data, size, 1, f) != 1) return PUD_FALSE;
+        crc = crc32(crc, data, size);
+     }
+   if (size2 > 0)
+     {
+        if (fwrite(data2, size2, 1, f) != 1) return PUD_FALSE;
+        crc = crc32(crc, data2, size2);
+     }
+   _be32_store(buf, crc);
+   return (fwrite(buf, 4, 1, f) == 1) ? PUD_TRUE : PUD_FALSE;
+}
+
+static Pud_Bool
+_png_job_write(const Png_Job *job,
+               FILE          *f)
+{
+   static const unsigned char signature[8] = {
+      0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'
+   };
+   unsigned char ihdr[13], zhdr[2], adler[4];
+   unsigned int i, flevel;
+   uLong sum;
+   size_t len;
+
+   if (fwrite(signature, sizeof(signature), 1, f) != 1) return PUD_FALSE;
+
+   _be32_store(&(ihdr[0]), job->w);
+   _be32_store(&(ihdr[4]), job->h);
+   ihdr[8] = 8; /* Bit depth */
+   ihdr[9] = 6; /* RGBA */
+   ihdr[10] = ihdr[11] = ihdr[12] = 0; /* Deflate, filters, no interlace */
+   if (!_chunk_write(f, "IHDR", ihdr, sizeof(ihdr), NULL, 0)) return PUD_FALSE;
+
+   /* zlib header: 32 KiB window, level hint, and check bits */
+   if ((job->level >= 0) && (job->level <= 1)) flevel = 0;
+   else if ((job->level >= 2) && (job->level <= 5)) flevel = 1;
+   else if ((job->level == 6) || (job->level < 0)) flevel = 2;
+   else flevel = 3;
+   zhdr[0] = 0x78;
+   zhdr[1] = flevel << 6;
+   zhdr[1] += 31 - ((zhdr[0] << 8) | zhdr[1]) % 31;
+
+   /* One IDAT per stripe. The zlib header goes with the first one, the
+    * checksum of the whole stream with the last one */
+   sum = job->stripes[0].adler;
+   len = (size_t)job->rows_per_stripe * job->row_size;
+   for (i = 1; i < job->stripes_count; i++)
+     {
+        if (i == job->stripes_count - 1)
+          len = (size_t)(job->h - i * job->rows_per_stripe) * job->row_size;
+        sum = adler32_combine(sum, job->stripes[i].adler, len);
+     }
+   _be32_store(adler, sum);
+
+   for (i = 0; i < job->stripes_count; i++)
+     {
+        if (!_chunk_write(f, "IDAT",
+                          (i == 0) ? zhdr : NULL, (i == 0) ? 2 : 0,
+                          job->stripes[i].out, job->stripes[i].size))
+          return PUD_FALSE;
+     }
+   if (!_chunk_write(f, "IDAT", adler, 4, NULL, 0)) return PUD_FALSE;
+
+   return _chunk_write(f, "IEND", NULL, 0, NULL, 0);
+}
+
+#endif /* HAVE_PNG */
+
+PUDAPI Pud_Bool
+war2_png_parallel_write(const char             *file,
+                        unsigned int            w,
+                        unsigned int            h,
+                        const unsigned char    *data,
+                        const War2_Png_Options *opts)
+{
+#if HAVE_PNG
+   War2_Png_Options defaults;
+   Png_Job job;
+   FILE *f = NULL;
+   Pud_Bool ret = PUD_FALSE;
+   unsigned int i;
+
+   if ((!file) || (!data)) DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+   if ((w == 0) || (h == 0)) DIE_RETURN(PUD_FALSE, "Empty image");
+   if (!opts)
+     {
+        war2_png_options_init(&defaults, WAR2_PNG_PROFILE_DEFAULT);
+        opts = &defaults;
+     }
+
+   memset(&job, 0, sizeof(job));
+   job.pixels = data;
+   job.w = w;
+   job.h = h;
+   job.row_size = 1 + (size_t)w * BPP;
+   if ((opts->compression_level < -1) || (opts->compression_level > 9))
+     DIE_RETURN(PUD_FALSE, "Invalid compression level %i", opts->compression_level);
+   job.level = opts->compression_level;
+
+   switch (opts->filter)
+     {
+      case WAR2_PNG_FILTER_NONE:     job.filter = 0; break;
+      case WAR2_PNG_FILTER_SUB:      job.filter = 1; break;
+      case WAR2_PNG_FILTER_PAETH:    job.filter = 4; break;
+      case WAR2_PNG_FILTER_DEFAULT:
+      case WAR2_PNG_FILTER_ADAPTIVE: job.filter = -1; break;
+      default: DIE_RETURN(PUD_FALSE, "Invalid filter %i", opts->filter);
+     }
+   switch (opts->strategy)
+     {
+      case WAR2_PNG_STRATEGY_DEFAULT:
+         /* As libpng does, filtered rows are better matched with short
+          * strings */
+         job.strategy = (job.filter == 0) ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+         break;
+      case WAR2_PNG_STRATEGY_FILTERED:     job.strategy = Z_FILTERED; break;
+      case WAR2_PNG_STRATEGY_HUFFMAN_ONLY: job.strategy = Z_HUFFMAN_ONLY; break;
+      case WAR2_PNG_STRATEGY_RLE:          job.strategy = Z_RLE; break;
+      default: DIE_RETURN(PUD_FALSE, "Invalid strategy %i", opts->strategy);
+     }
+
+   job.rows_per_stripe = STRIPE_SIZE / job.row_size;
+   if (job.rows_per_stripe == 0) job.rows_per_stripe = 1;
+   job.stripes_count = (h + job.rows_per_stripe - 1) / job.rows_per_stripe;
+
+   job.filtered = malloc((size_t)h * job.row_size);
+   job.stripes = calloc(job.stripes_count, sizeof(Stripe));
+   job.zeros = calloc(1, job.row_size);
+   if ((!job.filtered) || (!job.stripes) || (!job.zeros))
+     DIE_GOTO(end, "Failed to allocate memory");
+
+   war2_parallel_for(h, 16, _rows_filter, &job);
+   if (war2_parallel_flag_get(&(job.failed))) goto end;
+   war2_parallel_for(job.stripes_count, 1, _stripes_deflate, &job);
+   for (i = 0; i < job.stripes_count; i++)
+     if (!job.stripes[i].ok)
+       DIE_GOTO(end, "Failed to compress stripe %u", i);
+
+   f = fopen(file, "wb");
+   if (!f) DIE_GOTO(end, "Failed to open [%s]", file);
+   ret = _png_job_write(&job, f);
+   if (fclose(f) != 0) ret = PUD_FALSE;
+   if (!ret) ERR("Failed to write [%s]", file);
+
+end:
+   if (job.stripes)
+     {
+        for (i = 0; i < job.stripes_count; i++)
+          free(job.stripes[i].out);
+        free(job.stripes);
+     }
+   free(job.filtered);
+   free(job.zeros);
+   return ret;
+#else
+   (void) file;
+   (void) w;
+   (void) h;
+   (void) data;
+   (void) opts;
+   DIE_RETURN(PUD_FALSE, "PNG support is not available");
+#endif
+}
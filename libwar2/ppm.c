@@ -20,21 +20,63 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-#include "war2.h"
+#include "war2_private.h"
 #include <inttypes.h>
 
-PUDAPI Pud_Bool
-war2_ppm_write(const char          *file,
+/* Pixels converted from RGBA to RGB at once before being written */
+#define PPM_BLOCK_PIXELS 4096
+
+static Pud_Bool
+_ppm_p6_write(FILE                *f,
+              unsigned int         w,
+              unsigned int         h,
+              const unsigned char *data)
+{
+   unsigned char block[PPM_BLOCK_PIXELS * 3];
+   const size_t size = (size_t)w * h;
+   size_t i, k, count;
+   unsigned char *p;
+
+   fprintf(f, "P6\n%u %u\n255\n", w, h);
+   for (i = 0; i < size; i += count)
+     {
+        count = size - i;
+        if (count > PPM_BLOCK_PIXELS) count = PPM_BLOCK_PIXELS;
+
+        for (k = 0, p = block; k < count; k++, p += 3, data += 4)
+          {
+             p[0] = data[0];
+             p[1] = data[1];
+             p[2] = data[2];
+          }
+        if (fwrite(block, 3, count, f) != count)
+          return PUD_FALSE;
+     }
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_ppm_pam_write(FILE                *f,
                unsigned int         w,
                unsigned int         h,
                const unsigned char *data)
 {
-   const unsigned int size = w * h * 4u;
-   FILE *f;
-   unsigned int i;
+   const size_t size = (size_t)w * h;
+
+   /* Pixels are already stored as PAM expects them */
+   fprintf(f, "P7\nWIDTH %u\nHEIGHT %u\nDEPTH 4\nMAXVAL 255\n"
+           "TUPLTYPE RGB_ALPHA\nENDHDR\n", w, h);
+   return (fwrite(data, 4, size, f) == size) ? PUD_TRUE : PUD_FALSE;
+}
 
-   f = fopen(file, "w+");
-   if (f == NULL) return PUD_FALSE;
+static Pud_Bool
+_ppm_p3_write(FILE                *f,
+              unsigned int         w,
+              unsigned int         h,
+              const unsigned char *data)
+{
+   const size_t size = (size_t)w * h * 4u;
+   size_t i;
 
    fprintf(f, "P3\n%u %u\n255\n", w, h);
    for (i = 0; i < size; i += 4)
@@ -42,8 +84,43 @@ war2_ppm_write(const char          *file,
         fprintf(f, "%" PRIu8 " %" PRIu8 " %" PRIu8 "\n",
                 data[i], data[i + 1], data[i + 2]);
      }
+   return PUD_TRUE;
+}
 
-   fclose(f);
+PUDAPI Pud_Bool
+war2_ppm_format_write(const char          *file,
+                      unsigned int         w,
+                      unsigned int         h,
+                      const unsigned char *data,
+                      War2_Ppm_Format      format)
+{
+   FILE *f;
+   Pud_Bool ret;
 
-   return PUD_TRUE;
+   f = fopen(file, "wb");
+   if (f == NULL) DIE_RETURN(PUD_FALSE, "Failed to open [%s]", file);
+
+   switch (format)
+     {
+      case WAR2_PPM_FORMAT_P6:  ret = _ppm_p6_write(f, w, h, data); break;
+      case WAR2_PPM_FORMAT_PAM: ret = _ppm_pam_write(f, w, h, data); break;
+      case WAR2_PPM_FORMAT_P3:  ret = _ppm_p3_write(f, w, h, data); break;
+      default:
+         ret = PUD_FALSE;
+         ERR("Invalid PPM format %i", format);
+         break;
+     }
+
+   if ((ferror(f)) || (fclose(f) != 0))
+     DIE_RETURN(PUD_FALSE, "Failed to write [%s]", file);
+   return ret;
+}
+
+PUDAPI Pud_Bool
+war2_ppm_write(const char          *file,
+               unsigned int         w,
+               unsigned int         h,
+               const unsigned char *data)
+{
+   return war2_ppm_format_write(file, w, h, data, WAR2_PPM_FORMAT_P6);
 }
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+#define PYRAMID_TILE      WAR2_MAP_PYRAMID_TILE_SIZE
+#define PYRAMID_TOP       (WAR2_MAP_PYRAMID_LEVELS - 1) /* 32 px per tile */
+#define PYRAMID_MINIMAP   1 /* Levels up to this one use the minimap */
+
+typedef struct
+{
+   unsigned int  w; /* Size of the image of the level */
+   unsigned int  h;
+   unsigned int  tiles_x;
+   unsigned int  tiles_y; /* Row of tiles being accumulated */
+   unsigned int  rows; /* Rows accumulated */
+   Pud_Color    *buf; /* PYRAMID_TILE rows */
+} Level;
+
+typedef struct
+{
+   Level                  levels[WAR2_MAP_PYRAMID_LEVELS];
+   War2_Map_Pyramid_Func  func;
+   void                  *data;
+   Pud_Color             *scratch[2];
+   Pud_Bool               failed;
+
+   unsigned int           flushed; /* Level being flushed */
+} Pyramid;
+
+/*
+ * Average of 4 RGBA pixels, rounded. Two channels are processed at once
+ * in each half of a 32-bits word: the sum of 4 channels fits in 16 bits.
+ */
+static inline uint32_t
+_avg4(uint32_t a,
+      uint32_t b,
+      uint32_t c,
+      uint32_t d)
+{
+   const uint32_t m = 0x00ff00ff, round = 0x00020002;
+   uint32_t lo, hi;
+
+   lo = (a & m) + (b & m) + (c & m) + (d & m) + round;
+   hi = ((a >> 8) & m) + ((b >> 8) & m) + ((c >> 8) & m) + ((d >> 8) & m) + round;
+   return ((lo >> 2) & m) | (((hi >> 2) & m) << 8);
+}
+
+static inline uint32_t
+_pixel_load(const Pud_Color *px)
+{
+   uint32_t v;
+   memcpy(&v, px, sizeof(v));
+   return v;
+}
+
+/* 2x2 box filter. w and h are the dimensions of src and must be even */
+static void
+_downsample(const Pud_Color *src,
+            unsigned int     w,
+            unsigned int     h,
+            Pud_Color       *dst)
+{
+   const Pud_Color *s0, *s1;
+   Pud_Color *d;
+   unsigned int x, y;
+   uint32_t v;
+
+   /* Pud_Color is 4 bytes, so the pixels can be loaded as words: only the
+    * position of the channels depends on the endianness, and they are
+    * all processed the same */
+   for (y = 0; y < h; y += 2)
+     {
+        s0 = &(src[y * w]);
+        s1 = &(src[(y + 1) * w]);
+        d = &(dst[(y / 2) * (w / 2)]);
+        for (x = 0; x < w; x += 2)
+          {
+             v = _avg4(_pixel_load(&(s0[x])), _pixel_load(&(s0[x + 1])),
+                       _pixel_load(&(s1[x])), _pixel_load(&(s1[x + 1])));
+             memcpy(&(d[x / 2]), &v, sizeof(v));
+          }
+     }
+}
+
+static void
+_tiles_emit(void         *data,
+            unsigned int  start,
+            unsigned int  end)
+{
+   Pyramid *const p = data;
+   const Level *const l = &(p->levels[p->flushed]);
+   Pud_Color *tile;
+   unsigned int tx, row, w;
+
+   tile = malloc(PYRAMID_TILE * PYRAMID_TILE * sizeof(Pud_Color));
+   if (!tile)
+     {
+        ERR("Failed to allocate memory");
+        war2_parallel_flag_set(&(p->failed));
+        return;
+     }
+
+   /* Tiles on the right and bottom edges are padded with transparent
+    * pixels */
+   for (tx = start; tx < end; tx++)
+     {
+        w = l->w - (tx * PYRAMID_TILE);
+        if (w > PYRAMID_TILE) w = PYRAMID_TILE;
+        memset(tile, 0, PYRAMID_TILE * PYRAMID_TILE * sizeof(Pud_Color));
+        for (row = 0; row < l->rows; row++)
+          memcpy(&(tile[row * PYRAMID_TILE]),
+                 &(l->buf[(row * l->w) + (tx * PYRAMID_TILE)]),
+                 w * sizeof(Pud_Color));
+
+        if (!p->func(p->data, tile, p->flushed, tx, l->tiles_y))
+          war2_parallel_flag_set(&(p->failed));
+     }
+
+   free(tile);
+}
+
+static void
+_level_flush(Pyramid      *p,
+             unsigned int  z)
+{
+   Level *const l = &(p->levels[z]);
+
+   if (l->rows == 0) return;
+
+   /* Tiles of a row are independent, and are emitted in parallel */
+   p->flushed = z;
+   war2_parallel_for(l->tiles_x, 1, _tiles_emit, p);
+   l->tiles_y++;
+   l->rows = 0;
+}
+
+static void
+_level_push(Pyramid         *p,
+            unsigned int     z,
+            const Pud_Color *rows,
+            unsigned int     count)
+{
+   Level *const l = &(p->levels[z]);
+   unsigned int n;
+
+   while (count > 0)
+     {
+        n = PYRAMID_TILE - l->rows;
+        if (n > count) n = count;
+        memcpy(&(l->buf[l->rows * l->w]), rows, n * l->w * sizeof(Pud_Color));
+        l->rows += n;
+        rows += n * l->w;
+        count -= n;
+        if (l->rows == PYRAMID_TILE) _level_flush(p, z);
+     }
+}
+
+static Pud_Bool
+_band_cb(void            *data,
+         const Pud_Color *band,
+         unsigned int     y,
+         unsigned int     w,
+         unsigned int     h)
+{
+   Pyramid *const p = data;
+   const Pud_Color *src = band;
+   Pud_Color *dst;
+   unsigned int z, i = 0;
+
+   (void) y;
+
+   /* Bands are one tile high: each level is made of one row of tiles
+    * half the size of the level above */
+   _level_push(p, PYRAMID_TOP, band, h);
+   for (z = PYRAMID_TOP; z > PYRAMID_MINIMAP + 1; z--, i ^= 1)
+     {
+        dst = p->scratch[i];
+        _downsample(src, w, h, dst);
+        w /= 2;
+        h /= 2;
+        _level_push(p, z - 1, dst, h);
+        src = dst;
+     }
+
+   return !war2_parallel_flag_get(&(p->failed));
+}
+
+static Pud_Bool
+_minimap_levels(Pyramid   *p,
+                const Pud *pud)
+{
+   Pud_Color *minimap, *scaled = NULL;
+   unsigned int z;
+   Pud_Bool ret = PUD_FALSE;
+
+   /* At these levels, tiles are too small for their details to matter.
+    * The minimap colors are used instead, as in the game. */
+   minimap = (Pud_Color *)pud_minimap_bitmap_generate(pud, NULL, PUD_PIXEL_FORMAT_RGBA);
+   if (!minimap) DIE_RETURN(PUD_FALSE, "Failed to generate minimap");
+   scaled = malloc(pud->tiles * (1 << (2 * PYRAMID_MINIMAP)) * sizeof(Pud_Color));
+   if (!scaled) DIE_GOTO(end, "Failed to allocate memory");
+
+   for (z = 0; z <= PYRAMID_MINIMAP; z++)
+     {
+        if (!war2_scale_rgba(minimap, pud->map_w, pud->map_h, scaled,
+                             1 << z, WAR2_SCALER_NEAREST))
+          goto end;
+        _level_push(p, z, scaled, p->levels[z].h);
+        _level_flush(p, z);
+     }
+   ret = !war2_parallel_flag_get(&(p->failed));
+
+end:
+   free(scaled);
+   free(minimap);
+   return ret;
+}
+
+PUDAPI Pud_Bool
+war2_map_pyramid(War2_Data             *w2,
+                 const Pud             *pud,
+                 War2_Map_Pyramid_Func  func,
+                 void                  *data)
+{
+   Pyramid p;
+   Level *l;
+   unsigned int z;
+   Pud_Bool ret = PUD_FALSE;
+
+   if ((!w2) || (!pud) || (!func))
+     DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+
+   memset(&p, 0, sizeof(p));
+   p.func = func;
+   p.data = data;
+
+   for (z = 0; z < WAR2_MAP_PYRAMID_LEVELS; z++)
+     {
+        l = &(p.levels[z]);
+        l->w = pud->map_w << z;
+        l->h = pud->map_h << z;
+        l->tiles_x = (l->w + PYRAMID_TILE - 1) / PYRAMID_TILE;
+        l->buf = malloc(l->w * PYRAMID_TILE * sizeof(Pud_Color));
+        if (!l->buf) DIE_GOTO(end, "Failed to allocate memory");
+     }
+   for (z = 0; z < 2; z++)
+     {
+        p.scratch[z] = malloc((pud->map_w * 16) * 16 * sizeof(Pud_Color));
+        if (!p.scratch[z]) DIE_GOTO(end, "Failed to allocate memory");
+     }
+
+   /* The map is rendered once at full resolution. Lower levels are
+    * built from it as the bands come */
+   if (!war2_map_render(w2, pud, _band_cb, &p))
+     DIE_GOTO(end, "Failed to render map");
+   for (z = PYRAMID_MINIMAP + 1; z < WAR2_MAP_PYRAMID_LEVELS; z++)
+     _level_flush(&p, z);
+   if (!_minimap_levels(&p, pud))
+     goto end;
+
+   ret = !war2_parallel_flag_get(&(p.failed));
+
+end:
+   for (z = 0; z < WAR2_MAP_PYRAMID_LEVELS; z++)
+     free(p.levels[z].buf);
+   free(p.scratch[0]);
+   free(p.scratch[1]);
+   return ret;
+}
+
+static Pud_Bool
+_png_tile_cb(void            *data,
+             const Pud_Color *tile,
+             unsigned int     z,
+             unsigned int     x,
+             unsigned int     y)
+{
+   char path[4096];
+   int len;
+
+   len = snprintf(path, sizeof(path), "%s_%u_%u_%u.png",
+                  (const char *)data, z, x, y);
+   if ((len < 0) || ((size_t)len >= sizeof(path)))
+     DIE_RETURN(PUD_FALSE, "Path is too long");
+
+   return war2_png_write(path, PYRAMID_TILE, PYRAMID_TILE,
+                         (const unsigned char *)tile);
+}
+
+PUDAPI Pud_Bool
+war2_map_pyramid_png(War2_Data  *w2,
+                     const Pud  *pud,
+                     const char *prefix)
+{
+   if (!prefix) DIE_RETURN(PUD_FALSE, "NULL prefix");
+   return war2_map_pyramid(w2, pud, _png_tile_cb, (void *)prefix);
+}
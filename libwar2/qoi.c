@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * The "Quite OK Image" format (https://qoiformat.org). Pixels are
+ * encoded as runs, references to recently seen colors, or small
+ * differences with the previous pixel. It compresses nearly as well as
+ * a fast PNG, at a fraction of its cost.
+ */
+
+#include "war2_private.h"
+
+#define QOI_OP_INDEX 0x00 /* 00xxxxxx */
+#define QOI_OP_DIFF  0x40 /* 01xxxxxx */
+#define QOI_OP_LUMA  0x80 /* 10xxxxxx */
+#define QOI_OP_RUN   0xc0 /* 11xxxxxx */
+#define QOI_OP_RGB   0xfe
+#define QOI_OP_RGBA  0xff
+#define QOI_MASK_2   0xc0
+
+#define QOI_HEADER_SIZE 14
+#define QOI_RUN_MAX 62
+#define QOI_PIXELS_MAX 400000000u
+
+/* Worst case of a pixel: QOI_OP_RGBA */
+#define QOI_PIXEL_MAX_SIZE 5
+
+/* Worst case of a row: a run carried from the previous row, then only
+ * QOI_OP_RGBA chunks */
+#define QOI_ROW_MAX_SIZE(W) (1 + (size_t)(W) * QOI_PIXEL_MAX_SIZE)
+
+/* End of the stream: the pending run and the padding */
+#define QOI_END_MAX_SIZE (1 + sizeof(_qoi_padding))
+
+/* Encoded data is given to the output by chunks of at least this size */
+#define QOI_OUTPUT_SIZE (64 * 1024)
+
+#define QOI_HASH(C) (((C).r * 3 + (C).g * 5 + (C).b * 7 + (C).a * 11) % 64)
+
+static const unsigned char _qoi_padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+struct _War2_Qoi_Stream
+{
+   War2_Image_Write_Func  func;
+   void                  *data;
+   unsigned int           w;
+   unsigned int           h;
+   unsigned int           rows;
+   Pud_Color              index[64]; /* Previously seen colors */
+   Pud_Color              prev;
+   unsigned int           run;
+   Pud_Bool               failed;
+
+   unsigned char         *out;
+   size_t                 out_len;
+   size_t                 out_size;
+};
+
+static inline Pud_Bool
+_color_eq(Pud_Color a,
+          Pud_Color b)
+{
+   return ((a.r == b.r) && (a.g == b.g) && (a.b == b.b) && (a.a == b.a))
+      ? PUD_TRUE : PUD_FALSE;
+}
+
+static inline void
+_be32_write(unsigned char *p,
+            uint32_t       v)
+{
+   p[0] = (v >> 24) & 0xff;
+   p[1] = (v >> 16) & 0xff;
+   p[2] = (v >> 8) & 0xff;
+   p[3] = v & 0xff;
+}
+
+static inline uint32_t
+_be32_read(const unsigned char *p)
+{
+   return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+          ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static Pud_Bool
+_qoi_size_is_valid(unsigned int w,
+                   unsigned int h)
+{
+   return ((w > 0) && (h > 0) && ((uint64_t)w * h <= QOI_PIXELS_MAX))
+      ? PUD_TRUE : PUD_FALSE;
+}
+
+static Pud_Bool
+_qoi_flush(War2_Qoi_Stream *s)
+{
+   if ((s->out_len > 0) && (!s->failed) &&
+       (!s->func(s->data, s->out, s->out_len)))
+     s->failed = PUD_TRUE;
+   s->out_len = 0;
+   return (s->failed) ? PUD_FALSE : PUD_TRUE;
+}
+
+PUDAPI_INTERNAL War2_Qoi_Stream *
+war2_qoi_stream_new(War2_Image_Write_Func  func,
+                    void                  *data,
+                    unsigned int           w,
+                    unsigned int           h)
+{
+   War2_Qoi_Stream *s;
+   unsigned char *p;
+
+   if (!_qoi_size_is_valid(w, h))
+     DIE_RETURN(NULL, "Invalid image size %ux%u", w, h);
+
+   s = calloc(1, sizeof(War2_Qoi_Stream));
+   if (!s) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   /* A whole row, or the end of the stream, always fits in the output
+    * buffer once it has been flushed */
+   s->out_size = QOI_ROW_MAX_SIZE(w) + QOI_END_MAX_SIZE;
+   if (s->out_size < QOI_OUTPUT_SIZE) s->out_size = QOI_OUTPUT_SIZE;
+   s->out = malloc(s->out_size);
+   if (!s->out)
+     {
+        free(s);
+        DIE_RETURN(NULL, "Failed to allocate memory");
+     }
+   s->func = func;
+   s->data = data;
+   s->w = w;
+   s->h = h;
+   s->prev.a = 0xff;
+
+   p = s->out;
+   memcpy(p, "qoif", 4);
+   _be32_write(p + 4, w);
+   _be32_write(p + 8, h);
+   p[12] = 4; /* RGBA */
+   p[13] = 0; /* sRGB with linear alpha */
+   s->out_len = QOI_HEADER_SIZE;
+
+   return s;
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_qoi_stream_rows_write(War2_Qoi_Stream *s,
+                           const Pud_Color *rows,
+                           unsigned int     count)
+{
+   const Pud_Color *px, *end;
+   Pud_Color prev;
+   unsigned char *p;
+   unsigned int run, h, i;
+   int vr, vg, vb, vg_r, vg_b;
+
+   if (count > s->h - s->rows)
+     DIE_RETURN(PUD_FALSE, "Too many rows written (%u + %u > %u)",
+                s->rows, count, s->h);
+   if (s->failed) return PUD_FALSE;
+
+   prev = s->prev;
+   run = s->run;
+   for (i = 0; i < count; i++)
+     {
+        if (s->out_size - s->out_len < QOI_ROW_MAX_SIZE(s->w))
+          {
+             if (!_qoi_flush(s)) return PUD_FALSE;
+          }
+        p = s->out + s->out_len;
+
+        px = &(rows[(size_t)i * s->w]);
+        end = px + s->w;
+        for (; px < end; px++)
+          {
+             if (_color_eq(*px, prev))
+               {
+                  if (++run == QOI_RUN_MAX)
+                    {
+                       *(p++) = QOI_OP_RUN | (run - 1);
+                       run = 0;
+                    }
+                  continue;
+               }
+             if (run > 0)
+               {
+                  *(p++) = QOI_OP_RUN | (run - 1);
+                  run = 0;
+               }
+
+             h = QOI_HASH(*px);
+             if (_color_eq(s->index[h], *px))
+               *(p++) = QOI_OP_INDEX | h;
+             else
+               {
+                  s->index[h] = *px;
+                  if (px->a == prev.a)
+                    {
+                       vr = (signed char)(px->r - prev.r);
+                       vg = (signed char)(px->g - prev.g);
+                       vb = (signed char)(px->b - prev.b);
+                       vg_r = vr - vg;
+                       vg_b = vb - vg;
+
+                       if ((vr > -3) && (vr < 2) &&
+                           (vg > -3) && (vg < 2) &&
+                           (vb > -3) && (vb < 2))
+                         *(p++) = QOI_OP_DIFF | ((vr + 2) << 4) |
+                            ((vg + 2) << 2) | (vb + 2);
+                       else if ((vg_r > -9) && (vg_r < 8) &&
+                                (vg > -33) && (vg < 32) &&
+                                (vg_b > -9) && (vg_b < 8))
+                         {
+                            p[0] = QOI_OP_LUMA | (vg + 32);
+                            p[1] = ((vg_r + 8) << 4) | (vg_b + 8);
+                            p += 2;
+                         }
+                       else
+                         {
+                            p[0] = QOI_OP_RGB;
+                            p[1] = px->r;
+                            p[2] = px->g;
+                            p[3] = px->b;
+                            p += 4;
+                         }
+                    }
+                  else
+                    {
+                       p[0] = QOI_OP_RGBA;
+                       p[1] = px->r;
+                       p[2] = px->g;
+                       p[3] = px->b;
+                       p[4] = px->a;
+                       p += 5;
+                    }
+               }
+             prev = *px;
+          }
+        s->out_len = p - s->out;
+     }
+   s->prev = prev;
+   s->run = run;
+   s->rows += count;
+
+   return PUD_TRUE;
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_qoi_stream_close(War2_Qoi_Stream *s)
+{
+   Pud_Bool ret = PUD_FALSE;
+
+   if (!s) return PUD_FALSE;
+
+   if (s->rows == s->h)
+     {
+        if ((s->out_size - s->out_len < QOI_END_MAX_SIZE) && (!_qoi_flush(s)))
+          goto end;
+        if (s->run > 0)
+          s->out[s->out_len++] = QOI_OP_RUN | (s->run - 1);
+        memcpy(s->out + s->out_len, _qoi_padding, sizeof(_qoi_padding));
+        s->out_len += sizeof(_qoi_padding);
+        ret = _qoi_flush(s);
+     }
+   else
+     ERR("QOI stream closed after %u rows out of %u", s->rows, s->h);
+
+end:
+   free(s->out);
+   free(s);
+
+   return ret;
+}
+
+PUDAPI Pud_Bool
+war2_qoi_write(const char          *file,
+               unsigned int         w,
+               unsigned int         h,
+               const unsigned char *data)
+{
+   War2_Qoi_Stream *s;
+   Pud_Bool ret;
+   FILE *f;
+
+   if (!_qoi_size_is_valid(w, h))
+     DIE_RETURN(PUD_FALSE, "Invalid image size %ux%u", w, h);
+
+   f = fopen(file, "wb");
+   if (!f) DIE_RETURN(PUD_FALSE, "Failed to open file [%s]", file);
+
+   s = war2_qoi_stream_new(war2_image_file_write, f, w, h);
+   if (!s)
+     {
+        fclose(f);
+        return PUD_FALSE;
+     }
+   war2_qoi_stream_rows_write(s, (const Pud_Color *)data, h);
+   ret = war2_qoi_stream_close(s);
+   if (fclose(f) != 0) ret = PUD_FALSE;
+
+   return ret;
+}
+
+PUDAPI Pud_Color *
+war2_qoi_decode(const unsigned char *mem,
+                size_t               size,
+                unsigned int        *w_ret,
+                unsigned int        *h_ret)
+{
+   Pud_Color index[64];
+   Pud_Color px = { 0, 0, 0, 0xff };
+   Pud_Color *img, *out, *out_end;
+   const unsigned char *p, *end;
+   unsigned int w, h, run;
+   int vg;
+   unsigned char b;
+
+   if ((size < QOI_HEADER_SIZE + sizeof(_qoi_padding)) ||
+       (memcmp(mem, "qoif", 4) != 0))
+     DIE_RETURN(NULL, "Not a QOI image");
+   w = _be32_read(mem + 4);
+   h = _be32_read(mem + 8);
+   if (!_qoi_size_is_valid(w, h))
+     DIE_RETURN(NULL, "Invalid image size %ux%u", w, h);
+   if ((mem[12] != 3) && (mem[12] != 4))
+     DIE_RETURN(NULL, "Invalid count of channels %u", mem[12]);
+
+   img = malloc((size_t)w * h * sizeof(Pud_Color));
+   if (!img) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   memset(index, 0, sizeof(index));
+   p = mem + QOI_HEADER_SIZE;
+   end = mem + size - sizeof(_qoi_padding);
+   out = img;
+   out_end = img + (size_t)w * h;
+   while (out < out_end)
+     {
+        if (p >= end) DIE_GOTO(fail, "Truncated QOI image");
+        b = *(p++);
+
+        if (b == QOI_OP_RGB)
+          {
+             if (end - p < 3) DIE_GOTO(fail, "Truncated QOI image");
+             px.r = p[0];
+             px.g = p[1];
+             px.b = p[2];
+             p += 3;
+          }
+        else if (b == QOI_OP_RGBA)
+          {
+             if (end - p < 4) DIE_GOTO(fail, "Truncated QOI image");
+             px.r = p[0];
+             px.g = p[1];
+             px.b = p[2];
+             px.a = p[3];
+             p += 4;
+          }
+        else if ((b & QOI_MASK_2) == QOI_OP_INDEX)
+          px = index[b];
+        else if ((b & QOI_MASK_2) == QOI_OP_DIFF)
+          {
+             px.r += ((b >> 4) & 0x03) - 2;
+             px.g += ((b >> 2) & 0x03) - 2;
+             px.b += (b & 0x03) - 2;
+          }
+        else if ((b & QOI_MASK_2) == QOI_OP_LUMA)
+          {
+             if (p >= end) DIE_GOTO(fail, "Truncated QOI image");
+             vg = (b & 0x3f) - 32;
+             px.r += vg - 8 + ((*p >> 4) & 0x0f);
+             px.g += vg;
+             px.b += vg - 8 + (*p & 0x0f);
+             p++;
+          }
+        else /* QOI_OP_RUN */
+          {
+             run = (b & 0x3f) + 1;
+             if (run > (size_t)(out_end - out)) run = out_end - out;
+             while (run-- > 0)
+               *(out++) = px;
+             continue;
+          }
+
+        index[QOI_HASH(px)] = px;
+        *(out++) = px;
+     }
+
+   if (w_ret) *w_ret = w;
+   if (h_ret) *h_ret = h;
+   return img;
+
+fail:
+   free(img);
+   return NULL;
+}
+
+PUDAPI Pud_Color *
+war2_qoi_read(const char   *file,
+              unsigned int *w_ret,
+              unsigned int *h_ret)
+{
+   Pud_Color *img = NULL;
+   unsigned char *mem;
+   long size;
+   FILE *f;
+
+   f = fopen(file, "rb");
+   if (!f) DIE_RETURN(NULL, "Failed to open file [%s]", file);
+
+   if ((fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) < 0) ||
+       (fseek(f, 0, SEEK_SET) != 0))
+     DIE_GOTO(end, "Failed to get the size of [%s]", file);
+
+   mem = malloc(size + 1);
+   if (!mem) DIE_GOTO(end, "Failed to allocate memory");
+   if (fread(mem, 1, size, f) == (size_t)size)
+     img = war2_qoi_decode(mem, size, w_ret, h_ret);
+   else
+     ERR("Failed to read [%s]", file);
+   free(mem);
+
+end:
+   fclose(f);
+   return img;
+}
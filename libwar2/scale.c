@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+/*
+ * Kernels are written once and instanciated for palette indexes (one byte
+ * per pixel) and for RGBA pixels. Working on indexes is cheaper, and the
+ * palette can be applied on the scaled image afterwards.
+ *
+ * Scale2x and Scale3x are the EPX-like algorithms described at
+ * http://www.scale2x.it. They only compare pixels for equality, so they
+ * give the same results on indexes and on colors.
+ */
+
+/* Rows that are processed by a single thread at least */
+#define SCALE_GRAIN 16
+
+typedef struct
+{
+   const void   *src;
+   void         *dst;
+   unsigned int  w;
+   unsigned int  h;
+   unsigned int  factor;
+} Scale_Job;
+
+static inline Pud_Bool
+_eq_u8(unsigned char a, unsigned char b)
+{
+   return a == b;
+}
+
+static inline Pud_Bool
+_eq_rgba(Pud_Color a, Pud_Color b)
+{
+   return (a.r == b.r) && (a.g == b.g) && (a.b == b.b) && (a.a == b.a);
+}
+
+#define SCALE_KERNELS(Name, Type, Eq)                                         \
+static void                                                                   \
+_nearest_##Name(void *data, unsigned int start, unsigned int end)             \
+{                                                                             \
+   const Scale_Job *const job = data;                                         \
+   const Type *const src = job->src;                                          \
+   Type *const dst = job->dst;                                                \
+   const unsigned int f = job->factor, dw = job->w * f;                       \
+   unsigned int x, y, k;                                                      \
+   Type *row;                                                                 \
+                                                                              \
+   for (y = start; y < end; y++)                                              \
+     {                                                                        \
+        row = &(dst[(y * f) * dw]);                                           \
+        for (x = 0; x < job->w; x++)                                          \
+          for (k = 0; k < f; k++)                                             \
+            row[(x * f) + k] = src[(y * job->w) + x];                         \
+        /* Other rows of the block are copies of the first one */            \
+        for (k = 1; k < f; k++)                                               \
+          memcpy(&(row[k * dw]), row, dw * sizeof(Type));                     \
+     }                                                                        \
+}                                                                             \
+                                                                              \
+static void                                                                   \
+_scale2x_##Name(void *data, unsigned int start, unsigned int end)             \
+{                                                                             \
+   const Scale_Job *const job = data;                                         \
+   const Type *const src = job->src;                                          \
+   Type *const dst = job->dst;                                                \
+   const unsigned int w = job->w, h = job->h, dw = w * 2;                     \
+   const Type *above, *row, *below;                                           \
+   unsigned int x, xl, xr;                                                    \
+   unsigned int y;                                                            \
+   Type B, D, E, F, H;                                                        \
+   Type *d0, *d1;                                                             \
+                                                                              \
+   for (y = start; y < end; y++)                                              \
+     {                                                                        \
+        row = &(src[y * w]);                                                  \
+        above = (y > 0) ? row - w : row;                                      \
+        below = (y + 1 < h) ? row + w : row;                                  \
+        d0 = &(dst[(y * 2) * dw]);                                            \
+        d1 = d0 + dw;                                                         \
+        for (x = 0; x < w; x++)                                               \
+          {                                                                   \
+             xl = (x > 0) ? x - 1 : x;                                        \
+             xr = (x + 1 < w) ? x + 1 : x;                                    \
+             B = above[x]; D = row[xl]; E = row[x]; F = row[xr]; H = below[x]; \
+             if ((!Eq(B, H)) && (!Eq(D, F)))                                  \
+               {                                                              \
+                  d0[x * 2]     = Eq(D, B) ? D : E;                           \
+                  d0[x * 2 + 1] = Eq(B, F) ? F : E;                           \
+                  d1[x * 2]     = Eq(D, H) ? D : E;                           \
+                  d1[x * 2 + 1] = Eq(H, F) ? F : E;                           \
+               }                                                              \
+             else                                                             \
+               {                                                              \
+                  d0[x * 2] = d0[x * 2 + 1] = E;                              \
+                  d1[x * 2] = d1[x * 2 + 1] = E;                              \
+               }                                                              \
+          }                                                                   \
+     }                                                                        \
+}                                                                             \
+                                                                              \
+static void                                                                   \
+_scale3x_##Name(void *data, unsigned int start, unsigned int end)             \
+{                                                                             \
+   const Scale_Job *const job = data;                                         \
+   const Type *const src = job->src;                                          \
+   Type *const dst = job->dst;                                                \
+   const unsigned int w = job->w, h = job->h, dw = w * 3;                     \
+   const Type *above, *row, *below;                                           \
+   unsigned int x, xl, xr;                                                    \
+   unsigned int y;                                                            \
+   Type A, B, C, D, E, F, G, H, I;                                            \
+   Type *d0, *d1, *d2;                                                        \
+                                                                              \
+   for (y = start; y < end; y++)                                              \
+     {                                                                        \
+        row = &(src[y * w]);                                                  \
+        above = (y > 0) ? row - w : row;                                      \
+        below = (y + 1 < h) ? row + w : row;                                  \
+        d0 = &(dst[(y * 3) * dw]);                                            \
+        d1 = d0 + dw;                                                         \
+        d2 = d1 + dw;                                                         \
+        for (x = 0; x < w; x++)                                               \
+          {                                                                   \
+             xl = (x > 0) ? x - 1 : x;                                        \
+             xr = (x + 1 < w) ? x + 1 : x;                                    \
+             A = above[xl]; B = above[x]; C = above[xr];                      \
+             D = row[xl];   E = row[x];   F = row[xr];                        \
+             G = below[xl]; H = below[x]; I = below[xr];                      \
+             d1[x * 3 + 1] = E;                                               \
+             if ((!Eq(B, H)) && (!Eq(D, F)))                                  \
+               {                                                              \
+                  d0[x * 3]     = Eq(D, B) ? D : E;                           \
+                  d0[x * 3 + 1] = ((Eq(D, B) && !Eq(E, C)) ||                 \
+                                   (Eq(B, F) && !Eq(E, A))) ? B : E;          \
+                  d0[x * 3 + 2] = Eq(B, F) ? F : E;                           \
+                  d1[x * 3]     = ((Eq(D, B) && !Eq(E, G)) ||                 \
+                                   (Eq(D, H) && !Eq(E, A))) ? D : E;          \
+                  d1[x * 3 + 2] = ((Eq(B, F) && !Eq(E, I)) ||                 \
+                                   (Eq(H, F) && !Eq(E, C))) ? F : E;          \
+                  d2[x * 3]     = Eq(D, H) ? D : E;                           \
+                  d2[x * 3 + 1] = ((Eq(D, H) && !Eq(E, I)) ||                 \
+                                   (Eq(H, F) && !Eq(E, G))) ? H : E;          \
+                  d2[x * 3 + 2] = Eq(H, F) ? F : E;                           \
+               }                                                              \
+             else                                                             \
+               {                                                              \
+                  d0[x * 3] = d0[x * 3 + 1] = d0[x * 3 + 2] = E;              \
+                  d1[x * 3] = d1[x * 3 + 2] = E;                              \
+                  d2[x * 3] = d2[x * 3 + 1] = d2[x * 3 + 2] = E;              \
+               }                                                              \
+          }                                                                   \
+     }                                                                        \
+}
+
+SCALE_KERNELS(u8, unsigned char, _eq_u8)
+SCALE_KERNELS(rgba, Pud_Color, _eq_rgba)
+
+static Pud_Bool
+_scale(const void          *src,
+       unsigned int         w,
+       unsigned int         h,
+       void                *dst,
+       unsigned int         factor,
+       War2_Scaler          scaler,
+       size_t               pixel_size,
+       War2_Parallel_Func   nearest,
+       War2_Parallel_Func   scale2x,
+       War2_Parallel_Func   scale3x)
+{
+   Scale_Job job;
+   void *tmp;
+
+   if ((!src) || (!dst)) DIE_RETURN(PUD_FALSE, "Invalid NULL image");
+   if (factor == 0) DIE_RETURN(PUD_FALSE, "Invalid scaling factor 0");
+
+   job.src = src;
+   job.dst = dst;
+   job.w = w;
+   job.h = h;
+   job.factor = factor;
+
+   switch (scaler)
+     {
+      case WAR2_SCALER_NEAREST:
+         war2_parallel_for(h, SCALE_GRAIN, nearest, &job);
+         break;
+
+      case WAR2_SCALER_SCALE2X:
+         switch (factor)
+           {
+            case 1:
+               memcpy(dst, src, (size_t)w * h * pixel_size);
+               break;
+
+            case 2:
+               war2_parallel_for(h, SCALE_GRAIN, scale2x, &job);
+               break;
+
+            case 3:
+               war2_parallel_for(h, SCALE_GRAIN, scale3x, &job);
+               break;
+
+            case 4:
+               /* Scale4x is Scale2x applied twice */
+               tmp = malloc((size_t)w * h * 4 * pixel_size);
+               if (!tmp) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+               job.dst = tmp;
+               war2_parallel_for(h, SCALE_GRAIN, scale2x, &job);
+               job.src = tmp;
+               job.dst = dst;
+               job.w = w * 2;
+               job.h = h * 2;
+               war2_parallel_for(h * 2, SCALE_GRAIN, scale2x, &job);
+               free(tmp);
+               break;
+
+            default:
+               DIE_RETURN(PUD_FALSE, "Scale2x does not support factor %u", factor);
+           }
+         break;
+
+      default:
+         DIE_RETURN(PUD_FALSE, "Invalid scaler %i", scaler);
+     }
+
+   return PUD_TRUE;
+}
+
+PUDAPI Pud_Bool
+war2_scale_indexed(const unsigned char *src,
+                   unsigned int         w,
+                   unsigned int         h,
+                   unsigned char       *dst,
+                   unsigned int         factor,
+                   War2_Scaler          scaler)
+{
+   return _scale(src, w, h, dst, factor, scaler, sizeof(unsigned char),
+                 _nearest_u8, _scale2x_u8, _scale3x_u8);
+}
+
+PUDAPI Pud_Bool
+war2_scale_rgba(const Pud_Color *src,
+                unsigned int     w,
+                unsigned int     h,
+                Pud_Color       *dst,
+                unsigned int     factor,
+                War2_Scaler      scaler)
+{
+   return _scale(src, w, h, dst, factor, scaler, sizeof(Pud_Color),
+                 _nearest_rgba, _scale2x_rgba, _scale3x_rgba);
+}
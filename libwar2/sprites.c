@@ -111,39 +111,58 @@ _sprites_colorize(Pud_Color    *sprite,
 
 
 static Pud_Bool
-_sprites_entry_parse(War2_Data                *w2,
-                     War2_Sprites_Descriptor  *ud,
-                     unsigned int              entry,
-                     War2_Sprites_Decode_Func  func,
-                     void                     *func_data)
+_sprites_buffer_parse(War2_Decoder             *dec,
+                      const unsigned char      *ptr,
+                      size_t                    size,
+                      const Pud_Color          *palette,
+                      War2_Sprites_Descriptor  *ud,
+                      War2_Sprites_Decode_Func  func,
+                      void                     *func_data)
 {
-   unsigned char *ptr;
+   const unsigned char *rows, *o, *const end = ptr + size;
    uint16_t count, i, oline, max_w, max_h;
    uint8_t x, y, w, h, c;
    uint32_t dstart;
-   size_t size, max_size;
-   unsigned int offset, l, pcount, k;
-   unsigned char *img = NULL, *pimg, *rows, *o;
-   Pud_Color *img_rgba = NULL;
-   const Pud_Color *const palette = war2_palette_get(w2, ud->era);
-
-   /* If no callback has been specified, do nothing */
-   if (!func)
-     {
-        WAR2_VERBOSE(w2, 1, "Warning: No callback specified.");
-        return PUD_TRUE;
-     }
-
-   ptr = war2_entry_extract(w2, entry, &size);
-   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to extract entry");
-
+   size_t max_size;
+   unsigned int offset, l, pcount, k, n, npix;
+   unsigned char *img, *pimg;
+   Pud_Color *img_rgba;
+   uint64_t *mask_bits;
+   War2_Sprite_Span *mask_spans;
+   War2_Sprite_Mask mask;
+   Pud_Color colorized[WAR2_PALETTE_SIZE];
+   const Pud_Bool convert = (dec->format != PUD_PIXEL_FORMAT_RGBA);
+
+   if (size < 6) DIE_RETURN(PUD_FALSE, "Sprites header is truncated");
    memcpy(&count, &(ptr[0]), sizeof(uint16_t));
    memcpy(&max_w, &(ptr[2]), sizeof(uint16_t));
    memcpy(&max_h, &(ptr[4]), sizeof(uint16_t));
+   if (size < 6 + (size_t)count * 8)
+     DIE_RETURN(PUD_FALSE, "Sprites frames headers are truncated");
 
    max_size = (size_t)max_w * (size_t)max_h;
-   img = malloc(max_size * sizeof(unsigned char));
-   img_rgba = malloc(max_size * sizeof(Pud_Color));
+   img = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_INDEXES,
+                                 max_size * sizeof(unsigned char));
+   img_rgba = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_RGBA,
+                                      max_size * sizeof(Pud_Color));
+   mask_bits = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_MASK_BITS,
+                                       WAR2_SPRITE_MASK_WORDS(max_w) * max_h * sizeof(uint64_t));
+   mask_spans = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_MASK_SPANS,
+                                        max_h * sizeof(War2_Sprite_Span));
+   if ((!img) || (!img_rgba) || (!mask_bits) || (!mask_spans))
+     DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   ud->mask = &mask;
+   ud->max_w = max_w;
+   ud->max_h = max_h;
+   ud->pixel_format = dec->format;
+
+   /* Other pixel formats are looked up in the colorized palette, so the
+    * frames are converted along with the palette indexes */
+   if (convert)
+     {
+        war2_sprites_palette_colorize(palette, ud->color, colorized);
+        war2_decoder_palette_set(dec, colorized);
+     }
 
    for (i = 0, offset = 6; i < count; ++i, offset += 8)
      {
@@ -153,6 +172,12 @@ _sprites_entry_parse(War2_Data                *w2,
         memcpy(&h, &(ptr[offset + 3]), sizeof(uint8_t));
         memcpy(&dstart, &(ptr[offset + 4]), sizeof(uint32_t));
 
+        if ((w > max_w) || (h > max_h))
+          DIE_GOTO(fail, "Frame %u (%ux%u) is larger than the sprite (%ux%u)",
+                   i, w, h, max_w, max_h);
+        if ((dstart > size) || (size - dstart < (size_t)h * sizeof(uint16_t)))
+          DIE_GOTO(fail, "Rows of frame %u are out of bounds", i);
+
         rows = ptr + dstart;
         pimg = img;
 
@@ -163,6 +188,7 @@ _sprites_entry_parse(War2_Data                *w2,
 
              for (pcount = 0; pcount < w;)
                {
+                  if (o >= end) DIE_GOTO(fail, "Row %u of frame %u is truncated", l, i);
                   c = *(o++);
                   /* NOTE:
                    * The order of bits examination is important and
@@ -171,41 +197,135 @@ _sprites_entry_parse(War2_Data                *w2,
                   if (c & RLE_LEAVE)
                     {
                        /* Leave (c \ RLE_LEAVE) pixels transparent */
-                       c &= 0x7f;
-                       memset(&(pimg[pcount]), 0, c);
-                       pcount += c;
+                       n = c & 0x7f;
+                       if (pcount + n > w) goto overflow;
+                       memset(&(pimg[pcount]), 0, n);
+                       pcount += n;
                     }
                   else if (c & RLE_REPEAT)
                     {
                        /* Repeat the next byte (c \ RLE_REPEAT) times as pixel value */
-                       c &= 0x3f;
-                       memset(&(pimg[pcount]), *(o++), c);
-                       pcount += c;
+                       n = c & 0x3f;
+                       if ((pcount + n > w) || (o >= end)) goto overflow;
+                       memset(&(pimg[pcount]), *(o++), n);
+                       pcount += n;
                     }
                   else
                     {
                        /* Take the next (c) bytes as pixel values */
-                       memcpy(&(pimg[pcount]), o, c);
-                       pcount += c;
-                       o += c;
+                       n = c;
+                       if ((pcount + n > w) || ((size_t)(end - o) < n)) goto overflow;
+                       memcpy(&(pimg[pcount]), o, n);
+                       pcount += n;
+                       o += n;
                     }
                }
              pimg += pcount;
           }
 
-        size = w * h;
-        for (k = 0; k < size; ++k)
+        npix = w * h;
+        for (k = 0; k < npix; ++k)
           img_rgba[k] = palette[img[k]];
 
-        _sprites_colorize(img_rgba, size, ud->color);
+        war2_sprite_mask_build(&mask, mask_bits, mask_spans, img, w, h, palette);
+        _sprites_colorize(img_rgba, npix, ud->color);
+        ud->indexes = img;
+        ud->pixels = img_rgba;
+        if (convert)
+          {
+             ud->pixels = war2_decoder_pixels_lookup(dec, img, npix);
+             if (!ud->pixels) DIE_GOTO(fail, "Failed to allocate memory");
+          }
         func(func_data, img_rgba, x, y, w, h, ud, i);
      }
 
-   free(img_rgba);
-   free(img);
-   free(ptr);
+   ud->mask = NULL;
+   ud->indexes = NULL;
+   ud->pixels = NULL;
 
    return PUD_TRUE;
+
+overflow:
+   ERR("Run of row %u of frame %u overflows the frame or the buffer", l, i);
+fail:
+   ud->mask = NULL;
+   ud->indexes = NULL;
+   ud->pixels = NULL;
+   return PUD_FALSE;
+}
+
+static Pud_Bool
+_sprites_entry_parse(War2_Data                *w2,
+                     War2_Decoder             *dec,
+                     War2_Sprites_Descriptor  *ud,
+                     unsigned int              entry,
+                     War2_Sprites_Decode_Func  func,
+                     void                     *func_data)
+{
+   const unsigned char *ptr;
+   size_t size;
+   const Pud_Color *const palette = war2_palette_get(w2, ud->era);
+
+   /* If no callback has been specified, do nothing */
+   if (!func)
+     {
+        WAR2_VERBOSE(w2, 1, "Warning: No callback specified.");
+        return PUD_TRUE;
+     }
+
+   ptr = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY, entry, &size);
+   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to extract entry");
+
+   return _sprites_buffer_parse(dec, ptr, size, palette, ud, func, func_data);
+}
+
+PUDAPI Pud_Bool
+war2_decoder_sprites_buffer_decode(War2_Decoder             *dec,
+                                   const unsigned char      *buf,
+                                   size_t                    size,
+                                   const Pud_Color          *palette,
+                                   Pud_Player                player_color,
+                                   War2_Sprites_Decode_Func  func,
+                                   void                     *data)
+{
+   War2_Sprites_Descriptor ud;
+
+   if ((!dec) || (!buf) || (!palette))
+     DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+   if (!func) return PUD_TRUE;
+
+   ud.color = player_color;
+   ud.era = PUD_ERA_FOREST;
+   ud.side = PUD_SIDE_NEUTRAL;
+   ud.object = 0;
+   ud.sprite_type = WAR2_SPRITES_UNITS;
+   ud.mask = NULL;
+   ud.indexes = NULL;
+   ud.pixels = NULL;
+
+   return _sprites_buffer_parse(dec, buf, size, palette, &ud, func, data);
+}
+
+PUDAPI Pud_Bool
+war2_decoder_sprites_decode_entry(War2_Data                *w2,
+                                  War2_Decoder             *dec,
+                                  Pud_Player                player_color,
+                                  unsigned int              entry,
+                                  War2_Sprites_Decode_Func  func,
+                                  void                     *data)
+{
+   War2_Sprites_Descriptor ud;
+
+   if (!dec) DIE_RETURN(PUD_FALSE, "NULL decoder");
+
+   ud.color = player_color;
+   ud.object = entry;
+   ud.era = PUD_ERA_FOREST;
+   ud.mask = NULL;
+   ud.indexes = NULL;
+   ud.pixels = NULL;
+
+   return _sprites_entry_parse(w2, dec, &ud, entry, func, data);
 }
 
 PUDAPI Pud_Bool
@@ -215,28 +335,33 @@ war2_sprites_decode_entry(War2_Data                *w2,
                           War2_Sprites_Decode_Func  func,
                           void                     *data)
 {
-   War2_Sprites_Descriptor ud;
+   War2_Decoder *dec;
+   Pud_Bool ret;
 
-   ud.color = player_color;
-   ud.object = entry;
-   ud.era = PUD_ERA_FOREST;
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(PUD_FALSE, "Failed to create decoder");
+   ret = war2_decoder_sprites_decode_entry(w2, dec, player_color, entry, func, data);
+   war2_decoder_free(dec);
 
-   return _sprites_entry_parse(w2, &ud, entry, func, data);
+   return ret;
 }
 
 PUDAPI Pud_Bool
-war2_sprites_decode(War2_Data                *w2,
-                    Pud_Player                player_color,
-                    Pud_Era                   era,
-                    unsigned int              object,
-                    War2_Sprites_Decode_Func  func,
-                    void                     *data)
+war2_decoder_sprites_decode(War2_Data                *w2,
+                            War2_Decoder             *dec,
+                            Pud_Player                player_color,
+                            Pud_Era                   era,
+                            unsigned int              object,
+                            War2_Sprites_Decode_Func  func,
+                            void                     *data)
 {
    War2_Sprites_Descriptor ud;
    unsigned int entry = 0;
    War2_Sprites type;
    Pud_Side side = PUD_SIDE_NEUTRAL;
 
+   if (!dec) DIE_RETURN(PUD_FALSE, "NULL decoder");
+
    if (object == WAR2_SPRITES_ICONS)
      type = WAR2_SPRITES_ICONS;
    else
@@ -419,8 +544,30 @@ war2_sprites_decode(War2_Data                *w2,
    ud.object = object;
    ud.sprite_type = type;
    ud.side = side;
+   ud.mask = NULL;
+   ud.indexes = NULL;
+   ud.pixels = NULL;
 
-   return _sprites_entry_parse(w2, &ud, entry, func, data);
+   return _sprites_entry_parse(w2, dec, &ud, entry, func, data);
+}
+
+PUDAPI Pud_Bool
+war2_sprites_decode(War2_Data                *w2,
+                    Pud_Player                player_color,
+                    Pud_Era                   era,
+                    unsigned int              object,
+                    War2_Sprites_Decode_Func  func,
+                    void                     *data)
+{
+   War2_Decoder *dec;
+   Pud_Bool ret;
+
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(PUD_FALSE, "Failed to create decoder");
+   ret = war2_decoder_sprites_decode(w2, dec, player_color, era, object, func, data);
+   war2_decoder_free(dec);
+
+   return ret;
 }
 
 PUDAPI void
@@ -462,3 +609,27 @@ no_conversion:
    *out_g = in_g;
    *out_b = in_b;
 }
+
+PUDAPI_INTERNAL int
+war2_sprites_player_shade_get(Pud_Player       player_color,
+                              const Pud_Color *color)
+{
+   unsigned int i;
+
+   for (i = 0; i < 4; ++i)
+     {
+        if (!memcmp(color, &(_colors[player_color][i]), sizeof(Col)))
+          return (int)i;
+     }
+   return -1;
+}
+
+PUDAPI void
+war2_sprites_palette_colorize(const Pud_Color *palette,
+                              Pud_Player       player_color,
+                              Pud_Color       *out)
+{
+   if (out != palette)
+     memcpy(out, palette, WAR2_PALETTE_SIZE * sizeof(Pud_Color));
+   _sprites_colorize(out, WAR2_PALETTE_SIZE, player_color);
+}
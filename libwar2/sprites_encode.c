@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+/*
+ * Colors are quantized to 6 bits per channel, which is the precision of
+ * the palettes stored in the data files. Each cell of the lookup table
+ * caches the palette index of the nearest color. Cells are computed on
+ * first use, so only the colors that actually appear in the frames cost
+ * a palette search.
+ */
+#define LUT_BITS 6
+#define LUT_SIZE (1 << (LUT_BITS * 3))
+#define LUT_UNSET 0xffff
+
+#define RLE_REPEAT (1 << 6)
+#define RLE_LEAVE  (1 << 7)
+
+#define RLE_LEAVE_MAX  0x7f
+#define RLE_REPEAT_MAX 0x3f
+#define RLE_COPY_MAX   0x3f
+#define RLE_REPEAT_MIN 3
+
+struct _War2_Sprites_Encoder
+{
+   Pud_Color palette[WAR2_PALETTE_SIZE];
+   uint16_t lut[LUT_SIZE];
+
+   /* Palette entries of the player colors. They are recolorized when
+    * decoding, so they are only selected on an exact match */
+   Pud_Bool player[WAR2_PALETTE_SIZE];
+   uint8_t shades[4];
+};
+
+PUDAPI War2_Sprites_Encoder *
+war2_sprites_encoder_new(const Pud_Color *palette)
+{
+   War2_Sprites_Encoder *enc;
+   unsigned int i;
+   int shade;
+
+   if (!palette) DIE_RETURN(NULL, "NULL palette");
+
+   enc = malloc(sizeof(War2_Sprites_Encoder));
+   if (!enc) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   memcpy(enc->palette, palette, sizeof(enc->palette));
+   for (i = 0; i < LUT_SIZE; i++)
+     enc->lut[i] = LUT_UNSET;
+
+   /* Index 0 is transparent: a shade mapped to it is missing */
+   memset(enc->shades, 0, sizeof(enc->shades));
+   for (i = 1; i < WAR2_PALETTE_SIZE; i++)
+     {
+        shade = war2_sprites_player_shade_get(PUD_PLAYER_RED, &(palette[i]));
+        enc->player[i] = (shade >= 0);
+        if ((shade >= 0) && (enc->shades[shade] == 0))
+          enc->shades[shade] = i;
+     }
+
+   return enc;
+}
+
+PUDAPI void
+war2_sprites_encoder_free(War2_Sprites_Encoder *enc)
+{
+   free(enc);
+}
+
+static uint8_t
+_nearest_find(const War2_Sprites_Encoder *enc,
+              int                         r,
+              int                         g,
+              int                         b)
+{
+   unsigned int i, best = 1, dist, best_dist = UINT32_MAX;
+   int dr, dg, db;
+
+   /* Index 0 is the transparent color: never select it */
+   for (i = 1; i < WAR2_PALETTE_SIZE; i++)
+     {
+        if (enc->player[i]) continue;
+        dr = r - enc->palette[i].r;
+        dg = g - enc->palette[i].g;
+        db = b - enc->palette[i].b;
+        dist = (dr * dr) + (dg * dg) + (db * db);
+        if (dist < best_dist)
+          {
+             best_dist = dist;
+             best = i;
+             if (dist == 0) break;
+          }
+     }
+   return best;
+}
+
+static inline uint8_t
+_color_index(War2_Sprites_Encoder *enc,
+             const Pud_Color      *c)
+{
+   const unsigned int shift = 8 - LUT_BITS;
+   const unsigned int cell =
+      ((c->r >> shift) << (LUT_BITS * 2)) |
+      ((c->g >> shift) << LUT_BITS) |
+      (c->b >> shift);
+
+   if (enc->lut[cell] == LUT_UNSET)
+     {
+        /* Search with the color of the cell, as it would be stored in
+         * a palette, so colors of the palette map to themselves */
+        enc->lut[cell] = _nearest_find(enc,
+                                       (c->r >> shift) << shift,
+                                       (c->g >> shift) << shift,
+                                       (c->b >> shift) << shift);
+     }
+   return enc->lut[cell];
+}
+
+PUDAPI uint8_t
+war2_sprites_encoder_color_index(War2_Sprites_Encoder *enc,
+                                 Pud_Player            player_color,
+                                 Pud_Color             color)
+{
+   int shade;
+
+   /* Fully transparent pixels are encoded with the transparent color */
+   if (color.a < 0x80) return 0;
+
+   /* Sprites are stored with the red player colors. Convert other players
+    * colors back to red, so the decoder colorizes them again */
+   war2_sprites_color_convert(player_color, PUD_PLAYER_RED,
+                              color.r, color.g, color.b,
+                              &color.r, &color.g, &color.b);
+   shade = war2_sprites_player_shade_get(PUD_PLAYER_RED, &color);
+   if ((shade >= 0) && (enc->shades[shade] != 0))
+     return enc->shades[shade];
+   return _color_index(enc, &color);
+}
+
+static unsigned char *
+_row_encode(unsigned char       *out,
+            const unsigned char *idx,
+            unsigned int         w)
+{
+   unsigned int x = 0, n, run, start;
+
+   while (x < w)
+     {
+        if (idx[x] == 0)
+          {
+             for (n = 1; (x + n < w) && (idx[x + n] == 0) && (n < RLE_LEAVE_MAX); n++);
+             *(out++) = RLE_LEAVE | n;
+             x += n;
+             continue;
+          }
+
+        for (run = 1; (x + run < w) && (idx[x + run] == idx[x]) &&
+             (run < RLE_REPEAT_MAX); run++);
+        if (run >= RLE_REPEAT_MIN)
+          {
+             *(out++) = RLE_REPEAT | run;
+             *(out++) = idx[x];
+             x += run;
+             continue;
+          }
+
+        /* Literals until a transparent pixel or a repetition worth a
+         * repeat run is found */
+        start = x;
+        while ((x < w) && (idx[x] != 0) && (x - start < RLE_COPY_MAX))
+          {
+             if ((x + RLE_REPEAT_MIN <= w) &&
+                 (idx[x] == idx[x + 1]) && (idx[x] == idx[x + 2]))
+               break;
+             x++;
+          }
+        n = x - start;
+        *(out++) = n;
+        memcpy(out, &(idx[start]), n);
+        out += n;
+     }
+
+   return out;
+}
+
+PUDAPI unsigned char *
+war2_sprites_encoder_encode(War2_Sprites_Encoder    *enc,
+                            Pud_Player               player_color,
+                            const War2_Sprite_Frame *frames,
+                            unsigned int             count,
+                            size_t                  *size_ret)
+{
+   const War2_Sprite_Frame *f;
+   unsigned char *mem = NULL, *ptr, *rows, *idx = NULL;
+   unsigned int i, k, l, max_w = 0, max_h = 0, max_pixels = 0;
+   size_t bound, offset, row_offset;
+   uint16_t u16;
+   uint32_t u32;
+
+   if ((!enc) || ((!frames) && (count > 0)))
+     DIE_RETURN(NULL, "Invalid NULL parameter");
+   if (count > UINT16_MAX)
+     DIE_RETURN(NULL, "Too many frames (%u)", count);
+
+   /* Validate the frames and compute an upper bound of the output size:
+    * no run encodes less than one pixel per two bytes */
+   bound = 6 + (size_t)count * 8;
+   for (i = 0; i < count; i++)
+     {
+        f = &(frames[i]);
+        if ((f->w > UINT8_MAX) || (f->h > UINT8_MAX) ||
+            (f->x > UINT8_MAX) || (f->y > UINT8_MAX))
+          DIE_RETURN(NULL, "Frame %u does not fit in the sprites format", i);
+        if ((!f->pixels) && (f->w * f->h > 0))
+          DIE_RETURN(NULL, "Frame %u has no pixels", i);
+        if (f->x + f->w > max_w) max_w = f->x + f->w;
+        if (f->y + f->h > max_h) max_h = f->y + f->h;
+        if (f->w * f->h > max_pixels) max_pixels = f->w * f->h;
+        bound += (size_t)f->h * sizeof(uint16_t) + (size_t)f->w * f->h * 2;
+     }
+
+   mem = malloc(bound);
+   idx = malloc(max_pixels + 1);
+   if ((!mem) || (!idx)) DIE_GOTO(fail, "Failed to allocate memory");
+
+   u16 = count; memcpy(&(mem[0]), &u16, sizeof(uint16_t));
+   u16 = max_w; memcpy(&(mem[2]), &u16, sizeof(uint16_t));
+   u16 = max_h; memcpy(&(mem[4]), &u16, sizeof(uint16_t));
+   offset = 6 + (size_t)count * 8;
+
+   for (i = 0; i < count; i++)
+     {
+        f = &(frames[i]);
+
+        for (k = 0; k < f->w * f->h; k++)
+          idx[k] = war2_sprites_encoder_color_index(enc, player_color, f->pixels[k]);
+
+        ptr = &(mem[6 + i * 8]);
+        ptr[0] = f->x;
+        ptr[1] = f->y;
+        ptr[2] = f->w;
+        ptr[3] = f->h;
+        u32 = offset;
+        memcpy(&(ptr[4]), &u32, sizeof(uint32_t));
+
+        /* Row offsets are relative to the start of the frame data */
+        rows = &(mem[offset]);
+        ptr = rows + f->h * sizeof(uint16_t);
+        for (l = 0; l < f->h; l++)
+          {
+             row_offset = ptr - rows;
+             if (row_offset > UINT16_MAX)
+               DIE_GOTO(fail, "Frame %u is too large to be encoded", i);
+             u16 = row_offset;
+             memcpy(&(rows[l * sizeof(uint16_t)]), &u16, sizeof(uint16_t));
+             ptr = _row_encode(ptr, &(idx[l * f->w]), f->w);
+          }
+        offset = ptr - mem;
+        if (offset > UINT32_MAX)
+          DIE_GOTO(fail, "Sprites are too large to be encoded");
+     }
+
+   free(idx);
+   if (size_ret) *size_ret = offset;
+   return mem;
+
+fail:
+   free(idx);
+   free(mem);
+   return NULL;
+}
@@ -22,78 +22,127 @@
 
 #include "war2_private.h"
 
-static void
-_tile_decode(const Pud_Color *palette,
-             War2_Tileset_Descriptor  *ts,
-             War2_Tileset_Decode_Func  func,
-             void                     *func_data,
-             unsigned char            *ptr,
-             unsigned char            *data,
-             unsigned char            *map,
-             uint16_t                  tile)
+static const unsigned int *
+_tileset_entries_get(Pud_Era era)
 {
-   /* Lookup table (flip table): 0=>7, 1=>6, 2=>5, ... 7=>0
-    * Thanks wargus for the tip. */
-   const int ft[8] = { 7, 6, 5, 4, 3, 2, 1, 0 };
-   Pud_Color img[1024];
-   int j, i_img, off, offset, o, x, y;
-   Pud_Bool flip_x, flip_y;
-   unsigned char col;
-   const Pud_Color black = { 0, 0, 0, 0xff };
+   /* Last 3 entries are unknown (cf. doc) */
+   static const unsigned int forest[] = { 3, 4, 5/*, 6, 7, 8*/ };
+   static const unsigned int wasteland[] = { 11, 12, 13/*, 14, 15, 16*/ };
+   static const unsigned int winter[] = { 19, 20, 21/*, 22, 23, 24*/ };
+   static const unsigned int swamp[] = { 439, 440, 441/*, 442, 443, 444*/ };
+
+   switch (era)
+     {
+      case PUD_ERA_FOREST:    return forest;
+      case PUD_ERA_WASTELAND: return wasteland;
+      case PUD_ERA_WINTER:    return winter;
+      case PUD_ERA_SWAMP:     return swamp;
+      default:                return NULL;
+     }
+}
 
-   off = ((tile >> 4) * 42) + ((tile & 0xf) * 2);
+PUDAPI_INTERNAL const War2_Minitiles *
+war2_tileset_minitiles_get(War2_Data    *w2,
+                           War2_Decoder *dec,
+                           Pud_Era       era)
+{
+   const unsigned int *entries;
+   const unsigned char *data;
+   const War2_Minitiles *mt;
+   size_t size;
 
-   offset = 0;
-   memcpy(&offset, &(map[off]), sizeof(uint16_t));
-   offset *= 32;
-   if (offset == 0) return;
+   entries = _tileset_entries_get(era);
+   if (!entries) DIE_RETURN(NULL, "Invalid era %i", era);
 
-   /* For each word in the block of 16 */
-   for (j = 0, i_img = 0; j < 32; j += 2, i_img++)
+   /* Minitiles are decoded once per era and kept until war2_close() */
+   WAR2_LOCK(w2);
+   if (!w2->minitiles[era])
      {
-        /* Get offset and flips */
-        o = 0;
-        memcpy(&o, &(ptr[offset + j]), sizeof(uint16_t));
-        flip_x = o & 2; // 0b10
-        flip_y = o & 1; // 0b01
-        o = (o & 0xfffc) * 16;
-
-        /* Decode a minitile (8x8) */
-        for (y = 0; y < 8; y++)
-          {
-             for (x = 0; x < 8; x++)
-               {
-                  /* If flip_x/flip_y are PUD_TRUE, the minitile must be flipped on
-                   * its x/y axis. We use a flip table which avoids calculations
-                   * to do so. */
-                  col = data[o + ((flip_x ? ft[x] : x) + (flip_y ? ft[y] : y) * 8)];
-
-                  /* Maths: we have 16 blocks of 8x8 to place in a 32x32
-                   * image which has a linear memory layout */
-                  const int xblock = x + ((i_img % 4) * 8);
-                  const int yblock = y + ((i_img / 4) * 8);
-
-                  /* Convert the byte to color thanks to the palette */
-                  img[xblock + 32 * yblock] = palette[col];
-               }
-          }
+        data = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY_AUX1,
+                                      entries[1], &size);
+        if (data)
+          w2->minitiles[era] = war2_minitiles_new(data, size,
+                                                  war2_palette_get(w2, era));
+        else
+          ERR("Failed to extract entry minitile data [%i]", entries[1]);
      }
-   if (memcmp(&(img[0]), &black, 3))
-     func(func_data, img, 32, 32, ts, tile);
+   mt = w2->minitiles[era];
+   WAR2_UNLOCK(w2);
+
+   return mt;
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_tileset_data_get(War2_Data         *w2,
+                      War2_Decoder      *dec,
+                      Pud_Era            era,
+                      War2_Tileset_Data *tsd)
+{
+   const unsigned int *entries;
+
+   entries = _tileset_entries_get(era);
+   if (!entries) DIE_RETURN(PUD_FALSE, "Invalid era %i", era);
+
+   /* Get minitiles info */
+   tsd->megatiles = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY,
+                                           entries[0], &(tsd->megatiles_size));
+   if (!tsd->megatiles)
+     DIE_RETURN(PUD_FALSE, "Failed to extract entry minitile info [%i]", entries[0]);
+   tsd->minitiles = war2_tileset_minitiles_get(w2, dec, era);
+   if (!tsd->minitiles)
+     DIE_RETURN(PUD_FALSE, "Failed to decode minitiles");
+   tsd->map = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY_AUX2,
+                                     entries[2], &(tsd->map_size));
+   if (!tsd->map)
+     DIE_RETURN(PUD_FALSE, "Failed to extract entry map [%i]", entries[2]);
+
+   return PUD_TRUE;
+}
+
+PUDAPI_INTERNAL Pud_Bool
+war2_tileset_tile_is_valid(uint16_t tile)
+{
+   /* Solid tiles are 0x010 to 0x0cf, boundaries are 0x100 to 0x9df with
+    * a minor (second nibble) up to 0xd. Fog of war is not supported. */
+   if ((tile < WAR2_TILESET_TILE_FIRST) || (tile > WAR2_TILESET_TILE_LAST))
+     return PUD_FALSE;
+   if ((tile < 0x100) ? (tile > 0xcf) : (((tile >> 4) & 0xf) > 0xd))
+     return PUD_FALSE;
+   return PUD_TRUE;
+}
+
+PUDAPI_INTERNAL const unsigned char *
+war2_tileset_megatile_get(const War2_Tileset_Data *tsd,
+                          uint16_t                 tile)
+{
+   size_t off, offset;
+
+   if (!war2_tileset_tile_is_valid(tile)) return NULL;
+
+   off = WAR2_TILESET_MAP_OFFSET(tile);
+   if (off + 2 > tsd->map_size) return NULL;
+
+   /* Megatile 0 is not used */
+   offset = (tsd->map[off] | (tsd->map[off + 1] << 8)) * 32;
+   if ((offset == 0) || (offset + 32 > tsd->megatiles_size)) return NULL;
+
+   return &(tsd->megatiles[offset]);
 }
 
 static Pud_Bool
 _ts_entries_parse(War2_Data                *w2,
+                  War2_Decoder             *dec,
                   War2_Tileset_Descriptor  *ts,
-                  const unsigned int       *entries,
                   War2_Tileset_Decode_Func  func,
                   void                     *func_data)
 {
-   unsigned char *ptr, *data, *map;
-   size_t size, map_size;
-   int tile;
-   int i, j, k;
-   const Pud_Color *const palette = war2_palette_get(w2, ts->era);
+   War2_Tileset_Data tsd;
+   const unsigned char *words;
+   Pud_Color img[1024];
+   unsigned char indexes[1024];
+   unsigned int tile;
+   const Pud_Color black = { 0, 0, 0, 0xff };
+   const Pud_Bool convert = (dec->format != PUD_PIXEL_FORMAT_RGBA);
 
    /* If no callback has been specified, do nothing */
    if (!func)
@@ -102,46 +151,32 @@ _ts_entries_parse(War2_Data                *w2,
         return PUD_TRUE;
      }
 
-   /* Get minitiles info */
-   ptr = war2_entry_extract(w2, entries[0], &size);
-   if (!ptr)
-     DIE_RETURN(PUD_FALSE, "Failed to extract entry minitile info [%i]", entries[0]);
-   data = war2_entry_extract(w2, entries[1], NULL);
-   if (!data)
-     {
-        free(ptr);
-        DIE_RETURN(PUD_FALSE, "Failed to extract entry minitile data [%i]", entries[1]);
-     }
-   map = war2_entry_extract(w2, entries[2], &map_size);
-   if (!map)
-     {
-        free(ptr);
-        free(data);
-        DIE_RETURN(PUD_FALSE, "Failed to extract entry map [%i]", entries[2]);
-     }
-   ts->tiles = size / 32;
+   if (!war2_tileset_data_get(w2, dec, ts->era, &tsd))
+     return PUD_FALSE;
+   ts->tiles = tsd.megatiles_size / 32;
+   ts->pixels = img;
+   ts->pixel_format = dec->format;
+   if (convert)
+     war2_decoder_palette_set(dec, war2_palette_get(w2, ts->era));
 
-   for (j = 0x1; j <= 0xc; j++)
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
      {
-        for (i = 0; i <= 0xf; i++)
-          {
-             tile = (j * 0x10) + i;
-             _tile_decode(palette, ts, func, func_data, ptr, data, map, tile);
-          }
-     }
+        words = war2_tileset_megatile_get(&tsd, tile);
+        if (!words) continue;
 
-   for (j = 0x1; j <= 0x9; j++)
-     {
-        for (i = 0x0; i <= 0xd; i++)
+        war2_minitiles_megatile_rgba(tsd.minitiles, words, img, 32);
+        if (!memcmp(&(img[0]), &black, 3)) continue;
+
+        /* Tiles are opaque: their palette indexes are looked up at once */
+        if (convert)
           {
-             for (k = 0x0; k <= 0xf; k++)
-               {
-                  tile = (j * 0x100) + (i * 0x10) + k;
-                  _tile_decode(palette, ts, func, func_data, ptr, data, map, tile);
-               }
+             war2_minitiles_megatile_indexes(tsd.minitiles, words, indexes, 32);
+             ts->pixels = war2_decoder_pixels_lookup(dec, indexes, 1024);
+             if (!ts->pixels) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
           }
+        func(func_data, img, 32, 32, ts, tile);
      }
-
+   ts->pixels = NULL;
 
 #if 0
    // FIXME Fog of war (16 first tiles) */
@@ -184,38 +219,315 @@ _ts_entries_parse(War2_Data                *w2,
      }
 #endif
 
-   free(ptr);
-   free(data);
-   free(map);
-
    return PUD_TRUE;
 }
 
+PUDAPI unsigned int
+war2_decoder_tileset_decode(War2_Data                *w2,
+                            War2_Decoder             *dec,
+                            Pud_Era                   era,
+                            War2_Tileset_Decode_Func  func,
+                            void                     *data)
+{
+   War2_Tileset_Descriptor ts;
+
+   if (!dec) DIE_RETURN(0, "NULL decoder");
+
+   ts.era = era;
+   ts.tiles = 0;
+   ts.pixels = NULL;
+   ts.pixel_format = war2_decoder_pixel_format_get(dec);
+
+   _ts_entries_parse(w2, dec, &ts, func, data);
+
+   return ts.tiles;
+}
+
 PUDAPI unsigned int
 war2_tileset_decode(War2_Data                *w2,
                     Pud_Era                   era,
                     War2_Tileset_Decode_Func  func,
                     void                     *data)
 {
-   /* Last 3 entries are unknown (cf. doc) */
-   const unsigned int forest[] = { 3, 4, 5/*, 6, 7, 8*/ };
-   const unsigned int wasteland[] = { 11, 12, 13/*, 14, 15, 16*/ };
-   const unsigned int winter[] = { 19, 20, 21/*, 22, 23, 24*/ };
-   const unsigned int swamp[] = { 439, 440, 441/*, 442, 443, 444*/ };
-   const unsigned int *entries;
-   War2_Tileset_Descriptor ts;
+   War2_Decoder *dec;
+   unsigned int tiles;
 
-   ts.era = era;
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(0, "Failed to create decoder");
+   tiles = war2_decoder_tileset_decode(w2, dec, era, func, data);
+   war2_decoder_free(dec);
 
-   switch (era)
+   return tiles;
+}
+
+#define EQUIV_TILES (WAR2_TILESET_TILE_LAST - WAR2_TILESET_TILE_FIRST + 1)
+#define EQUIV_BUCKETS 8192 /* Power of 2, larger than twice EQUIV_TILES */
+
+static uint64_t
+_tile_hash(const Pud_Color *img)
+{
+   const unsigned char *const bytes = (const unsigned char *)img;
+   uint64_t h = 0xcbf29ce484222325ULL; /* FNV-1a */
+   unsigned int i;
+
+   for (i = 0; i < 32 * 32 * sizeof(Pud_Color); i++)
+     h = (h ^ bytes[i]) * 0x100000001b3ULL;
+   return h;
+}
+
+/*
+ * Group the tiles that render to the same image. Tiles are hashed, and
+ * tiles with the same hash are compared to rule out collisions. The
+ * canonical tile of a group is its lowest tile ID. Must be called with
+ * the lock held.
+ */
+static Pud_Bool
+_equivalences_build(War2_Data               *w2,
+                    const War2_Tileset_Data *tsd,
+                    Pud_Era                  era)
+{
+   uint16_t *equiv = NULL, *buckets = NULL;
+   uint64_t *hashes = NULL;
+   const unsigned char *words;
+   Pud_Color img[1024], other[1024];
+   unsigned int tile, b, unique = 0;
+   uint16_t canon;
+
+   equiv = malloc(EQUIV_TILES * sizeof(uint16_t));
+   hashes = malloc(EQUIV_TILES * sizeof(uint64_t));
+   buckets = malloc(EQUIV_BUCKETS * sizeof(uint16_t));
+   if ((!equiv) || (!hashes) || (!buckets))
+     DIE_GOTO(fail, "Failed to allocate memory");
+   memset(buckets, 0xff, EQUIV_BUCKETS * sizeof(uint16_t));
+
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
      {
-      case PUD_ERA_FOREST:    entries = forest;    break;
-      case PUD_ERA_WASTELAND: entries = wasteland; break;
-      case PUD_ERA_WINTER:    entries = winter;    break;
-      case PUD_ERA_SWAMP:     entries = swamp;     break;
+        words = war2_tileset_megatile_get(tsd, tile);
+        if (!words)
+          {
+             equiv[tile - WAR2_TILESET_TILE_FIRST] = WAR2_TILESET_TILE_NONE;
+             continue;
+          }
+        war2_minitiles_megatile_rgba(tsd->minitiles, words, img, 32);
+        hashes[tile - WAR2_TILESET_TILE_FIRST] = _tile_hash(img);
+
+        /* Open addressing, buckets hold canonical tiles */
+        canon = tile;
+        for (b = hashes[tile - WAR2_TILESET_TILE_FIRST] & (EQUIV_BUCKETS - 1);
+             buckets[b] != WAR2_TILESET_TILE_NONE;
+             b = (b + 1) & (EQUIV_BUCKETS - 1))
+          {
+             if (hashes[buckets[b] - WAR2_TILESET_TILE_FIRST] !=
+                 hashes[tile - WAR2_TILESET_TILE_FIRST])
+               continue;
+             war2_minitiles_megatile_rgba(tsd->minitiles,
+                                          war2_tileset_megatile_get(tsd, buckets[b]),
+                                          other, 32);
+             if (memcmp(img, other, sizeof(img)) == 0)
+               {
+                  canon = buckets[b];
+                  break;
+               }
+          }
+        if (canon == tile)
+          {
+             buckets[b] = tile;
+             unique++;
+          }
+        equiv[tile - WAR2_TILESET_TILE_FIRST] = canon;
      }
 
-   _ts_entries_parse(w2, &ts, entries, func, data);
+   w2->equivalences[era] = equiv;
+   w2->equivalences_unique[era] = unique;
+   free(hashes);
+   free(buckets);
+   return PUD_TRUE;
 
-   return ts.tiles;
+fail:
+   free(equiv);
+   free(hashes);
+   free(buckets);
+   return PUD_FALSE;
+}
+
+/*
+ * Equivalences of an era, built once and kept until war2_close(). If tsd
+ * is NULL, only equivalences that are already built are returned.
+ */
+static const uint16_t *
+_equivalences_get(War2_Data               *w2,
+                  const War2_Tileset_Data *tsd,
+                  Pud_Era                  era,
+                  unsigned int            *unique_ret)
+{
+   const uint16_t *equiv;
+
+   WAR2_LOCK(w2);
+   if ((!w2->equivalences[era]) && (tsd))
+     _equivalences_build(w2, tsd, era);
+   equiv = w2->equivalences[era];
+   if ((equiv) && (unique_ret)) *unique_ret = w2->equivalences_unique[era];
+   WAR2_UNLOCK(w2);
+
+   return equiv;
+}
+
+PUDAPI const uint16_t *
+war2_tileset_equivalences_get(War2_Data    *w2,
+                              Pud_Era       era,
+                              unsigned int *unique)
+{
+   War2_Decoder *dec;
+   War2_Tileset_Data tsd;
+   const uint16_t *equiv = NULL;
+
+   if (!w2) DIE_RETURN(NULL, "NULL data");
+   if (!_tileset_entries_get(era)) DIE_RETURN(NULL, "Invalid era %i", era);
+   equiv = _equivalences_get(w2, NULL, era, unique);
+   if (equiv) return equiv;
+
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(NULL, "Failed to create decoder");
+   if (war2_tileset_data_get(w2, dec, era, &tsd))
+     equiv = _equivalences_get(w2, &tsd, era, unique);
+   war2_decoder_free(dec);
+
+   return equiv;
+}
+
+PUDAPI Pud_Bool
+war2_tileset_minimap_colors_get(War2_Data *w2,
+                                Pud_Era    era,
+                                uint32_t  *colors)
+{
+   War2_Decoder *dec;
+   War2_Tileset_Data tsd;
+   const unsigned char *words;
+   Pud_Color img[1024];
+   unsigned int tile, i, r, g, b;
+
+   if ((!w2) || (!colors)) DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(PUD_FALSE, "Failed to create decoder");
+   if (!war2_tileset_data_get(w2, dec, era, &tsd))
+     {
+        war2_decoder_free(dec);
+        return PUD_FALSE;
+     }
+
+   memset(colors, 0, (WAR2_TILESET_TILE_LAST + 1) * sizeof(uint32_t));
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
+     {
+        words = war2_tileset_megatile_get(&tsd, tile);
+        if (!words) continue;
+
+        /* Rounded average of the 32x32 pixels */
+        war2_minitiles_megatile_rgba(tsd.minitiles, words, img, 32);
+        r = g = b = 0;
+        for (i = 0; i < 1024; i++)
+          {
+             r += img[i].r;
+             g += img[i].g;
+             b += img[i].b;
+          }
+        colors[tile] = (((r + 512) / 1024) << 16) |
+                       (((g + 512) / 1024) << 8) |
+                        ((b + 512) / 1024);
+     }
+
+   war2_decoder_free(dec);
+   return PUD_TRUE;
+}
+
+PUDAPI War2_Tileset_Atlas *
+war2_tileset_atlas_new(War2_Data                *w2,
+                       Pud_Era                   era,
+                       War2_Tileset_Atlas_Flags  flags)
+{
+   War2_Decoder *dec;
+   War2_Tileset_Data tsd;
+   War2_Tileset_Atlas *atlas;
+   const unsigned char *words;
+   const uint16_t *equiv;
+   unsigned int tile, x, y, count = 0;
+   uint16_t canon;
+   size_t pixels;
+
+   if (!(flags & (WAR2_TILESET_ATLAS_RGBA | WAR2_TILESET_ATLAS_INDEXED)))
+     DIE_RETURN(NULL, "No atlas format requested");
+
+   dec = war2_decoder_new();
+   if (!dec) DIE_RETURN(NULL, "Failed to create decoder");
+   atlas = calloc(1, sizeof(War2_Tileset_Atlas));
+   if (!atlas) DIE_GOTO(fail, "Failed to allocate memory");
+   if (!war2_tileset_data_get(w2, dec, era, &tsd))
+     goto fail;
+
+   equiv = _equivalences_get(w2, &tsd, era, NULL);
+   if (!equiv) DIE_GOTO(fail, "Failed to find equivalent tiles");
+
+   /* The atlas holds exactly the tiles that are populated in the map.
+    * Tiles that render to the same image share a slot. */
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
+     {
+        canon = equiv[tile - WAR2_TILESET_TILE_FIRST];
+        if (canon == WAR2_TILESET_TILE_NONE)
+          atlas->slots[tile - WAR2_TILESET_TILE_FIRST] = WAR2_TILESET_ATLAS_NONE;
+        else if (canon == tile)
+          atlas->slots[tile - WAR2_TILESET_TILE_FIRST] = count++;
+        else
+          atlas->slots[tile - WAR2_TILESET_TILE_FIRST] =
+             atlas->slots[canon - WAR2_TILESET_TILE_FIRST];
+     }
+   if (count == 0) DIE_GOTO(fail, "No tiles in tileset");
+
+   atlas->era = era;
+   atlas->tiles = count;
+   atlas->w = WAR2_TILESET_ATLAS_COLUMNS * 32;
+   atlas->h = ((count + WAR2_TILESET_ATLAS_COLUMNS - 1) / WAR2_TILESET_ATLAS_COLUMNS) * 32;
+   pixels = atlas->w * atlas->h;
+
+   /* Unused slots of the last row are transparent */
+   if (flags & WAR2_TILESET_ATLAS_RGBA)
+     {
+        atlas->rgba = calloc(pixels, sizeof(Pud_Color));
+        if (!atlas->rgba) DIE_GOTO(fail, "Failed to allocate memory");
+     }
+   if (flags & WAR2_TILESET_ATLAS_INDEXED)
+     {
+        atlas->indexes = calloc(pixels, sizeof(unsigned char));
+        if (!atlas->indexes) DIE_GOTO(fail, "Failed to allocate memory");
+     }
+
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
+     {
+        if (equiv[tile - WAR2_TILESET_TILE_FIRST] != tile) continue;
+        war2_tileset_atlas_rect_get(atlas, tile, &x, &y);
+        words = war2_tileset_megatile_get(&tsd, tile);
+
+        if (atlas->rgba)
+          war2_minitiles_megatile_rgba(tsd.minitiles, words,
+                                       &(atlas->rgba[y * atlas->w + x]), atlas->w);
+        if (atlas->indexes)
+          war2_minitiles_megatile_indexes(tsd.minitiles, words,
+                                          &(atlas->indexes[y * atlas->w + x]), atlas->w);
+     }
+
+   war2_decoder_free(dec);
+   return atlas;
+
+fail:
+   war2_tileset_atlas_free(atlas);
+   war2_decoder_free(dec);
+   return NULL;
+}
+
+PUDAPI void
+war2_tileset_atlas_free(War2_Tileset_Atlas *atlas)
+{
+   if (!atlas) return;
+   free(atlas->rgba);
+   free(atlas->indexes);
+   free(atlas);
 }
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2017 Jean Guyomarc'h
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "war2_private.h"
+
+/*
+ * Minitiles and megatiles are deduplicated through hash tables, so adding
+ * a tile costs the same whatever the size of the tileset. A minitile is
+ * looked up with its four flipped variants: when a variant is already
+ * stored, the megatile word references it with the flip bits that undo
+ * the flip.
+ */
+#define MINITILES_MAX (1 << 14) /* Index is stored on 14 bits */
+#define MEGATILES_MAX (1 << 16) /* Index is stored on 16 bits */
+#define MEGATILE_SIZE (16 * sizeof(uint16_t))
+#define MAP_SIZE (WAR2_TILESET_MAP_OFFSET(WAR2_TILESET_TILE_LAST) + 2)
+#define BUCKET_EMPTY UINT32_MAX
+
+typedef struct
+{
+   unsigned char *items;
+   uint64_t      *hashes;
+   uint32_t      *buckets;
+   size_t         item_size;
+   unsigned int   count;
+   unsigned int   max; /* Allocated items */
+   unsigned int   limit; /* Items that can be referenced */
+   unsigned int   mask; /* Buckets count - 1 */
+} Pool;
+
+struct _War2_Tileset_Encoder
+{
+   War2_Sprites_Encoder *colors; /* Nearest palette colors lookups */
+   Pool                  minitiles;
+   Pool                  megatiles;
+   unsigned char         map[MAP_SIZE];
+};
+
+static uint64_t
+_hash(const unsigned char *bytes,
+      size_t               size)
+{
+   uint64_t h = 0xcbf29ce484222325ULL; /* FNV-1a */
+   size_t i;
+
+   for (i = 0; i < size; i++)
+     h = (h ^ bytes[i]) * 0x100000001b3ULL;
+   return h;
+}
+
+static Pud_Bool
+_pool_init(Pool         *pool,
+           size_t        item_size,
+           unsigned int  limit)
+{
+   pool->item_size = item_size;
+   pool->count = 0;
+   pool->max = 256;
+   pool->limit = limit;
+   pool->mask = 2 * pool->max - 1;
+   pool->items = malloc(pool->max * item_size);
+   pool->hashes = malloc(pool->max * sizeof(uint64_t));
+   pool->buckets = malloc((pool->mask + 1) * sizeof(uint32_t));
+   if ((!pool->items) || (!pool->hashes) || (!pool->buckets))
+     DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   memset(pool->buckets, 0xff, (pool->mask + 1) * sizeof(uint32_t));
+   return PUD_TRUE;
+}
+
+static void
+_pool_clear(Pool *pool)
+{
+   free(pool->items);
+   free(pool->hashes);
+   free(pool->buckets);
+}
+
+static uint32_t
+_pool_find(const Pool          *pool,
+           const unsigned char *item,
+           uint64_t             hash)
+{
+   uint32_t b, id;
+
+   for (b = hash & pool->mask; pool->buckets[b] != BUCKET_EMPTY;
+        b = (b + 1) & pool->mask)
+     {
+        id = pool->buckets[b];
+        if ((pool->hashes[id] == hash) &&
+            (!memcmp(&(pool->items[id * pool->item_size]), item, pool->item_size)))
+          return id;
+     }
+   return BUCKET_EMPTY;
+}
+
+static Pud_Bool
+_pool_grow(Pool *pool)
+{
+   unsigned char *items;
+   uint64_t *hashes;
+   uint32_t *buckets, b, i;
+   unsigned int max = pool->max * 2;
+
+   items = realloc(pool->items, max * pool->item_size);
+   if (!items) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   pool->items = items;
+   hashes = realloc(pool->hashes, max * sizeof(uint64_t));
+   if (!hashes) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   pool->hashes = hashes;
+   buckets = malloc(2 * max * sizeof(uint32_t));
+   if (!buckets) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+
+   /* Keep the buckets at most half full */
+   pool->max = max;
+   pool->mask = 2 * max - 1;
+   free(pool->buckets);
+   pool->buckets = buckets;
+   memset(buckets, 0xff, 2 * max * sizeof(uint32_t));
+   for (i = 0; i < pool->count; i++)
+     {
+        for (b = pool->hashes[i] & pool->mask; buckets[b] != BUCKET_EMPTY;
+             b = (b + 1) & pool->mask);
+        buckets[b] = i;
+     }
+   return PUD_TRUE;
+}
+
+/* Returns the ID of the item, that is added if not already in the pool */
+static uint32_t
+_pool_add(Pool                *pool,
+          const unsigned char *item,
+          uint64_t             hash)
+{
+   uint32_t b, id;
+
+   id = _pool_find(pool, item, hash);
+   if (id != BUCKET_EMPTY) return id;
+
+   if (pool->count >= pool->limit)
+     DIE_RETURN(BUCKET_EMPTY, "Too many different items (%u)", pool->limit);
+   if ((pool->count == pool->max) && (!_pool_grow(pool)))
+     return BUCKET_EMPTY;
+
+   id = pool->count++;
+   memcpy(&(pool->items[id * pool->item_size]), item, pool->item_size);
+   pool->hashes[id] = hash;
+   for (b = hash & pool->mask; pool->buckets[b] != BUCKET_EMPTY;
+        b = (b + 1) & pool->mask);
+   pool->buckets[b] = id;
+   return id;
+}
+
+PUDAPI War2_Tileset_Encoder *
+war2_tileset_encoder_new(const Pud_Color *palette)
+{
+   War2_Tileset_Encoder *enc;
+
+   if (!palette) DIE_RETURN(NULL, "NULL palette");
+
+   enc = calloc(1, sizeof(War2_Tileset_Encoder));
+   if (!enc) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   enc->colors = war2_sprites_encoder_new(palette);
+   if (!enc->colors) goto fail;
+   if ((!_pool_init(&(enc->minitiles), WAR2_MINITILE_PIXELS, MINITILES_MAX)) ||
+       (!_pool_init(&(enc->megatiles), MEGATILE_SIZE, MEGATILES_MAX)))
+     goto fail;
+
+   /* Megatile 0 is never referenced by the map. It is kept out of the
+    * buckets, so a megatile made of minitile 0 does not match it. */
+   memset(enc->megatiles.items, 0, MEGATILE_SIZE);
+   enc->megatiles.hashes[0] = 0;
+   enc->megatiles.count = 1;
+
+   return enc;
+
+fail:
+   war2_tileset_encoder_free(enc);
+   return NULL;
+}
+
+PUDAPI void
+war2_tileset_encoder_free(War2_Tileset_Encoder *enc)
+{
+   if (!enc) return;
+   war2_sprites_encoder_free(enc->colors);
+   _pool_clear(&(enc->minitiles));
+   _pool_clear(&(enc->megatiles));
+   free(enc);
+}
+
+static void
+_minitile_flip(const unsigned char *src,
+               unsigned char       *dst,
+               unsigned int         flips)
+{
+   const unsigned char *row;
+   unsigned int x, y;
+
+   /* Bit 0 flips on the Y axis, bit 1 on the X axis (cf. minitiles.c) */
+   for (y = 0; y < 8; y++, dst += 8)
+     {
+        row = &(src[((flips & 1) ? 7 - y : y) * 8]);
+        if (flips & 2)
+          for (x = 0; x < 8; x++) dst[x] = row[7 - x];
+        else
+          memcpy(dst, row, 8);
+     }
+}
+
+static Pud_Bool
+_minitile_word_get(War2_Tileset_Encoder *enc,
+                   const unsigned char  *minitile,
+                   uint16_t             *word)
+{
+   unsigned char variant[WAR2_MINITILE_PIXELS];
+   unsigned int v;
+   uint32_t id;
+
+   /* Flips are their own inverse: if the variant v of the minitile is
+    * stored, the minitile is the stored one flipped by v */
+   for (v = 0; v < WAR2_MINITILE_VARIANTS; v++)
+     {
+        _minitile_flip(minitile, variant, v);
+        id = _pool_find(&(enc->minitiles), variant,
+                        _hash(variant, WAR2_MINITILE_PIXELS));
+        if (id != BUCKET_EMPTY)
+          {
+             *word = (id << 2) | v;
+             return PUD_TRUE;
+          }
+     }
+
+   id = _pool_add(&(enc->minitiles), minitile,
+                  _hash(minitile, WAR2_MINITILE_PIXELS));
+   if (id == BUCKET_EMPTY) return PUD_FALSE;
+   *word = id << 2;
+   return PUD_TRUE;
+}
+
+PUDAPI Pud_Bool
+war2_tileset_encoder_tile_add(War2_Tileset_Encoder *enc,
+                              uint16_t              tile,
+                              const Pud_Color      *img)
+{
+   unsigned char idx[32 * 32], minitile[WAR2_MINITILE_PIXELS];
+   unsigned char megatile[MEGATILE_SIZE];
+   unsigned int i, y;
+   uint16_t word;
+   uint32_t id;
+   Pud_Color c;
+
+   if ((!enc) || (!img)) DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+   if (!war2_tileset_tile_is_valid(tile))
+     DIE_RETURN(PUD_FALSE, "Tile 0x%04x cannot be stored in a tileset", tile);
+
+   /* Tiles are opaque */
+   for (i = 0; i < 32 * 32; i++)
+     {
+        c = img[i];
+        c.a = 0xff;
+        idx[i] = war2_sprites_encoder_color_index(enc->colors, PUD_PLAYER_RED, c);
+     }
+
+   /* Minitiles are stored row by row in the megatile */
+   for (i = 0; i < 16; i++)
+     {
+        for (y = 0; y < 8; y++)
+          memcpy(&(minitile[y * 8]),
+                 &(idx[((i / 4) * 8 + y) * 32 + (i % 4) * 8]), 8);
+        if (!_minitile_word_get(enc, minitile, &word))
+          return PUD_FALSE;
+        megatile[i * 2] = word & 0xff;
+        megatile[i * 2 + 1] = word >> 8;
+     }
+
+   id = _pool_add(&(enc->megatiles), megatile, _hash(megatile, MEGATILE_SIZE));
+   if (id == BUCKET_EMPTY) return PUD_FALSE;
+
+   enc->map[WAR2_TILESET_MAP_OFFSET(tile)] = id & 0xff;
+   enc->map[WAR2_TILESET_MAP_OFFSET(tile) + 1] = id >> 8;
+   return PUD_TRUE;
+}
+
+static unsigned char *
+_dup(const void *mem,
+     size_t      size)
+{
+   unsigned char *ptr;
+
+   ptr = malloc(size);
+   if (!ptr) DIE_RETURN(NULL, "Failed to allocate memory");
+   memcpy(ptr, mem, size);
+   return ptr;
+}
+
+PUDAPI Pud_Bool
+war2_tileset_encoder_encode(War2_Tileset_Encoder *enc,
+                            War2_Tileset_Entries *entries)
+{
+   if ((!enc) || (!entries)) DIE_RETURN(PUD_FALSE, "Invalid NULL parameter");
+   if (enc->minitiles.count == 0) DIE_RETURN(PUD_FALSE, "No tiles were added");
+
+   entries->megatiles_size = enc->megatiles.count * MEGATILE_SIZE;
+   entries->minitiles_size = enc->minitiles.count * WAR2_MINITILE_PIXELS;
+   entries->map_size = MAP_SIZE;
+   entries->megatiles = _dup(enc->megatiles.items, entries->megatiles_size);
+   entries->minitiles = _dup(enc->minitiles.items, entries->minitiles_size);
+   entries->map = _dup(enc->map, entries->map_size);
+   if ((!entries->megatiles) || (!entries->minitiles) || (!entries->map))
+     {
+        free(entries->megatiles);
+        free(entries->minitiles);
+        free(entries->map);
+        memset(entries, 0, sizeof(*entries));
+        return PUD_FALSE;
+     }
+   return PUD_TRUE;
+}
@@ -22,42 +22,103 @@
 
 #include "war2_private.h"
 
+PUDAPI_INTERNAL const unsigned char *
+war2_ui_image_get(const unsigned char *ptr,
+                  size_t               size,
+                  unsigned int         entry,
+                  unsigned int        *w,
+                  unsigned int        *h)
+{
+   uint16_t width, height;
+
+   if (size < 4) DIE_RETURN(NULL, "Entry [%u] is too small", entry);
+
+   memcpy(&width, &ptr[0], sizeof(uint16_t));
+   memcpy(&height, &ptr[2], sizeof(uint16_t));
+
+   if ((size_t)width * height > size - 4)
+     DIE_RETURN(NULL, "Entry [%u] is too small for a %ux%u image",
+                entry, width, height);
+
+   *w = width;
+   *h = height;
+   return ptr + 4;
+}
+
+PUDAPI const Pud_Color *
+war2_decoder_ui_decode(War2_Data    *w2,
+                       War2_Decoder *dec,
+                       unsigned int  entry,
+                       unsigned int *w,
+                       unsigned int *h)
+{
+   const unsigned char *ptr;
+   size_t size;
+   unsigned int width, height, img_size, i;
+   Pud_Color *img;
+   const Pud_Color *const palette = war2_palette_get(w2, PUD_ERA_FOREST);
+
+   if (!dec) DIE_RETURN(NULL, "NULL decoder");
+
+   ptr = war2_decoder_entry_get(w2, dec, WAR2_DECODER_SLOT_ENTRY, entry, &size);
+   if (! ptr) DIE_RETURN(NULL, "Failed to extract entry");
+   ptr = war2_ui_image_get(ptr, size, entry, &width, &height);
+   if (! ptr) return NULL;
+
+   img_size = width * height;
+   img = war2_decoder_buffer_get(dec, WAR2_DECODER_SLOT_RGBA,
+                                 img_size * sizeof(Pud_Color));
+   if (! img) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   for (i = 0; i < img_size; i++)
+     {
+       img[i] = palette[ptr[i]];
+     }
+
+   dec->pixels = img;
+   if (dec->format != PUD_PIXEL_FORMAT_RGBA)
+     {
+        war2_decoder_palette_set(dec, palette);
+        dec->pixels = war2_decoder_pixels_lookup(dec, ptr, img_size);
+        if (! dec->pixels) DIE_RETURN(NULL, "Failed to allocate memory");
+     }
+
+   if (w) *w = width;
+   if (h) *h = height;
+   return img;
+}
+
 PUDAPI Pud_Color *
 war2_ui_decode(War2_Data *w2,
                unsigned int entry,
                unsigned int *w,
                unsigned int *h)
 {
-   unsigned char *ptr;
+   unsigned char *mem;
+   const unsigned char *ptr;
    size_t size;
-   uint16_t width, height;
-   unsigned int img_size;
-   unsigned int i;
-   Pud_Color *img;
+   unsigned int width, height, img_size, i;
+   Pud_Color *img = NULL;
    const Pud_Color *const palette = war2_palette_get(w2, PUD_ERA_FOREST);
 
-   ptr = war2_entry_extract(w2, entry, &size);
-   if (! ptr) DIE_RETURN(NULL, "Failed to extract entry");
-
-   memcpy(&width, &ptr[0], sizeof(uint16_t));
-   memcpy(&height, &ptr[2], sizeof(uint16_t));
+   /* No decoder: the image is decoded directly in the returned buffer */
+   mem = war2_entry_extract(w2, entry, &size);
+   if (! mem) DIE_RETURN(NULL, "Failed to extract entry");
+   ptr = war2_ui_image_get(mem, size, entry, &width, &height);
+   if (! ptr) goto end;
 
    img_size = width * height;
    img = malloc(img_size * sizeof(Pud_Color));
-   if (! img)
-     {
-        free(ptr);
-        DIE_RETURN(NULL, "Failed to allocate memory");
-     }
+   if (! img) DIE_GOTO(end, "Failed to allocate memory");
 
-   ptr += 4;
    for (i = 0; i < img_size; i++)
      {
-       img[i] = palette[ptr[i]]; 
+       img[i] = palette[ptr[i]];
      }
-   free(ptr - 4);
 
    if (w) *w = width;
    if (h) *h = height;
+end:
+   free(mem);
    return img;
 }
@@ -79,6 +79,7 @@ PUDAPI War2_Data *
 war2_open(const char *file)
 {
    War2_Data *w2;
+   Common_Cursor cur;
    int i;
    uint32_t l;
 
@@ -89,21 +90,19 @@ war2_open(const char *file)
    w2 = calloc(1, sizeof(War2_Data));
    if (!w2) DIE_GOTO(err, "Failed to allocate memory");
 
+#ifdef HAVE_PTHREAD
+   if (pthread_mutex_init(&(w2->lock), NULL) != 0)
+     DIE_GOTO(err_free, "Failed to create lock");
+#endif
+
    /* Map file */
    w2->mem_map = common_file_mmap(file);
-   if (!w2->mem_map) DIE_GOTO(err_free, "Failed to map file");
+   if (!w2->mem_map) DIE_GOTO(err_lock, "Failed to map file");
 
-   WAR2_TRAP_SETUP(w2) {
-      if (w2->entries) free(w2->entries);
-err_unmap:
-      common_file_munmap(w2->mem_map);
-err_free:
-      free(w2);
-      return NULL;
-   }
+   common_cursor_init(&cur, w2->mem_map->map, w2->mem_map->size);
 
    /* Read magic */
-   w2->magic = WAR2_READ32(w2);
+   w2->magic = common_cursor_read32(&cur);
    switch (w2->magic)
      {
       case 0x00000019: // Handled
@@ -116,10 +115,11 @@ err_free:
      }
 
    /* Get the entries */
-   w2->entries_count = WAR2_READ16(w2);
+   w2->entries_count = common_cursor_read16(&cur);
 
    /* File ID */
-   w2->fid = WAR2_READ16(w2);
+   w2->fid = common_cursor_read16(&cur);
+   if (common_cursor_error(&cur)) DIE_GOTO(err_unmap, "Header is truncated");
 
    /* Allocate entries table */
    w2->entries = calloc(w2->entries_count, sizeof(unsigned char *));
@@ -129,7 +129,9 @@ err_free:
    for (i = 0; i < w2->entries_count; i++)
      {
         /* Get offset and set starting point of sections */
-        l = WAR2_READ32(w2);
+        l = common_cursor_read32(&cur);
+        if (common_cursor_error(&cur))
+          DIE_GOTO(err_entries, "Table of entries is truncated");
         if (l >= w2->mem_map->size)
           {
              ERR("Entry %i has offset [%u] larger than file size [%zu]. Skipping...",
@@ -147,6 +149,16 @@ err_free:
 
    return w2;
 
+err_entries:
+   free(w2->entries);
+err_unmap:
+   common_file_munmap(w2->mem_map);
+err_lock:
+#ifdef HAVE_PTHREAD
+   pthread_mutex_destroy(&(w2->lock));
+#endif
+err_free:
+   free(w2);
 err:
    return NULL;
 }
@@ -165,57 +177,83 @@ war2_palette_get(const War2_Data *w2, Pud_Era era)
 }
 
 
-PUDAPI unsigned char *
-war2_entry_extract(War2_Data    *w2,
-                   unsigned int  entry,
-                   size_t       *size_ret)
+/*
+ * Extract an entry. If a decoder is provided, the result is owned either
+ * by the decoder (compressed entries) or by the memory map (uncompressed
+ * entries). Otherwise, the result is always allocated and owned by the
+ * caller.
+ */
+static const unsigned char *
+_entry_extract(War2_Data         *w2,
+               War2_Decoder      *dec,
+               War2_Decoder_Slot  slot,
+               unsigned int       entry,
+               size_t            *size_ret)
 {
-   unsigned char buf[4096];
    unsigned char *ptr = NULL, *p, *e;
+   Common_Cursor cur;
    uint32_t l, ulen;
    uint16_t w;
    uint8_t bits, b;
-   int flags, i, j, bi = 0;
+   int flags, i, j;
+   ptrdiff_t src;
 
    /* Check the entry is in the range */
    if (entry >= w2->entries_count)
      DIE_RETURN(NULL, "Invalid entry [%i]. Entries range is: [0 ; %u].",
                 entry, w2->entries_count - 1);
-
-   WAR2_TRAP_SETUP(w2) {
-fail:
-      if (size_ret) *size_ret = 0;
-      free(ptr);
-      return NULL;
-   }
+   if (!w2->entries[entry])
+     DIE_RETURN(NULL, "Entry [%u] is not within the file", entry);
 
    /* Go at entry */
-   w2->mem_map->ptr = w2->entries[entry];
+   common_cursor_init(&cur, w2->entries[entry],
+                      (unsigned char *)w2->mem_map->map + w2->mem_map->size -
+                      w2->entries[entry]);
 
    /* Uncompressed length (3 bytes) & Flags (1 byte) */
-   l = WAR2_READ32(w2);
+   l = common_cursor_read32(&cur);
+   if (common_cursor_error(&cur))
+     DIE_GOTO(fail, "Header of entry %i is truncated", entry);
    flags = l >> 24;
    ulen = l & 0x00ffffff;
    WAR2_VERBOSE(w2, 2, "Entry %i: uncompressed length: %i. Flags: 0x%02x",
                 entry, ulen, flags);
 
-   /* Output entry will always be duplicated */
-   ptr = malloc(ulen);
-   if (!ptr) DIE_RETURN(NULL," Failed to allocate memory");
-
    switch (flags)
      {
       case 0x00: // Uncompressed
-         memcpy(ptr, w2->mem_map->ptr, ulen);
+         if (common_cursor_left(&cur) < ulen)
+           DIE_GOTO(fail, "Entry %i has length [%u] that exceeds the file size",
+                    entry, ulen);
+         if (dec)
+           {
+              /* No need to copy: the memory map is alive as long as w2 */
+              ptr = (unsigned char *)cur.ptr;
+           }
+         else
+           {
+              ptr = malloc(ulen);
+              if (!ptr) DIE_GOTO(fail, "Failed to allocate memory");
+              memcpy(ptr, cur.ptr, ulen);
+           }
          break;
 
       case 0x20: // Compressed
-         memset(&(buf[0]), 0, sizeof(buf));
+         if (dec)
+           ptr = war2_decoder_buffer_get(dec, slot, ulen);
+         else
+           ptr = malloc(ulen);
+         if (!ptr) DIE_GOTO(fail, "Failed to allocate memory");
+
          p = ptr;
          e = ptr + ulen;
          while (p < e)
            {
-              bits = WAR2_READ8(w2);
+              /* Reads past the end give zeros: they are checked once
+               * per group of 8 tokens */
+              bits = common_cursor_read8(&cur);
+              if (common_cursor_error(&cur))
+                DIE_GOTO(fail, "Entry %i is truncated", entry);
               for (i = 0; i < 8; i++)
                 {
                    /*
@@ -223,21 +261,28 @@ fail:
                     * I don't know what's the (de)compression method used here.
                     * I blindly rely on the implementation of Wargus until I exactly
                     * figure out what's going on (I'm a bit in the hurry right now).
+                    *
+                    * References index a 4KiB ring buffer that mirrors the
+                    * output and that initially contains zeros. Instead of
+                    * maintaining this ring buffer, the bytes are directly
+                    * read back from the output: the reference is converted
+                    * to a distance (1 to 4096) from the current position.
                     */
                    if (bits & 1)
                      {
-                        b = WAR2_READ8(w2);
+                        b = common_cursor_read8(&cur);
                         *(p++) = b;
-                        buf[bi++ & 0xfff] = b;
                      }
                    else
                      {
-                        w = WAR2_READ16(w2);
+                        w = common_cursor_read16(&cur);
                         j = (w >> 12) + 3;
                         w &= 0x0fff;
+                        src = (p - ptr) - ((((p - ptr) - w - 1) & 0xfff) + 1);
                         while (j--)
                           {
-                             buf[bi++ & 0xfff] = *(p++) = buf[w++ & 0xfff];
+                             *(p++) = (src >= 0) ? ptr[src] : 0;
+                             src++;
                              if (p == e) break;
                           }
                      }
@@ -251,17 +296,65 @@ fail:
          DIE_GOTO(fail, "Unhandled flags [0x%02x] for entry %i", flags, entry);
      }
 
+   if (common_cursor_error(&cur))
+     DIE_GOTO(fail, "Entry %i is truncated", entry);
+
    WAR2_VERBOSE(w2, 1, "Extracted entry [%i] of size %i bytes", entry, ulen);
    if (size_ret) *size_ret = ulen;
    return ptr;
+
+fail:
+   if (size_ret) *size_ret = 0;
+   if (!dec) free(ptr);
+   return NULL;
+}
+
+PUDAPI unsigned char *
+war2_entry_extract(War2_Data    *w2,
+                   unsigned int  entry,
+                   size_t       *size_ret)
+{
+   /* Output entry will always be duplicated */
+   return (unsigned char *)_entry_extract(w2, NULL, 0, entry, size_ret);
+}
+
+PUDAPI_INTERNAL const unsigned char *
+war2_decoder_entry_get(War2_Data         *w2,
+                       War2_Decoder      *dec,
+                       War2_Decoder_Slot  slot,
+                       unsigned int       entry,
+                       size_t            *size_ret)
+{
+   return _entry_extract(w2, dec, slot, entry, size_ret);
+}
+
+PUDAPI const unsigned char *
+war2_decoder_entry_extract(War2_Data    *w2,
+                           War2_Decoder *dec,
+                           unsigned int  entry,
+                           size_t       *size_ret)
+{
+   if (!dec) DIE_RETURN(NULL, "NULL decoder");
+   return _entry_extract(w2, dec, WAR2_DECODER_SLOT_ENTRY_USER, entry, size_ret);
 }
 
 PUDAPI void
 war2_close(War2_Data *w2)
 {
+   unsigned int i;
+
    if (!w2) return;
+   for (i = 0; i < 4; i++)
+     {
+        war2_minitiles_free(w2->minitiles[i]);
+        free(w2->equivalences[i]);
+        war2_icons_free(w2->icons[i]);
+     }
    common_file_munmap(w2->mem_map);
    free(w2->entries);
+#ifdef HAVE_PTHREAD
+   pthread_mutex_destroy(&(w2->lock));
+#endif
    free(w2);
 }
 
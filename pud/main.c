@@ -33,6 +33,7 @@ static const struct option _options[] =
      {"ppm",      no_argument,          0, 'p'},
      {"jpeg",     no_argument,          0, 'j'},
      {"png",      no_argument,          0, 'g'},
+     {"qoi",      no_argument,          0, 'q'},
      {"print",    no_argument,          0, 'P'},
      {"regm",     no_argument,          0, 'R'},
      {"sqm",      no_argument,          0, 'Q'},
@@ -63,6 +64,8 @@ _usage(FILE *stream)
            "                          the output's filename will the the input file plus \".jpeg\"\n"
            "    -g | --png            Outputs the minimap as a png file. If --out is not specified,\n"
            "                          the output's filename will the the input file plus \".png\"\n"
+           "    -q | --qoi            Outputs the minimap as a qoi file. If --out is not specified,\n"
+           "                          the output's filename will the the input file plus \".qoi\"\n"
            "    -t | --tile-at <x,y>  Gets the tile ID at x,y\n"
            "    -R | --regm           Writes the action map\n"
            "    -Q | --sqm            Writes the movement map\n"
@@ -93,6 +96,7 @@ static struct {
    unsigned int  ppm     : 1;
    unsigned int  jpeg    : 1;
    unsigned int  png     : 1;
+   unsigned int  qoi     : 1;
    unsigned int  enabled : 1;
 } out;
 
@@ -192,9 +196,9 @@ _check_output_enabled(void)
         fprintf(stderr, "*** You must use -o with this option\n");
         exit(1);
      }
-   if (out.jpeg + out.ppm + out.png != 1)
+   if (out.jpeg + out.ppm + out.png + out.qoi != 1)
      {
-        fprintf(stderr, "*** You must use one of --jpeg,--ppm,--png\n");
+        fprintf(stderr, "*** You must use one of --jpeg,--ppm,--png,--qoi\n");
         exit(1);
      }
 }
@@ -223,6 +227,11 @@ _write_output(const Pud_Color *img,
         snprintf(file, sizeof(file), "%s_%u.ppm", out.file, id);
         chk = war2_ppm_write(file, w, h, (const unsigned char *)img);
      }
+   else if (out.qoi)
+     {
+        snprintf(file, sizeof(file), "%s_%u.qoi", out.file, id);
+        chk = war2_qoi_write(file, w, h, (const unsigned char *)img);
+     }
    if (!chk)
      {
         fprintf(stderr, "*** Failed to save to [%s]", file);
@@ -241,8 +250,25 @@ _war2_entry_cb(void                          *data,
                const War2_Sprites_Descriptor *ud,
                uint16_t                       img_nb)
 {
-   _write_output(img, w, h, img_nb);
-   (void) ud;
+   const Pud_Color *palette = data;
+   char file[4096];
+
+   /* Sprites use at most 256 colors: indexed PNG are much smaller */
+   if ((out.png) && (ud->indexes))
+     {
+        snprintf(file, sizeof(file), "%s_%u.png", out.file, img_nb);
+        if (!war2_png_indexed_write(file, w, h, ud->indexes, palette,
+                                    WAR2_PALETTE_SIZE, NULL))
+          {
+             fprintf(stderr, "*** Failed to save to [%s]", file);
+             exit(2);
+          }
+        printf("Saving image at '%s'\n", file);
+     }
+   else
+     _write_output(img, w, h, img_nb);
+   (void) x;
+   (void) y;
 }
 
 int
@@ -262,7 +288,7 @@ main(int    argc,
    /* Getopt */
    while (1)
      {
-        c = getopt_long(argc, argv, "o:pjsS:hgwPRQvt:C:U:", _options, &opt_idx);
+        c = getopt_long(argc, argv, "o:pjsS:hgqwPRQvt:C:U:", _options, &opt_idx);
         if (c == -1) break;
 
         switch (c)
@@ -327,6 +353,11 @@ main(int    argc,
               out.enabled = 1;
               break;
 
+           case 'q':
+              out.qoi = 1;
+              out.enabled = 1;
+              break;
+
            case 'o':
               out.enabled = 1;
               out.file = strdup(optarg);
@@ -367,8 +398,13 @@ main(int    argc,
 
         if (sprite.enabled)
           {
+             Pud_Color palette[WAR2_PALETTE_SIZE];
+
              _check_output_enabled();
-             war2_sprites_decode_entry(w2, sprite.color, sprite.entry, _war2_entry_cb, NULL);
+             /* Palette of the decoded pixels, for indexed output */
+             war2_sprites_palette_colorize(war2_palette_get(w2, PUD_ERA_FOREST),
+                                           sprite.color, palette);
+             war2_sprites_decode_entry(w2, sprite.color, sprite.entry, _war2_entry_cb, palette);
           }
         else if (cursor.enabled)
           {
@@ -430,15 +466,15 @@ main(int    argc,
                      w, pud->action_map[idx], pud->movement_map[idx]);
           }
 
-        /* --output,--ppm,--jpeg,--png */
+        /* --output,--ppm,--jpeg,--png,--qoi */
         if (out.enabled)
           {
              if (regm.enabled)
                ABORT(1, "--regm is not compatible with --output");
              if (sqm.enabled)
                ABORT(1, "--sqm is not compatible with --output");
-             if (out.jpeg + out.ppm + out.png != 1)
-               ABORT(1, "You must use one of --jpeg,--ppm,--png.");
+             if (out.jpeg + out.ppm + out.png + out.qoi != 1)
+               ABORT(1, "You must use one of --jpeg,--ppm,--png,--qoi.");
 
              if (!out.file)
                {
@@ -449,6 +485,7 @@ main(int    argc,
                   if (out.ppm)       ext = "ppm";
                   else if (out.jpeg) ext = "jpeg";
                   else if (out.png)  ext = "png";
+                  else if (out.qoi)  ext = "qoi";
                   else ABORT(1, "Output is required but no format is specified");
 
                   len = snprintf(buf, sizeof(buf), "%s.%s", file, ext);
@@ -471,6 +508,11 @@ main(int    argc,
                   if (!pud_minimap_to_png(pud, out.file))
                     ABORT(4, "Failed to output [%s] to [%s]", file, out.file);
                }
+             else if (out.qoi)
+               {
+                  if (!pud_minimap_to_qoi(pud, out.file))
+                    ABORT(4, "Failed to output [%s] to [%s]", file, out.file);
+               }
              else
                ABORT(1, "Output is required no format is specified");
           }
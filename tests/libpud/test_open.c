@@ -57,8 +57,200 @@ START_TEST(open)
 }
 END_TEST
 
+static unsigned char *
+_file_read(const char *file,
+           size_t     *size)
+{
+   FILE *f;
+   unsigned char *buf;
+   long len;
+
+   f = fopen(file, "rb");
+   fail_if(f == NULL);
+   fseek(f, 0, SEEK_END);
+   len = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   buf = malloc(len + 64);
+   fail_if(buf == NULL);
+   fail_if(fread(buf, 1, len, f) != (size_t)len);
+   fclose(f);
+   *size = len;
+   return buf;
+}
+
+static void
+_file_write(const char          *file,
+            const unsigned char *buf,
+            size_t               size)
+{
+   FILE *f;
+
+   f = fopen(file, "wb");
+   fail_if(f == NULL);
+   fail_if(fwrite(buf, 1, size, f) != size);
+   fclose(f);
+}
+
+START_TEST(sections_index)
+{
+   const char *const file = "sections_index.tmp.pud";
+   const unsigned char ver[] = { 'V', 'E', 'R', ' ', 2, 0, 0, 0, 0x42, 0x00 };
+   const unsigned char unknown[] = { 'X', 'Y', 'Z', 'W', 1, 0, 0, 0, 0xff };
+   unsigned char *buf;
+   size_t size;
+   Pud *p;
+   uint16_t version;
+
+   fail_if(pud_init() != PUD_TRUE);
+   buf = _file_read(TESTS_SOURCE_DIR"/libpud/cibola.pud", &size);
+
+   /* Sections can be parsed in any order */
+   p = pud_open(TESTS_SOURCE_DIR"/libpud/cibola.pud",
+                PUD_OPEN_MODE_R | PUD_OPEN_MODE_NO_PARSE);
+   fail_if(p == NULL);
+   fail_if(pud_parse_unit(p) != PUD_TRUE);
+   fail_if(pud_parse_dim(p) != PUD_TRUE);
+   fail_if(pud_parse_era(p) != PUD_TRUE);
+   fail_if(pud_parse_ver(p) != PUD_TRUE);
+   fail_if(pud_parse_type(p) != PUD_TRUE);
+   fail_if(!pud_section_has(p, PUD_SECTION_UNIT));
+   fail_if(!pud_section_has(p, PUD_SECTION_TYPE));
+   version = p->version;
+   pud_close(p);
+
+   /* Duplicate sections are ignored, unknown ones and trailing bytes are
+    * skipped, and reported when parsing verbosely */
+   memcpy(&(buf[size]), ver, sizeof(ver));
+   memcpy(&(buf[size + sizeof(ver)]), unknown, sizeof(unknown));
+   memset(&(buf[size + sizeof(ver) + sizeof(unknown)]), 0, 3);
+   _file_write(file, buf, size + sizeof(ver) + sizeof(unknown) + 3);
+   p = pud_open(file, PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   fail_if(p->version != version);
+   pud_close(p);
+   p = pud_open(file, PUD_OPEN_MODE_R | PUD_OPEN_MODE_NO_PARSE);
+   fail_if(p == NULL);
+   pud_verbosity_set(p, 1);
+   fail_if(pud_parse(p) != PUD_TRUE);
+   fail_if(p->version != version);
+   pud_close(p);
+
+   /* A truncated section cannot be reached */
+   _file_write(file, buf, size - 1);
+   fail_if(pud_open(file, PUD_OPEN_MODE_R) != NULL);
+
+   remove(file);
+   free(buf);
+   pud_shutdown();
+}
+END_TEST
+
+static const unsigned char *
+_section_find(const unsigned char *buf,
+              size_t               size,
+              const char          *tag,
+              uint32_t            *len)
+{
+   size_t off;
+
+   for (off = 0; off + 8 <= size; off += 8 + *len)
+     {
+        memcpy(len, &(buf[off + 4]), sizeof(uint32_t));
+        if (!memcmp(&(buf[off]), tag, 4)) return &(buf[off + 8]);
+     }
+   return NULL;
+}
+
+START_TEST(layers)
+{
+   unsigned char *buf;
+   const unsigned char *data;
+   size_t size;
+   uint32_t len;
+   uint16_t w;
+   unsigned int i;
+   Pud *p;
+
+   fail_if(pud_init() != PUD_TRUE);
+   buf = _file_read(TESTS_SOURCE_DIR"/libpud/cibola.pud", &size);
+   p = pud_open(TESTS_SOURCE_DIR"/libpud/cibola.pud", PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+
+   /* Layers are the little-endian words of their sections */
+   data = _section_find(buf, size, "MTXM", &len);
+   fail_if((data == NULL) || (len != p->tiles * 2));
+   for (i = 0; i < p->tiles; i++)
+     fail_if(p->tiles_map[i] != (data[i * 2] | (data[i * 2 + 1] << 8)));
+   data = _section_find(buf, size, "SQM ", &len);
+   fail_if((data == NULL) || (len != p->tiles * 2));
+   for (i = 0; i < p->tiles; i++)
+     fail_if(p->movement_map[i] != (data[i * 2] | (data[i * 2 + 1] << 8)));
+   data = _section_find(buf, size, "REGM", &len);
+   fail_if((data == NULL) || (len != p->tiles * 2));
+   for (i = 0; i < p->tiles; i++)
+     fail_if(p->action_map[i] != (data[i * 2] | (data[i * 2 + 1] << 8)));
+
+   /* Units are records of 8 bytes */
+   data = _section_find(buf, size, "UNIT", &len);
+   fail_if((data == NULL) || (p->units_count != len / 8) || (p->units_count == 0));
+   for (i = 0; i < p->units_count; i++, data += 8)
+     {
+        w = data[0] | (data[1] << 8);
+        fail_if(p->units[i].x != w);
+        w = data[2] | (data[3] << 8);
+        fail_if(p->units[i].y != w);
+        fail_if(p->units[i].type != data[4]);
+        fail_if(p->units[i].player != data[5]);
+        w = data[6] | (data[7] << 8);
+        fail_if(p->units[i].alter != w);
+     }
+
+   pud_close(p);
+   free(buf);
+   pud_shutdown();
+}
+END_TEST
+
+START_TEST(minimap_formats)
+{
+   Pud *p;
+   unsigned char *rgba, *map, *conv;
+   unsigned int fmt, size, rgba_size;
+
+   fail_if(pud_init() != PUD_TRUE);
+   p = pud_open(TESTS_SOURCE_DIR"/libpud/cibola.pud", PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+
+   rgba = pud_minimap_bitmap_generate(p, &rgba_size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(rgba == NULL);
+   fail_if(rgba_size != p->tiles * sizeof(Pud_Color));
+   conv = malloc(rgba_size);
+   fail_if(conv == NULL);
+
+   /* Other formats are the RGBA minimap, converted */
+   for (fmt = 0; fmt < __PUD_PIXEL_FORMAT_LAST; fmt++)
+     {
+        map = pud_minimap_bitmap_generate(p, &size, fmt);
+        fail_if(map == NULL);
+        fail_if(size != p->tiles * pud_pixel_format_size(fmt));
+        fail_if(pud_pixels_convert((const Pud_Color *)rgba, conv, p->tiles, fmt) != PUD_TRUE);
+        fail_if(memcmp(map, conv, size) != 0);
+        free(map);
+     }
+   fail_if(pud_minimap_bitmap_generate(p, &size, __PUD_PIXEL_FORMAT_LAST) != NULL);
+
+   free(conv);
+   free(rgba);
+   pud_close(p);
+   pud_shutdown();
+}
+END_TEST
+
 void
 test_open(TCase *tc)
 {
    tcase_add_test(tc, open);
+   tcase_add_test(tc, sections_index);
+   tcase_add_test(tc, layers);
+   tcase_add_test(tc, minimap_formats);
 }
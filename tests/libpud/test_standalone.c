@@ -112,7 +112,54 @@ START_TEST(projectile2str)
 }
 END_TEST
 
+START_TEST(pixels_convert)
+{
+   const Pud_Color src[3] = {
+        { 0x12, 0x34, 0x56, 0xff },
+        { 0xff, 0x80, 0x01, 0x80 },
+        { 0xaa, 0xbb, 0xcc, 0x00 },
+   };
+   uint32_t words[3];
+   uint16_t shorts[3];
+   unsigned char bytes[3 * 4];
+   Pud_Color colors[3];
+
+   fail_if(pud_init() != PUD_TRUE);
+
+   fail_if(pud_pixel_format_size(PUD_PIXEL_FORMAT_RGBA) != 4);
+   fail_if(pud_pixel_format_size(PUD_PIXEL_FORMAT_RGB) != 3);
+   fail_if(pud_pixel_format_size(PUD_PIXEL_FORMAT_RGB565) != 2);
+   fail_if(pud_pixel_format_size(__PUD_PIXEL_FORMAT_LAST) != 0);
+
+   fail_if(pud_pixels_convert(src, colors, 3, PUD_PIXEL_FORMAT_RGBA) != PUD_TRUE);
+   fail_if(memcmp(src, colors, sizeof(src)) != 0);
+
+   fail_if(pud_pixels_convert(src, words, 3, PUD_PIXEL_FORMAT_ARGB) != PUD_TRUE);
+   fail_if(words[0] != 0xff123456);
+   fail_if(words[1] != 0x80ff8001);
+   fail_if(words[2] != 0x00aabbcc);
+
+   /* Premultiplication rounds to the nearest value */
+   fail_if(pud_pixels_convert(src, words, 3, PUD_PIXEL_FORMAT_ARGB32_PREMUL) != PUD_TRUE);
+   fail_if(words[0] != 0xff123456);
+   fail_if(words[1] != 0x80804001);
+   fail_if(words[2] != 0x00000000);
 
+   fail_if(pud_pixels_convert(src, bytes, 3, PUD_PIXEL_FORMAT_BGRA) != PUD_TRUE);
+   fail_if(memcmp(bytes, "\x56\x34\x12\xff\x01\x80\xff\x80\xcc\xbb\xaa\x00", 12) != 0);
+
+   fail_if(pud_pixels_convert(src, bytes, 3, PUD_PIXEL_FORMAT_RGB) != PUD_TRUE);
+   fail_if(memcmp(bytes, "\x12\x34\x56\xff\x80\x01\xaa\xbb\xcc", 9) != 0);
+
+   fail_if(pud_pixels_convert(src, shorts, 3, PUD_PIXEL_FORMAT_RGB565) != PUD_TRUE);
+   fail_if(shorts[0] != ((0x12 >> 3) << 11 | (0x34 >> 2) << 5 | (0x56 >> 3)));
+   fail_if(shorts[1] != 0xfc00);
+
+   fail_if(pud_pixels_convert(src, words, 3, __PUD_PIXEL_FORMAT_LAST) != PUD_FALSE);
+
+   pud_shutdown();
+}
+END_TEST
 
 void
 test_standalone(TCase *tc)
@@ -123,4 +170,5 @@ test_standalone(TCase *tc)
    tcase_add_test(tc, owner_convert);
    tcase_add_test(tc, unit_valid_is);
    tcase_add_test(tc, projectile2str);
+   tcase_add_test(tc, pixels_convert);
 }
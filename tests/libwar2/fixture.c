@@ -0,0 +1,347 @@
+#include "tests.h"
+#include <war2.h>
+#include <stdint.h>
+
+/*
+ * There is no way to ship MAINDAT.WAR with the tests. Instead, a small
+ * data file that follows the same layout is generated. It only contains
+ * the entries that are used by the tests.
+ */
+
+#define FIXTURE_ENTRIES 442
+#define FIXTURE_MAX_ENTRY_SIZE (16 * 1024)
+
+typedef enum
+{
+   ENTRY_RAW, /* Stored uncompressed */
+   ENTRY_COMPRESSED, /* Compressed when written */
+   ENTRY_VERBATIM /* Written as is (header included) */
+} Entry_Kind;
+
+typedef struct
+{
+   unsigned char data[FIXTURE_MAX_ENTRY_SIZE];
+   size_t size;
+   Entry_Kind kind;
+} Entry;
+
+static Entry *_entries[FIXTURE_ENTRIES];
+
+static Entry *
+_entry_new(unsigned int id, Entry_Kind kind)
+{
+   Entry *e = calloc(1, sizeof(Entry));
+   ck_assert(e != NULL);
+   e->kind = kind;
+   _entries[id] = e;
+   return e;
+}
+
+static void
+_entry_add8(Entry *e, uint8_t val)
+{
+   ck_assert(e->size < FIXTURE_MAX_ENTRY_SIZE);
+   e->data[e->size++] = val;
+}
+
+static void
+_entry_add16(Entry *e, uint16_t val)
+{
+   _entry_add8(e, val & 0xff);
+   _entry_add8(e, val >> 8);
+}
+
+static void
+_entry_add32(Entry *e, uint32_t val)
+{
+   _entry_add16(e, val & 0xffff);
+   _entry_add16(e, val >> 16);
+}
+
+static void
+_write8(FILE *f, uint8_t val)
+{
+   if (f) ck_assert(fwrite(&val, 1, 1, f) == 1);
+}
+
+static void
+_write16(FILE *f, uint16_t val)
+{
+   _write8(f, val & 0xff);
+   _write8(f, val >> 8);
+}
+
+static void
+_write32(FILE *f, uint32_t val)
+{
+   _write16(f, val & 0xffff);
+   _write16(f, val >> 16);
+}
+
+/*
+ * Write an entry and return its size in the file. Passing a NULL file
+ * only computes the size.
+ *
+ * Compressed entries contain literals only: each group of 8 bytes is
+ * preceded by a 0xff flags byte. Back-references are tested with hand-made
+ * entries (see _lz_entries_add()).
+ */
+static size_t
+_entry_write(FILE *f, const Entry *e)
+{
+   size_t i, written = 4;
+
+   if (e->kind == ENTRY_VERBATIM)
+     {
+        if (f) ck_assert(fwrite(e->data, 1, e->size, f) == e->size);
+        return e->size;
+     }
+   if (e->kind == ENTRY_COMPRESSED)
+     {
+        _write32(f, e->size | (0x20 << 24));
+        for (i = 0; i < e->size; i++)
+          {
+             if (i % 8 == 0) { _write8(f, 0xff); written++; }
+             _write8(f, e->data[i]);
+             written++;
+          }
+     }
+   else
+     {
+        _write32(f, e->size);
+        if (f) ck_assert(fwrite(e->data, 1, e->size, f) == e->size);
+        written += e->size;
+     }
+   return written;
+}
+
+static void
+_palettes_add(void)
+{
+   const unsigned int ids[] = { 2, 10, 18, 438 };
+   unsigned int i, k;
+   Entry *e;
+
+   for (k = 0; k < 4; k++)
+     {
+        e = _entry_new(ids[k], ENTRY_RAW);
+        for (i = 0; i < WAR2_PALETTE_SIZE; i++)
+          {
+             _entry_add8(e, (i + k) & 0x3f);
+             _entry_add8(e, (i * 3) & 0x3f);
+             _entry_add8(e, (i * 7) & 0x3f);
+          }
+     }
+}
+
+static void
+_lz_entries_add(void)
+{
+   Entry *e;
+   unsigned int i;
+
+   /* Expands to "ABABABA\0\0\0": two literals, a reference that overlaps
+    * its own output, and a reference to never-written history (zeros) */
+   e = _entry_new(FIXTURE_ENTRY_LZ, ENTRY_VERBATIM);
+   _entry_add8(e, 10); _entry_add8(e, 0); _entry_add8(e, 0); _entry_add8(e, 0x20);
+   _entry_add8(e, 0x03); /* literal, literal, ref, ref */
+   _entry_add8(e, 'A');
+   _entry_add8(e, 'B');
+   _entry_add16(e, (2 << 12) | 0x000); /* 5 bytes from position 0 */
+   _entry_add16(e, (0 << 12) | 0x800); /* 3 bytes from position 0x800 */
+
+   /* 4096 literals then a reference that reaches exactly 4096 bytes back */
+   e = _entry_new(FIXTURE_ENTRY_LZ_FAR, ENTRY_VERBATIM);
+   _entry_add8(e, (4099) & 0xff);
+   _entry_add8(e, (4099 >> 8) & 0xff);
+   _entry_add8(e, 0);
+   _entry_add8(e, 0x20);
+   for (i = 0; i < 4096; i++)
+     {
+        if (i % 8 == 0) _entry_add8(e, 0xff);
+        _entry_add8(e, (i * 7) & 0xff);
+     }
+   _entry_add8(e, 0x00);
+   _entry_add16(e, (0 << 12) | 0x000);
+}
+
+static void
+_sprite_add(unsigned int id)
+{
+   Entry *e = _entry_new(id, ENTRY_COMPRESSED);
+   const unsigned int f0 = 6 + 2 * 8;
+   unsigned int f1, i;
+
+   _entry_add16(e, 2); /* Count */
+   _entry_add16(e, 70); /* Max width */
+   _entry_add16(e, 3); /* Max height */
+
+   /* Frame headers: x, y, w, h, dstart */
+   _entry_add8(e, 0); _entry_add8(e, 0); _entry_add8(e, 70); _entry_add8(e, 3);
+   _entry_add16(e, f0); _entry_add16(e, 0);
+   _entry_add8(e, 1); _entry_add8(e, 1); _entry_add8(e, 2); _entry_add8(e, 2);
+   _entry_add16(e, 0); _entry_add16(e, 0); /* Patched below */
+
+   /* Frame 0: 70x3 */
+   _entry_add16(e, 6); _entry_add16(e, 6 + 9); _entry_add16(e, 6 + 10);
+   _entry_add8(e, 0x80 | 10);                  /* Row 0: leave 10 */
+   _entry_add8(e, 5);                          /*        copy 5 */
+   for (i = 1; i <= 5; i++) _entry_add8(e, i);
+   _entry_add8(e, 0x40 | 55); _entry_add8(e, 9); /*      repeat 55 */
+   _entry_add8(e, 0x80 | 70);                  /* Row 1: leave 70 */
+   _entry_add8(e, 0x40 | 63); _entry_add8(e, 4); /* Row 2: repeat 63 */
+   _entry_add8(e, 7);                          /*        copy 7 */
+   for (i = 1; i <= 7; i++) _entry_add8(e, 0x10 + i);
+
+   /* Frame 1: 2x2 */
+   f1 = e->size;
+   e->data[6 + 8 + 4] = f1 & 0xff;
+   e->data[6 + 8 + 5] = f1 >> 8;
+   _entry_add16(e, 4); _entry_add16(e, 4 + 3);
+   _entry_add8(e, 2); _entry_add8(e, 1); _entry_add8(e, 2); /* Row 0: copy 2 */
+   _entry_add8(e, 0x80 | 2);                                /* Row 1: leave 2 */
+}
+
+static void
+_ui_cursor_add(void)
+{
+   Entry *e;
+   unsigned int i, k;
+
+   e = _entry_new(FIXTURE_ENTRY_UI, ENTRY_COMPRESSED);
+   _entry_add16(e, 5);
+   _entry_add16(e, 3);
+   for (i = 0; i < 5 * 3; i++) _entry_add8(e, i);
+
+   e = _entry_new(FIXTURE_ENTRY_CURSOR, ENTRY_RAW);
+   _entry_add16(e, 2); /* Hot X */
+   _entry_add16(e, 1); /* Hot Y */
+   _entry_add16(e, 4);
+   _entry_add16(e, 4);
+   for (i = 0; i < 4 * 4; i++) _entry_add8(e, (i % 3 == 0) ? 0 : 200 + i);
+
+   /* Other cursors have various sizes */
+   for (k = FIXTURE_ENTRY_CURSOR + 1; k <= 322; k++)
+     {
+        e = _entry_new(k, (k % 2) ? ENTRY_RAW : ENTRY_COMPRESSED);
+        _entry_add16(e, k % 3);
+        _entry_add16(e, k % 5);
+        _entry_add16(e, 1 + (k % 7));
+        _entry_add16(e, 1 + (k % 4));
+        for (i = 0; i < (1 + (k % 7)) * (1 + (k % 4)); i++) _entry_add8(e, k + i);
+     }
+}
+
+static void
+_font_add(void)
+{
+   Entry *e = _entry_new(FIXTURE_ENTRY_FONT, ENTRY_RAW);
+
+   _entry_add8(e, 'F'); _entry_add8(e, 'O'); _entry_add8(e, 'N'); _entry_add8(e, 'T');
+   _entry_add8(e, ' '); /* Lowest character */
+   _entry_add8(e, '#'); /* Highest character */
+   _entry_add8(e, 4); /* Max width */
+   _entry_add8(e, 5); /* Max height */
+
+   /* ' ' and '"' have no pixels */
+   _entry_add32(e, 0);
+   _entry_add32(e, 24);
+   _entry_add32(e, 0);
+   _entry_add32(e, 31);
+
+   /* '!': 1x3 at (1, 1), one pixel of each color */
+   _entry_add8(e, 1); _entry_add8(e, 3); _entry_add8(e, 1); _entry_add8(e, 1);
+   _entry_add8(e, 0x01); _entry_add8(e, 0x02); _entry_add8(e, 0x04);
+
+   /* '#': 3x2 at (0, 2), with transparent pixels skipped by the bytes */
+   _entry_add8(e, 3); _entry_add8(e, 2); _entry_add8(e, 0); _entry_add8(e, 2);
+   _entry_add8(e, 0x09); /* Skip 1, then color 1 */
+   _entry_add8(e, 0x10); /* Skip 2, then transparent */
+   _entry_add8(e, 0x02);
+}
+
+static void
+_tileset_add(void)
+{
+   Entry *e;
+   unsigned int i;
+
+   /* Megatiles: 0 is unused, 1 uses minitiles 1 and 2 with all flips,
+    * 2 is a copy of 1 and 3 only uses minitile 2 */
+   e = _entry_new(3, ENTRY_COMPRESSED);
+   for (i = 0; i < 16; i++) _entry_add16(e, 0);
+   for (i = 0; i < 16; i++) _entry_add16(e, ((1 + (i % 2)) << 2) | (i % 4));
+   for (i = 0; i < 16; i++) _entry_add16(e, ((1 + (i % 2)) << 2) | (i % 4));
+   for (i = 0; i < 16; i++) _entry_add16(e, 2 << 2);
+
+   /* Minitiles: 0 is unused */
+   e = _entry_new(4, ENTRY_COMPRESSED);
+   for (i = 0; i < 64; i++) _entry_add8(e, 0);
+   for (i = 0; i < 64; i++) _entry_add8(e, 1 + i);
+   for (i = 0; i < 64; i++) _entry_add8(e, 100 + (i % 9));
+
+   /* Map: tiles 0x10 and 0x100 use megatile 1, 0x11 uses megatile 2
+    * and 0x20 uses megatile 3 */
+   e = _entry_new(5, ENTRY_COMPRESSED);
+   e->size = ((0x9d * 42) + (0xf * 2)) + 2;
+   e->data[(0x1 * 42) + (0x0 * 2)] = 1;
+   e->data[(0x10 * 42) + (0x0 * 2)] = 1;
+   e->data[(0x1 * 42) + (0x1 * 2)] = 2;
+   e->data[(0x2 * 42) + (0x0 * 2)] = 3;
+}
+
+const char *
+fixture_war_get(void)
+{
+   static const char *const path = TESTS_BUILD_DIR "/libwar2_fixture.war";
+   static Pud_Bool generated = PUD_FALSE;
+   uint32_t offset;
+   unsigned int i;
+   FILE *f;
+
+   if (generated) return path;
+
+   _palettes_add();
+   _lz_entries_add();
+   _sprite_add(33); /* Dwarves */
+   _sprite_add(FIXTURE_ENTRY_ICONS);
+   _ui_cursor_add();
+   _font_add();
+   _tileset_add();
+
+   f = fopen(path, "wb");
+   ck_assert(f != NULL);
+
+   _write32(f, 0x19); /* Magic */
+   _write16(f, FIXTURE_ENTRIES);
+   _write16(f, 0); /* File ID */
+
+   /* Offsets table. Entries that are not used by the tests all share
+    * an empty entry, except one that points after the end of the file */
+   offset = 8 + FIXTURE_ENTRIES * 4 + 4;
+   for (i = 0; i < FIXTURE_ENTRIES; i++)
+     {
+        if (i == FIXTURE_ENTRY_MISSING)
+          _write32(f, 0xffffffff);
+        else if (!_entries[i])
+          _write32(f, offset - 4);
+        else
+          {
+             _write32(f, offset);
+             offset += _entry_write(NULL, _entries[i]);
+          }
+     }
+
+   _write32(f, 0); /* Empty entry */
+   for (i = 0; i < FIXTURE_ENTRIES; i++)
+     {
+        if (!_entries[i]) continue;
+        _entry_write(f, _entries[i]);
+        free(_entries[i]);
+        _entries[i] = NULL;
+     }
+
+   fclose(f);
+   generated = PUD_TRUE;
+   return path;
+}
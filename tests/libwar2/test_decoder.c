@@ -0,0 +1,1047 @@
+#include "tests.h"
+#include <war2.h>
+#if HAVE_PNG
+# include <png.h>
+#endif
+
+/*
+ * Count the allocations performed by the library. With glibc, malloc() and
+ * friends can be overridden by the executable and forwarded to the libc
+ * implementation. Counting is only armed by the no_alloc test.
+ *
+ * Sanitizers provide their own allocator, which must not be overridden:
+ * the count is then not available.
+ */
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+# define TESTS_SANITIZED 1
+#elif defined(__has_feature)
+# if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || \
+     __has_feature(memory_sanitizer)
+#  define TESTS_SANITIZED 1
+# endif
+#endif
+
+#if defined(__GLIBC__) && !defined(TESTS_SANITIZED)
+# define TESTS_ALLOC_COUNT 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static Pud_Bool _alloc_count_enabled = PUD_FALSE;
+static unsigned int _alloc_count = 0;
+
+void *
+malloc(size_t size)
+{
+   if (_alloc_count_enabled) _alloc_count++;
+   return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+   if (_alloc_count_enabled) _alloc_count++;
+   return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+   if (_alloc_count_enabled) _alloc_count++;
+   return __libc_realloc(ptr, size);
+}
+#endif
+
+typedef struct
+{
+   unsigned int frames;
+   unsigned int checksum;
+   Pud_Bool mask_ok;
+} Sprites_Result;
+
+static void
+_sprite_cb(void                          *data,
+           const Pud_Color               *img,
+           int                            x,
+           int                            y,
+           unsigned int                   w,
+           unsigned int                   h,
+           const War2_Sprites_Descriptor *ud,
+           uint16_t                       img_nb)
+{
+   Sprites_Result *res = data;
+   unsigned int i;
+
+   res->frames++;
+   for (i = 0; i < w * h; i++)
+     res->checksum = (res->checksum * 31) + img[i].r + img[i].g + img[i].b + img[i].a;
+   res->checksum += x + y + img_nb;
+
+   if ((!ud->mask) || (ud->mask->w != w) || (ud->mask->h != h))
+     {
+        res->mask_ok = PUD_FALSE;
+        return;
+     }
+   for (i = 0; i < w * h; i++)
+     if ((img[i].a != 0) != war2_sprite_mask_hit(ud->mask, i % w, i / w))
+       res->mask_ok = PUD_FALSE;
+
+   if (img_nb == 0)
+     {
+        /* First row starts after 10 transparent pixels, second is empty */
+        if ((ud->mask->spans[0].start != 10) || (ud->mask->spans[0].end != 70) ||
+            (ud->mask->spans[1].start != ud->mask->spans[1].end))
+          res->mask_ok = PUD_FALSE;
+     }
+}
+
+static void
+_tile_cb(void                          *data,
+         const Pud_Color               *img,
+         unsigned int                   w,
+         unsigned int                   h,
+         const War2_Tileset_Descriptor *ts,
+         uint16_t                       img_nb)
+{
+   unsigned int *res = data;
+   unsigned int i;
+
+   (void) ts;
+
+   for (i = 0; i < w * h; i++)
+     *res = (*res * 31) + img[i].r + img[i].g + img[i].b + img_nb;
+}
+
+typedef struct
+{
+   const Pud_Color *palette;
+   unsigned int tiles;
+   Pud_Bool ok;
+} Tiles_Result;
+
+static void
+_tile_check_cb(void                          *data,
+               const Pud_Color               *img,
+               unsigned int                   w,
+               unsigned int                   h,
+               const War2_Tileset_Descriptor *ts,
+               uint16_t                       img_nb)
+{
+   Tiles_Result *res = data;
+   unsigned int x, y, i, m, mx, my, col;
+
+   (void) ts;
+   res->tiles++;
+   if ((w != 32) || (h != 32) ||
+       ((img_nb != 0x10) && (img_nb != 0x11) && (img_nb != 0x20) && (img_nb != 0x100)))
+     {
+        res->ok = PUD_FALSE;
+        return;
+     }
+
+   /* Reference decoding of the fixture megatiles: word i uses minitile
+    * 1 + (i % 2) with flips i % 4 (bit 1 on X, bit 0 on Y), except for
+    * tile 0x20 that only uses minitile 2 without flips */
+   for (y = 0; y < 32; y++)
+     for (x = 0; x < 32; x++)
+       {
+          i = (img_nb == 0x20) ? 0 : (y / 8) * 4 + (x / 8);
+          m = (img_nb == 0x20) ? 2 : 1 + (i % 2);
+          mx = (i & 2) ? 7 - (x % 8) : x % 8;
+          my = (i & 1) ? 7 - (y % 8) : y % 8;
+          col = (m == 1) ? 1 + (my * 8 + mx) : 100 + ((my * 8 + mx) % 9);
+          if (memcmp(&(img[y * 32 + x]), &(res->palette[col]), sizeof(Pud_Color)) != 0)
+            res->ok = PUD_FALSE;
+       }
+}
+
+START_TEST(entry_lz)
+{
+   War2_Data *w2;
+   War2_Decoder *dec;
+   unsigned char *ptr;
+   const unsigned char *cptr;
+   size_t size;
+   unsigned int i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+
+   /* Overlapping reference and reference to unwritten history */
+   ptr = war2_entry_extract(w2, FIXTURE_ENTRY_LZ, &size);
+   fail_if(ptr == NULL);
+   fail_if(size != 10);
+   fail_if(memcmp(ptr, "ABABABA\0\0\0", 10) != 0);
+   cptr = war2_decoder_entry_extract(w2, dec, FIXTURE_ENTRY_LZ, &size);
+   fail_if(cptr == NULL);
+   fail_if(size != 10);
+   fail_if(memcmp(cptr, ptr, 10) != 0);
+   free(ptr);
+
+   /* Reference to the farthest byte of the window */
+   cptr = war2_decoder_entry_extract(w2, dec, FIXTURE_ENTRY_LZ_FAR, &size);
+   fail_if(cptr == NULL);
+   fail_if(size != 4099);
+   for (i = 0; i < 4096; i++)
+     fail_if(cptr[i] != ((i * 7) & 0xff));
+   fail_if(memcmp(cptr + 4096, cptr, 3) != 0);
+
+   /* Uncompressed entries are available without copy */
+   ptr = war2_entry_extract(w2, FIXTURE_ENTRY_CURSOR, &size);
+   fail_if(ptr == NULL);
+   cptr = war2_decoder_entry_extract(w2, dec, FIXTURE_ENTRY_CURSOR, &size);
+   fail_if(cptr == NULL);
+   fail_if(memcmp(cptr, ptr, size) != 0);
+   free(ptr);
+
+   /* Entries outside of the file or of the range are rejected */
+   fail_if(war2_decoder_entry_extract(w2, dec, FIXTURE_ENTRY_MISSING, &size) != NULL);
+   fail_if(war2_decoder_entry_extract(w2, dec, 0xffff, &size) != NULL);
+   fail_if(war2_entry_extract(w2, FIXTURE_ENTRY_MISSING, &size) != NULL);
+
+   war2_decoder_free(dec);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(entry_truncated)
+{
+   const char *const file = "entry_truncated.tmp.war";
+   War2_Data *w2;
+   FILE *f;
+   unsigned char *buf, *ptr;
+   uint32_t offset, end, o, at;
+   uint16_t count;
+   size_t size, cut;
+   long len;
+   unsigned int i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   f = fopen(fixture_war_get(), "rb");
+   fail_if(f == NULL);
+   fseek(f, 0, SEEK_END);
+   len = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   buf = malloc(len * 2);
+   fail_if(buf == NULL);
+   fail_if(fread(buf, 1, len, f) != (size_t)len);
+   fclose(f);
+
+   /* The compressed entry ends where the next one starts */
+   memcpy(&count, &(buf[4]), sizeof(uint16_t));
+   memcpy(&offset, &(buf[8 + FIXTURE_ENTRY_LZ_FAR * 4]), sizeof(uint32_t));
+   end = len;
+   for (i = 0; i < count; i++)
+     {
+        memcpy(&o, &(buf[8 + i * 4]), sizeof(uint32_t));
+        if ((o > offset) && (o < end)) end = o;
+     }
+
+   /* A copy of the entry, cut anywhere, ends the file. It must be rejected
+    * when it is extracted */
+   at = len;
+   memcpy(&(buf[8 + FIXTURE_ENTRY_LZ_FAR * 4]), &at, sizeof(uint32_t));
+   for (cut = 4; cut <= end - offset; cut += (cut < 16) ? 1 : 61)
+     {
+        memcpy(&(buf[at]), &(buf[offset]), cut);
+        f = fopen(file, "wb");
+        fail_if(f == NULL);
+        fail_if(fwrite(buf, 1, at + cut, f) != at + cut);
+        fclose(f);
+
+        w2 = war2_open(file);
+        fail_if(w2 == NULL);
+        ptr = war2_entry_extract(w2, FIXTURE_ENTRY_LZ_FAR, &size);
+        fail_if((cut < end - offset) && (ptr != NULL));
+        free(ptr);
+        war2_close(w2);
+     }
+
+   /* The header itself can be truncated */
+   for (cut = 0; cut < 10; cut++)
+     {
+        f = fopen(file, "wb");
+        fail_if(f == NULL);
+        fail_if(fwrite(buf, 1, cut, f) != cut);
+        fclose(f);
+        fail_if(war2_open(file) != NULL);
+     }
+
+   remove(file);
+   free(buf);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(compat)
+{
+   War2_Data *w2;
+   War2_Decoder *dec;
+   Pud_Color *img;
+   const Pud_Color *cimg;
+   unsigned int w, h, cw, ch, t1 = 0, t2 = 0;
+   int x, y, cx, cy;
+   Sprites_Result r1 = { 0, 0, PUD_TRUE }, r2 = { 0, 0, PUD_TRUE };
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+
+   img = war2_ui_decode(w2, FIXTURE_ENTRY_UI, &w, &h);
+   fail_if(img == NULL);
+   cimg = war2_decoder_ui_decode(w2, dec, FIXTURE_ENTRY_UI, &cw, &ch);
+   fail_if(cimg == NULL);
+   fail_if((w != 5) || (h != 3) || (cw != w) || (ch != h));
+   fail_if(memcmp(img, cimg, w * h * sizeof(Pud_Color)) != 0);
+   free(img);
+
+   img = war2_cursors_decode(w2, FIXTURE_ENTRY_CURSOR, &x, &y, &w, &h);
+   fail_if(img == NULL);
+   cimg = war2_decoder_cursors_decode(w2, dec, FIXTURE_ENTRY_CURSOR, &cx, &cy, &cw, &ch);
+   fail_if(cimg == NULL);
+   fail_if((x != 2) || (y != 1) || (w != 4) || (h != 4));
+   fail_if((cx != x) || (cy != y) || (cw != w) || (ch != h));
+   fail_if(memcmp(img, cimg, w * h * sizeof(Pud_Color)) != 0);
+   free(img);
+
+   fail_if(war2_sprites_decode(w2, PUD_PLAYER_BLUE, PUD_ERA_FOREST,
+                               FIXTURE_OBJECT_SPRITE, _sprite_cb, &r1) != PUD_TRUE);
+   fail_if(war2_decoder_sprites_decode(w2, dec, PUD_PLAYER_BLUE, PUD_ERA_FOREST,
+                                       FIXTURE_OBJECT_SPRITE, _sprite_cb, &r2) != PUD_TRUE);
+   fail_if((r1.frames != 2) || (r2.frames != 2));
+   fail_if(r1.checksum != r2.checksum);
+   fail_if((!r1.mask_ok) || (!r2.mask_ok));
+
+   fail_if(war2_tileset_decode(w2, PUD_ERA_FOREST, _tile_cb, &t1) != FIXTURE_TILESET_TILES);
+   fail_if(war2_decoder_tileset_decode(w2, dec, PUD_ERA_FOREST, _tile_cb, &t2) != FIXTURE_TILESET_TILES);
+   fail_if((t1 == 0) || (t1 != t2));
+
+   war2_decoder_free(dec);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(cursors_atlas)
+{
+   War2_Data *w2;
+   War2_Images_Atlas *atlas;
+   const War2_Atlas_Image *img, *other;
+   const unsigned int ui[] = { FIXTURE_ENTRY_UI };
+   Pud_Color *pixels;
+   unsigned int i, k, row, w, h;
+   int x, y;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   atlas = war2_cursors_atlas_new(w2, ui, 1);
+   fail_if(atlas == NULL);
+   fail_if(atlas->count != WAR2_CURSORS_COUNT + 1);
+
+   img = war2_images_atlas_cursor_get(atlas, WAR2_CURSOR_HUMAN_POINTER);
+   fail_if(img != &(atlas->images[0]));
+   fail_if((img->hot_x != 2) || (img->hot_y != 1) || (img->w != 4) || (img->h != 4));
+   fail_if(war2_images_atlas_cursor_get(atlas, FIXTURE_ENTRY_UI) != NULL);
+   fail_if(atlas->images[WAR2_CURSORS_COUNT].entry != FIXTURE_ENTRY_UI);
+
+   for (i = 0; i < atlas->count; i++)
+     {
+        img = &(atlas->images[i]);
+        fail_if((img->x + img->w > atlas->w) || (img->y + img->h > atlas->h));
+
+        /* Images do not overlap */
+        for (k = 0; k < i; k++)
+          {
+             other = &(atlas->images[k]);
+             fail_if((img->x < other->x + other->w) && (other->x < img->x + img->w) &&
+                     (img->y < other->y + other->h) && (other->y < img->y + img->h));
+          }
+
+        /* Same images and hot spots as decoded one by one */
+        if (i < WAR2_CURSORS_COUNT)
+          {
+             pixels = war2_cursors_decode(w2, img->entry, &x, &y, &w, &h);
+             fail_if((x != img->hot_x) || (y != img->hot_y));
+          }
+        else
+          pixels = war2_ui_decode(w2, img->entry, &w, &h);
+        fail_if(pixels == NULL);
+        fail_if((w != img->w) || (h != img->h));
+        for (row = 0; row < h; row++)
+          fail_if(memcmp(&(atlas->rgba[(img->y + row) * atlas->w + img->x]),
+                         &(pixels[row * w]), w * sizeof(Pud_Color)) != 0);
+        free(pixels);
+     }
+
+   war2_images_atlas_free(atlas);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(tileset_minitiles)
+{
+   War2_Data *w2;
+   War2_Decoder *dec;
+   Tiles_Result res;
+   unsigned int i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+
+   res.palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   res.ok = PUD_TRUE;
+
+   /* The second pass uses the minitiles cached by the first one */
+   for (i = 0; i < 2; i++)
+     {
+        res.tiles = 0;
+        fail_if(war2_decoder_tileset_decode(w2, dec, PUD_ERA_FOREST,
+                                            _tile_check_cb, &res) != FIXTURE_TILESET_TILES);
+        fail_if(res.tiles != FIXTURE_TILESET_TILES);
+        fail_if(!res.ok);
+     }
+
+   war2_decoder_free(dec);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(no_alloc)
+{
+#ifdef TESTS_ALLOC_COUNT
+   War2_Data *w2;
+   War2_Decoder *dec;
+   Sprites_Result res = { 0, 0, PUD_TRUE };
+   unsigned int i, tiles = 0;
+   size_t size;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+
+   /* The first pass grows the buffers of the decoder, the following ones
+    * must not allocate anything */
+   for (i = 0; i < 3; i++)
+     {
+        _alloc_count = 0;
+        _alloc_count_enabled = PUD_TRUE;
+
+        fail_if(war2_decoder_sprites_decode(w2, dec, PUD_PLAYER_RED, PUD_ERA_FOREST,
+                                            FIXTURE_OBJECT_SPRITE, _sprite_cb, &res) != PUD_TRUE);
+        fail_if(war2_decoder_sprites_decode_entry(w2, dec, PUD_PLAYER_GREEN, 33,
+                                                  _sprite_cb, &res) != PUD_TRUE);
+        fail_if(war2_decoder_ui_decode(w2, dec, FIXTURE_ENTRY_UI, NULL, NULL) == NULL);
+        fail_if(war2_decoder_cursors_decode(w2, dec, FIXTURE_ENTRY_CURSOR,
+                                            NULL, NULL, NULL, NULL) == NULL);
+        fail_if(war2_decoder_tileset_decode(w2, dec, PUD_ERA_FOREST, _tile_cb,
+                                            &tiles) != FIXTURE_TILESET_TILES);
+        fail_if(war2_decoder_entry_extract(w2, dec, FIXTURE_ENTRY_LZ_FAR, &size) == NULL);
+
+        _alloc_count_enabled = PUD_FALSE;
+        if (i > 0)
+          ck_assert_uint_eq(_alloc_count, 0);
+        else
+          fail_if(_alloc_count == 0);
+     }
+   fail_if(!res.mask_ok);
+
+   war2_decoder_free(dec);
+   war2_close(w2);
+   war2_shutdown();
+#endif
+}
+END_TEST
+
+typedef struct
+{
+   unsigned char buf[256 * 256 * 4];
+   unsigned int images;
+   Pud_Bool ok;
+} Pixels_Result;
+
+static void
+_pixels_check(Pixels_Result    *res,
+              const Pud_Color  *img,
+              const void       *pixels,
+              unsigned int      count,
+              Pud_Pixel_Format  pfmt)
+{
+   res->images++;
+   if ((!pixels) || (count * 4 > sizeof(res->buf)) ||
+       (!pud_pixels_convert(img, res->buf, count, pfmt)) ||
+       (memcmp(res->buf, pixels, count * pud_pixel_format_size(pfmt)) != 0))
+     res->ok = PUD_FALSE;
+}
+
+static void
+_pixels_sprite_cb(void                          *data,
+                  const Pud_Color               *img,
+                  int                            x,
+                  int                            y,
+                  unsigned int                   w,
+                  unsigned int                   h,
+                  const War2_Sprites_Descriptor *ud,
+                  uint16_t                       img_nb)
+{
+   (void) x;
+   (void) y;
+   (void) img_nb;
+   _pixels_check(data, img, ud->pixels, w * h, ud->pixel_format);
+}
+
+static void
+_pixels_tile_cb(void                          *data,
+                const Pud_Color               *img,
+                unsigned int                   w,
+                unsigned int                   h,
+                const War2_Tileset_Descriptor *ts,
+                uint16_t                       img_nb)
+{
+   (void) img_nb;
+   _pixels_check(data, img, ts->pixels, w * h, ts->pixel_format);
+}
+
+START_TEST(pixel_formats)
+{
+   War2_Data *w2;
+   War2_Decoder *dec;
+   Pixels_Result *res;
+   const Pud_Color *img;
+   unsigned int fmt, w, h;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+   res = malloc(sizeof(*res));
+   fail_if(res == NULL);
+
+   fail_if(war2_decoder_pixel_format_get(dec) != PUD_PIXEL_FORMAT_RGBA);
+   fail_if(war2_decoder_pixels_get(dec) != NULL);
+   fail_if(war2_decoder_pixel_format_set(dec, __PUD_PIXEL_FORMAT_LAST) != PUD_FALSE);
+
+   /* Whatever the format, the pixels are the RGBA images, converted */
+   for (fmt = 0; fmt < __PUD_PIXEL_FORMAT_LAST; fmt++)
+     {
+        fail_if(war2_decoder_pixel_format_set(dec, fmt) != PUD_TRUE);
+        fail_if(war2_decoder_pixel_format_get(dec) != fmt);
+        res->images = 0;
+        res->ok = PUD_TRUE;
+
+        /* Player colors are applied to the converted sprites */
+        fail_if(war2_decoder_sprites_decode(w2, dec, PUD_PLAYER_BLUE, PUD_ERA_FOREST,
+                                            FIXTURE_OBJECT_SPRITE, _pixels_sprite_cb,
+                                            res) != PUD_TRUE);
+        fail_if(war2_decoder_tileset_decode(w2, dec, PUD_ERA_FOREST, _pixels_tile_cb,
+                                            res) != FIXTURE_TILESET_TILES);
+
+        img = war2_decoder_ui_decode(w2, dec, FIXTURE_ENTRY_UI, &w, &h);
+        fail_if(img == NULL);
+        _pixels_check(res, img, war2_decoder_pixels_get(dec), w * h, fmt);
+        img = war2_decoder_cursors_decode(w2, dec, FIXTURE_ENTRY_CURSOR,
+                                          NULL, NULL, &w, &h);
+        fail_if(img == NULL);
+        _pixels_check(res, img, war2_decoder_pixels_get(dec), w * h, fmt);
+
+        fail_if(res->images < 4);
+        fail_if(!res->ok);
+     }
+
+   free(res);
+   war2_decoder_free(dec);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+static unsigned char *
+_file_read(const char *file,
+           size_t     *size)
+{
+   FILE *f;
+   unsigned char *buf;
+   long len;
+
+   f = fopen(file, "rb");
+   fail_if(f == NULL);
+   fseek(f, 0, SEEK_END);
+   len = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   buf = malloc(len);
+   fail_if(buf == NULL);
+   fail_if(fread(buf, 1, len, f) != (size_t)len);
+   fclose(f);
+   *size = len;
+   return buf;
+}
+
+START_TEST(ppm_write)
+{
+   /* More pixels than converted at once by the writer */
+   const unsigned int w = 5003, h = 2;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_ppm_write.ppm";
+   unsigned char *rgba, *buf;
+   size_t size, hdr, i;
+   char ascii[64];
+
+   rgba = malloc(w * h * 4);
+   fail_if(rgba == NULL);
+   for (i = 0; i < w * h * 4; i++)
+     rgba[i] = rand();
+
+   /* P6 */
+   fail_if(war2_ppm_write(file, w, h, rgba) != PUD_TRUE);
+   buf = _file_read(file, &size);
+   hdr = strlen("P6\n5003 2\n255\n");
+   fail_if(size != hdr + w * h * 3);
+   fail_if(memcmp(buf, "P6\n5003 2\n255\n", hdr) != 0);
+   for (i = 0; i < w * h; i++)
+     fail_if(memcmp(&(buf[hdr + i * 3]), &(rgba[i * 4]), 3) != 0);
+   free(buf);
+
+   /* PAM keeps the alpha */
+   fail_if(war2_ppm_format_write(file, w, h, rgba, WAR2_PPM_FORMAT_PAM) != PUD_TRUE);
+   buf = _file_read(file, &size);
+   fail_if(size < w * h * 4);
+   hdr = size - w * h * 4;
+   fail_if(memcmp(&(buf[hdr - 7]), "ENDHDR\n", 7) != 0);
+   fail_if(memcmp(&(buf[hdr]), rgba, w * h * 4) != 0);
+   free(buf);
+
+   /* P3 */
+   fail_if(war2_ppm_format_write(file, 1, 1, rgba, WAR2_PPM_FORMAT_P3) != PUD_TRUE);
+   buf = _file_read(file, &size);
+   snprintf(ascii, sizeof(ascii), "P3\n1 1\n255\n%u %u %u\n",
+            rgba[0], rgba[1], rgba[2]);
+   fail_if((size != strlen(ascii)) || (memcmp(buf, ascii, size) != 0));
+   free(buf);
+
+   fail_if(war2_ppm_write(TESTS_BUILD_DIR "/no/such/dir.ppm", w, h, rgba) != PUD_FALSE);
+   free(rgba);
+}
+END_TEST
+
+static Pud_Bool
+_failing_write(void                *data,
+               const unsigned char *bytes,
+               size_t               size)
+{
+   (void) data;
+   (void) bytes;
+   (void) size;
+   return PUD_FALSE;
+}
+
+static void
+_encoder_check(War2_Image_Format  format,
+               const Pud_Color   *img,
+               unsigned int       w,
+               unsigned int       h,
+               const char        *file)
+{
+   War2_Image_Encoder *enc;
+   const unsigned char *mem;
+   unsigned char *ref, *buf;
+   size_t size, ref_size;
+   FILE *f;
+
+   ref = _file_read(file, &ref_size);
+
+   /* In memory, rows given in several calls */
+   enc = war2_image_encoder_buffer_new(format, w, h);
+   fail_if(enc == NULL);
+   fail_if(war2_image_encoder_rows_write(enc, img, 1) != PUD_TRUE);
+   fail_if(war2_image_encoder_rows_write(enc, &(img[w]), h - 3) != PUD_TRUE);
+   fail_if(war2_image_encoder_finish(enc) != PUD_FALSE); /* Rows missing */
+   war2_image_encoder_free(enc);
+
+   enc = war2_image_encoder_buffer_new(format, w, h);
+   fail_if(enc == NULL);
+   fail_if(war2_image_encoder_rows_write(enc, img, 1) != PUD_TRUE);
+   fail_if(war2_image_encoder_rows_write(enc, &(img[w]), h - 1) != PUD_TRUE);
+   fail_if(war2_image_encoder_rows_write(enc, img, 1) != PUD_FALSE);
+   fail_if(war2_image_encoder_finish(enc) != PUD_TRUE);
+
+   /* Same bytes as the file writers */
+   mem = war2_image_encoder_buffer_get(enc, &size);
+   fail_if((size != ref_size) || (memcmp(ref, mem, size) != 0));
+   war2_image_encoder_free(enc);
+
+   /* File descriptor */
+   f = fopen(file, "wb");
+   fail_if(f == NULL);
+   enc = war2_image_encoder_fd_new(format, w, h, fileno(f));
+   fail_if(enc == NULL);
+   fail_if(war2_image_encoder_buffer_get(enc, &size) != NULL);
+   fail_if(war2_image_encoder_rows_write(enc, img, h) != PUD_TRUE);
+   fail_if(war2_image_encoder_finish(enc) != PUD_TRUE);
+   war2_image_encoder_free(enc);
+   fclose(f);
+   buf = _file_read(file, &size);
+   fail_if((size != ref_size) || (memcmp(buf, ref, size) != 0));
+   free(buf);
+   free(ref);
+
+   /* Failure of the output */
+   enc = war2_image_encoder_new(format, w, h, _failing_write, NULL);
+   fail_if(enc == NULL);
+   war2_image_encoder_rows_write(enc, img, h);
+   fail_if(war2_image_encoder_finish(enc) != PUD_FALSE);
+   war2_image_encoder_free(enc);
+}
+
+START_TEST(image_encoder)
+{
+   const unsigned int w = 83, h = 61;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_image_encoder.img";
+   War2_Image_Encoder *enc;
+   War2_Png_Options opts;
+   Pud_Color *img;
+   unsigned int i;
+
+   img = malloc(w * h * sizeof(Pud_Color));
+   fail_if(img == NULL);
+   for (i = 0; i < w * h; i++)
+     {
+        img[i].r = (i % w) * 3;
+        img[i].g = (i / w) * 4;
+        img[i].b = rand();
+        img[i].a = ((i % w) < 10) ? 0x00 : 0xff;
+     }
+
+   fail_if(war2_ppm_write(file, w, h, (unsigned char *)img) != PUD_TRUE);
+   _encoder_check(WAR2_IMAGE_FORMAT_PPM, img, w, h, file);
+   fail_if(war2_qoi_write(file, w, h, (unsigned char *)img) != PUD_TRUE);
+   _encoder_check(WAR2_IMAGE_FORMAT_QOI, img, w, h, file);
+#if HAVE_PNG
+   fail_if(war2_png_write(file, w, h, (unsigned char *)img) != PUD_TRUE);
+   _encoder_check(WAR2_IMAGE_FORMAT_PNG, img, w, h, file);
+#endif
+#if HAVE_JPEG
+   fail_if(war2_jpeg_write(file, w, h, (unsigned char *)img) != PUD_TRUE);
+   _encoder_check(WAR2_IMAGE_FORMAT_JPEG, img, w, h, file);
+#endif
+
+   /* Settings are rejected once rows are written, or by other formats */
+   enc = war2_image_encoder_buffer_new(WAR2_IMAGE_FORMAT_PPM, w, h);
+   fail_if(enc == NULL);
+   war2_png_options_init(&opts, WAR2_PNG_PROFILE_FAST);
+   fail_if(war2_image_encoder_png_options_set(enc, &opts) != PUD_FALSE);
+   fail_if(war2_image_encoder_jpeg_quality_set(enc, 90) != PUD_FALSE);
+   war2_image_encoder_free(enc);
+#if HAVE_PNG
+   enc = war2_image_encoder_buffer_new(WAR2_IMAGE_FORMAT_PNG, w, h);
+   fail_if(enc == NULL);
+   fail_if(war2_image_encoder_png_options_set(enc, &opts) != PUD_TRUE);
+   fail_if(war2_image_encoder_rows_write(enc, img, 1) != PUD_TRUE);
+   fail_if(war2_image_encoder_png_options_set(enc, NULL) != PUD_FALSE);
+   war2_image_encoder_free(enc);
+#endif
+
+   fail_if(war2_image_encoder_buffer_new(WAR2_IMAGE_FORMAT_PPM, 0, h) != NULL);
+   fail_if(war2_image_encoder_buffer_new(42, w, h) != NULL);
+   fail_if(war2_image_encoder_fd_new(WAR2_IMAGE_FORMAT_PPM, w, h, -1) != NULL);
+   fail_if(war2_image_encoder_new(WAR2_IMAGE_FORMAT_PPM, w, h, NULL, NULL) != NULL);
+
+   free(img);
+}
+END_TEST
+
+START_TEST(qoi_codec)
+{
+   /* Runs longer than a chunk, across rows, and every kind of chunk */
+   const unsigned int w = 97, h = 53;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_qoi_codec.qoi";
+   const unsigned char tiny[] = {
+        'q', 'o', 'i', 'f', 0, 0, 0, 2, 0, 0, 0, 1, 4, 0,
+        0xc0, /* Run of the initial color */
+        0x7a, /* Small difference */
+        0, 0, 0, 0, 0, 0, 0, 1
+   };
+   const Pud_Color tiny_img[2] = { { 0, 0, 0, 0xff }, { 1, 0, 0, 0xff } };
+   Pud_Color *img, *decoded;
+   unsigned char *buf;
+   unsigned int i, dw, dh;
+   size_t size;
+
+   fail_if(war2_qoi_write(file, 2, 1, (unsigned char *)tiny_img) != PUD_TRUE);
+   buf = _file_read(file, &size);
+   fail_if((size != sizeof(tiny)) || (memcmp(buf, tiny, size) != 0));
+   free(buf);
+
+   img = malloc(w * h * sizeof(Pud_Color));
+   fail_if(img == NULL);
+   for (i = 0; i < w * h; i++)
+     {
+        if (i < w * 2 + 10)
+          img[i] = (Pud_Color){ 0x10, 0x20, 0x30, 0xff };
+        else if (i % 7 == 0)
+          img[i] = (Pud_Color){ rand(), rand(), rand(), rand() };
+        else
+          img[i] = (Pud_Color){ i / 3, (i / 3) + (i % 5), i % 9, 0xff };
+     }
+
+   fail_if(war2_qoi_write(file, w, h, (unsigned char *)img) != PUD_TRUE);
+   decoded = war2_qoi_read(file, &dw, &dh);
+   fail_if(decoded == NULL);
+   fail_if((dw != w) || (dh != h));
+   fail_if(memcmp(decoded, img, w * h * sizeof(Pud_Color)) != 0);
+   free(decoded);
+
+   /* Truncated images are rejected */
+   buf = _file_read(file, &size);
+   fail_if(size >= w * h * 4);
+   for (i = 0; i < size - 8; i += 401)
+     fail_if(war2_qoi_decode(buf, i, NULL, NULL) != NULL);
+   buf[0] = 'Q';
+   fail_if(war2_qoi_decode(buf, size, NULL, NULL) != NULL);
+   free(buf);
+
+   fail_if(war2_qoi_write(file, 0, h, (unsigned char *)img) != PUD_FALSE);
+   fail_if(war2_qoi_read(TESTS_BUILD_DIR "/no/such/file.qoi", NULL, NULL) != NULL);
+   free(img);
+}
+END_TEST
+
+START_TEST(qoi_buffer_full)
+{
+   /* Pixels that all need a QOI_OP_RGBA chunk: 13104 of them and the
+    * header exactly fill the output buffer of the encoder */
+   const unsigned int w = 13104, h = 4;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_qoi_buffer_full.qoi";
+   Pud_Color *img, *decoded;
+   unsigned int i, rows, dw, dh;
+
+   img = malloc(w * h * sizeof(Pud_Color));
+   fail_if(img == NULL);
+   for (i = 0; i < w * h; i++)
+     {
+        img[i].r = i & 0xff;
+        img[i].g = (i >> 8) & 0xff;
+        img[i].b = (i >> 16) & 0xff;
+        img[i].a = (i % 2) ? 0x80 : 0xff;
+     }
+   /* The second row ends with a run, carried to the start of the third */
+   img[2 * w - 1] = img[2 * w - 2] = img[2 * w - 3];
+
+   for (rows = 1; rows <= h; rows += h - 1)
+     {
+        fail_if(war2_qoi_write(file, w, rows, (unsigned char *)img) != PUD_TRUE);
+        decoded = war2_qoi_read(file, &dw, &dh);
+        fail_if(decoded == NULL);
+        fail_if((dw != w) || (dh != rows));
+        fail_if(memcmp(decoded, img, w * rows * sizeof(Pud_Color)) != 0);
+        free(decoded);
+     }
+   free(img);
+}
+END_TEST
+
+#if HAVE_PNG
+START_TEST(png_options)
+{
+   const unsigned int w = 64, h = 48;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_png_options.png";
+   const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+   War2_Png_Options opts;
+   Pud_Color *img;
+   unsigned char *buf;
+   size_t size, stored, small;
+   unsigned int i;
+
+   img = malloc(w * h * sizeof(Pud_Color));
+   fail_if(img == NULL);
+   for (i = 0; i < w * h; i++)
+     {
+        img[i].r = (i % w) * 4;
+        img[i].g = (i / w) * 5;
+        img[i].b = ((i / 8) % 3) * 100;
+        img[i].a = 0xff;
+     }
+
+   for (i = WAR2_PNG_PROFILE_DEFAULT; i <= WAR2_PNG_PROFILE_SMALL; i++)
+     {
+        war2_png_options_init(&opts, i);
+        fail_if(war2_png_write_full(file, w, h, (unsigned char *)img, &opts) != PUD_TRUE);
+        buf = _file_read(file, &size);
+        fail_if((size < 8) || (memcmp(buf, signature, 8) != 0));
+        free(buf);
+        if (i == WAR2_PNG_PROFILE_SMALL) small = size;
+     }
+
+   /* Level 0 stores the pixels */
+   war2_png_options_init(&opts, WAR2_PNG_PROFILE_DEFAULT);
+   opts.compression_level = 0;
+   opts.filter = WAR2_PNG_FILTER_NONE;
+   fail_if(war2_png_write_full(file, w, h, (unsigned char *)img, &opts) != PUD_TRUE);
+   free(_file_read(file, &stored));
+   fail_if(stored <= w * h * 4);
+   fail_if(small >= stored);
+
+   /* Invalid options */
+   opts.compression_level = 10;
+   fail_if(war2_png_write_full(file, w, h, (unsigned char *)img, &opts) != PUD_FALSE);
+   opts.compression_level = 6;
+   opts.filter = 42;
+   fail_if(war2_png_write_full(file, w, h, (unsigned char *)img, &opts) != PUD_FALSE);
+
+   free(img);
+}
+END_TEST
+
+START_TEST(png_indexed)
+{
+   const unsigned int w = 137, h = 129;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_png_indexed.png";
+   War2_Data *w2;
+   const Pud_Color *palette;
+   unsigned char idx[137 * 129];
+   Pud_Color rgba[137 * 129], decoded[137 * 129];
+   size_t indexed_size, rgba_size;
+   png_image image;
+   unsigned int i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+
+   /* Transparent areas and runs, like sprites */
+   for (i = 0; i < w * h; i++)
+     {
+        idx[i] = ((i % w) < 5) ? 0 : ((i / 3) % 40) + 100;
+        rgba[i] = palette[idx[i]];
+     }
+
+   fail_if(war2_png_indexed_write(file, w, h, idx, palette,
+                                  WAR2_PALETTE_SIZE, NULL) != PUD_TRUE);
+   free(_file_read(file, &indexed_size));
+
+   /* Decodes to the colors of the palette, alpha included */
+   memset(&image, 0, sizeof(image));
+   image.version = PNG_IMAGE_VERSION;
+   fail_if(png_image_begin_read_from_file(&image, file) == 0);
+   fail_if((image.width != w) || (image.height != h));
+   fail_if(!(image.format & PNG_FORMAT_FLAG_COLORMAP));
+   image.format = PNG_FORMAT_RGBA;
+   fail_if(png_image_finish_read(&image, NULL, decoded, 0, NULL) == 0);
+   for (i = 0; i < w * h; i++)
+     {
+        fail_if(decoded[i].a != rgba[i].a);
+        if (rgba[i].a != 0)
+          fail_if(memcmp(&(decoded[i]), &(rgba[i]), sizeof(Pud_Color)) != 0);
+     }
+
+   fail_if(war2_png_write(file, w, h, (unsigned char *)rgba) != PUD_TRUE);
+   free(_file_read(file, &rgba_size));
+   fail_if(indexed_size >= rgba_size);
+
+   /* Indexes out of the palette */
+   fail_if(war2_png_indexed_write(file, w, h, idx, palette, 120, NULL) != PUD_FALSE);
+   fail_if(war2_png_indexed_write(file, w, h, idx, palette, 0, NULL) != PUD_FALSE);
+   fail_if(war2_png_indexed_write(file, w, h, idx, palette, 257, NULL) != PUD_FALSE);
+   fail_if(war2_png_indexed_write(file, w, h, idx, NULL, 256, NULL) != PUD_FALSE);
+
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(png_parallel)
+{
+   /* Several stripes, with rows that match the ones of other stripes */
+   const unsigned int w = 301, h = 517;
+   const char *const file = TESTS_BUILD_DIR "/libwar2_png_parallel.png";
+   War2_Png_Options opts;
+   Pud_Color *img, *decoded;
+   png_image image;
+   unsigned int i, k;
+   size_t parallel, serial;
+
+   img = malloc(w * h * sizeof(Pud_Color));
+   decoded = malloc(w * h * sizeof(Pud_Color));
+   fail_if((!img) || (!decoded));
+   for (i = 0; i < w * h; i++)
+     {
+        img[i].r = ((i % w) / 7) * 3;
+        img[i].g = ((i / w) % 64) * 4;
+        img[i].b = (i % 11 == 0) ? rand() : 0x20;
+        img[i].a = ((i % w) < 20) ? 0x00 : 0xff;
+     }
+
+   for (k = WAR2_PNG_FILTER_DEFAULT; k <= WAR2_PNG_FILTER_ADAPTIVE; k++)
+     {
+        war2_png_options_init(&opts, WAR2_PNG_PROFILE_DEFAULT);
+        opts.filter = k;
+        fail_if(war2_png_parallel_write(file, w, h, (unsigned char *)img, &opts) != PUD_TRUE);
+
+        memset(&image, 0, sizeof(image));
+        image.version = PNG_IMAGE_VERSION;
+        fail_if(png_image_begin_read_from_file(&image, file) == 0);
+        fail_if((image.width != w) || (image.height != h));
+        image.format = PNG_FORMAT_RGBA;
+        fail_if(png_image_finish_read(&image, NULL, decoded, 0, NULL) == 0);
+        fail_if(memcmp(decoded, img, w * h * sizeof(Pud_Color)) != 0);
+     }
+
+   /* Priming the stripes keeps the size close to a single stream */
+   fail_if(war2_png_parallel_write(file, w, h, (unsigned char *)img, NULL) != PUD_TRUE);
+   free(_file_read(file, &parallel));
+   fail_if(war2_png_write(file, w, h, (unsigned char *)img) != PUD_TRUE);
+   free(_file_read(file, &serial));
+   fail_if(parallel > serial + serial / 10);
+
+   /* Single row */
+   fail_if(war2_png_parallel_write(file, w, 1, (unsigned char *)img, NULL) != PUD_TRUE);
+   memset(&image, 0, sizeof(image));
+   image.version = PNG_IMAGE_VERSION;
+   fail_if(png_image_begin_read_from_file(&image, file) == 0);
+   image.format = PNG_FORMAT_RGBA;
+   fail_if(png_image_finish_read(&image, NULL, decoded, 0, NULL) == 0);
+   fail_if(memcmp(decoded, img, w * sizeof(Pud_Color)) != 0);
+
+   fail_if(war2_png_parallel_write(file, 0, h, (unsigned char *)img, NULL) != PUD_FALSE);
+
+   free(img);
+   free(decoded);
+}
+END_TEST
+#endif
+
+void
+test_decoder(TCase *tc)
+{
+   tcase_add_test(tc, entry_lz);
+   tcase_add_test(tc, entry_truncated);
+   tcase_add_test(tc, compat);
+   tcase_add_test(tc, cursors_atlas);
+   tcase_add_test(tc, tileset_minitiles);
+   tcase_add_test(tc, no_alloc);
+   tcase_add_test(tc, pixel_formats);
+   tcase_add_test(tc, ppm_write);
+   tcase_add_test(tc, image_encoder);
+   tcase_add_test(tc, qoi_codec);
+   tcase_add_test(tc, qoi_buffer_full);
+#if HAVE_PNG
+   tcase_add_test(tc, png_options);
+   tcase_add_test(tc, png_indexed);
+   tcase_add_test(tc, png_parallel);
+#endif
+}
@@ -0,0 +1,158 @@
+#include "tests.h"
+#include <war2.h>
+
+typedef struct
+{
+   const War2_Font_Atlas *atlas;
+   unsigned int glyphs;
+   unsigned int empty;
+   unsigned int pixels;
+   Pud_Bool ok;
+} Font_Check;
+
+static void
+_glyph_start(void *data, uint8_t glyph, size_t width, size_t height,
+             size_t x_offset, size_t y_offset)
+{
+   Font_Check *chk = data;
+   const War2_Font_Glyph *g = &(chk->atlas->glyphs[glyph]);
+
+   chk->glyphs++;
+   if ((width != g->w) || (height != g->h) ||
+       (x_offset != g->x_offset) || (y_offset != g->y_offset))
+     chk->ok = PUD_FALSE;
+}
+
+static void
+_glyph_end(void *data, uint8_t glyph)
+{
+   (void) data;
+   (void) glyph;
+}
+
+static void
+_glyph_pixel(void *data, uint8_t glyph, size_t x, size_t y, Pud_Color color)
+{
+   Font_Check *chk = data;
+   const War2_Font_Atlas *atlas = chk->atlas;
+   const War2_Font_Glyph *g = &(atlas->glyphs[glyph]);
+
+   chk->pixels++;
+   if (memcmp(&(atlas->rgba[(g->y + y) * atlas->w + g->x + x]), &color,
+              sizeof(Pud_Color)) != 0)
+     chk->ok = PUD_FALSE;
+}
+
+static void
+_glyph_empty(void *data, uint8_t glyph)
+{
+   Font_Check *chk = data;
+
+   chk->empty++;
+   if ((glyph != ' ') && (glyph != '"'))
+     chk->ok = PUD_FALSE;
+}
+
+START_TEST(font_atlas)
+{
+   War2_Data *w2;
+   War2_Font_Atlas *atlas;
+   Font_Check chk;
+   const War2_Font_Decoder decoder = {
+      .start = NULL,
+      .end = NULL,
+      .glyph_start = _glyph_start,
+      .glyph_end = _glyph_end,
+      .glyph_pixel = _glyph_pixel,
+      .glyph_empty = _glyph_empty,
+      .data = &chk,
+   };
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   atlas = war2_font_atlas_new(w2, WAR2_FONT_GAME);
+   fail_if(atlas == NULL);
+   fail_if(atlas->line_height != 5);
+   fail_if((atlas->glyphs['!'].w != 1) || (atlas->glyphs['!'].h != 3));
+   fail_if(atlas->glyphs['!'].advance != 3);
+   fail_if(atlas->glyphs['#'].advance != 4);
+   fail_if((atlas->glyphs[' '].w != 0) || (atlas->glyphs[' '].advance != 2));
+   fail_if(atlas->glyphs['A'].advance != 0);
+
+   /* The atlas has the pixels given to the decoding callbacks */
+   chk.atlas = atlas;
+   chk.glyphs = chk.empty = chk.pixels = 0;
+   chk.ok = PUD_TRUE;
+   fail_if(war2_font_decode(w2, WAR2_FONT_GAME, &decoder) != PUD_TRUE);
+   fail_if((chk.glyphs != 2) || (chk.empty != 2) || (chk.pixels != 3 + 6));
+   fail_if(!chk.ok);
+
+   war2_font_atlas_free(atlas);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(text_render)
+{
+   War2_Data *w2;
+   War2_Font_Atlas *atlas;
+   const Pud_Color *palette;
+   Pud_Color img[10 * 10], small[3 * 3];
+   const Pud_Color marker = { 1, 2, 3, 4 };
+   unsigned int w, h, i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   atlas = war2_font_atlas_new(w2, WAR2_FONT_GAME);
+   fail_if(atlas == NULL);
+
+   fail_if(war2_text_size_get(atlas, "! #\n!", &w, &h) != PUD_TRUE);
+   fail_if((w != 3 + 2 + 4) || (h != 2 * 5));
+
+   /* Missing characters are skipped, invalid UTF-8 does not swallow the
+    * next character */
+   fail_if(war2_text_size_get(atlas, "\xe2\x82\xac!", &w, NULL) != PUD_TRUE);
+   fail_if(w != 3);
+   fail_if(war2_text_size_get(atlas, "\xc3!", &w, NULL) != PUD_TRUE);
+   fail_if(w != 3);
+
+   for (i = 0; i < 10 * 10; i++) img[i] = marker;
+   fail_if(war2_text_render(atlas, "!#", img, 10, 10, 0, 0) != PUD_TRUE);
+   for (i = 0; i < 10 * 10; i++)
+     {
+        switch (i)
+          {
+           case 1 * 10 + 1: fail_if(memcmp(&img[i], &palette[0xc8], sizeof(Pud_Color))); break;
+           case 2 * 10 + 1: fail_if(memcmp(&img[i], &palette[0xc7], sizeof(Pud_Color))); break;
+           case 3 * 10 + 1: fail_if(memcmp(&img[i], &palette[0xc0], sizeof(Pud_Color))); break;
+           case 2 * 10 + 4: fail_if(memcmp(&img[i], &palette[0xc8], sizeof(Pud_Color))); break;
+           case 3 * 10 + 5: fail_if(memcmp(&img[i], &palette[0xc7], sizeof(Pud_Color))); break;
+           default: fail_if(memcmp(&img[i], &marker, sizeof(Pud_Color))); break;
+          }
+     }
+
+   /* Clipped on all sides */
+   for (i = 0; i < 3 * 3; i++) small[i] = marker;
+   fail_if(war2_text_render(atlas, "!!!!", small, 3, 3, -1, -2) != PUD_TRUE);
+   fail_if(memcmp(&small[0], &palette[0xc7], sizeof(Pud_Color)));
+   fail_if(memcmp(&small[3], &palette[0xc0], sizeof(Pud_Color)));
+   fail_if(memcmp(&small[1], &marker, sizeof(Pud_Color)));
+   fail_if(memcmp(&small[6], &marker, sizeof(Pud_Color)));
+
+   war2_font_atlas_free(atlas);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+void
+test_font(TCase *tc)
+{
+   tcase_add_test(tc, font_atlas);
+   tcase_add_test(tc, text_render);
+}
@@ -0,0 +1,398 @@
+#include "tests.h"
+#include <war2.h>
+
+typedef struct
+{
+   Pud_Color *img;
+   unsigned int w;
+   unsigned int rows;
+   Pud_Bool ok;
+} Map_Image;
+
+static Pud_Bool
+_band_cb(void            *data,
+         const Pud_Color *band,
+         unsigned int     y,
+         unsigned int     w,
+         unsigned int     h)
+{
+   Map_Image *img = data;
+
+   /* Bands come in order and cover the whole map */
+   if ((y != img->rows) || (w != img->w))
+     img->ok = PUD_FALSE;
+   else
+     memcpy(&(img->img[y * w]), band, w * h * sizeof(Pud_Color));
+   img->rows += h;
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_abort_cb(void            *data,
+          const Pud_Color *band,
+          unsigned int     y,
+          unsigned int     w,
+          unsigned int     h)
+{
+   unsigned int *calls = data;
+
+   (void) band;
+   (void) y;
+   (void) w;
+   (void) h;
+   (*calls)++;
+   return PUD_FALSE;
+}
+
+START_TEST(map_render)
+{
+   War2_Data *w2;
+   War2_Tileset_Atlas *atlas;
+   Pud *pud;
+   Map_Image img;
+   const Pud_Color *palette;
+   const Pud_Color black = { 0, 0, 0, 0xff };
+   unsigned int x, y, ax, ay, calls = 0;
+   int ux, uy;
+
+   fail_if(war2_init() != PUD_TRUE);
+   fail_if(pud_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   atlas = war2_tileset_atlas_new(w2, PUD_ERA_FOREST, WAR2_TILESET_ATLAS_RGBA);
+   fail_if(atlas == NULL);
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+
+   /* New 32x32 forest map */
+   pud = pud_open(TESTS_BUILD_DIR "/libwar2_map_render.pud", PUD_OPEN_MODE_W);
+   fail_if(pud == NULL);
+   fail_if(!pud_tile_set(pud, 1, 2, 0x0010));
+   fail_if(!pud_tile_set(pud, 31, 31, 0x0100));
+   fail_if(!pud_unit_add(pud, 3, 4, PUD_PLAYER_BLUE, FIXTURE_OBJECT_SPRITE, 0));
+
+   img.w = pud->map_w * 32;
+   img.rows = 0;
+   img.ok = PUD_TRUE;
+   img.img = malloc(img.w * pud->map_h * 32 * sizeof(Pud_Color));
+   fail_if(img.img == NULL);
+
+   fail_if(war2_map_render(w2, pud, _band_cb, &img) != PUD_TRUE);
+   fail_if((!img.ok) || (img.rows != pud->map_h * 32));
+
+   /* Terrain: tiles of the tileset, black elsewhere */
+   fail_if(!war2_tileset_atlas_rect_get(atlas, 0x0010, &ax, &ay));
+   for (y = 0; y < 32; y++)
+     fail_if(memcmp(&(img.img[(2 * 32 + y) * img.w + 1 * 32]),
+                    &(atlas->rgba[(ay + y) * atlas->w + ax]),
+                    32 * sizeof(Pud_Color)) != 0);
+   fail_if(!war2_tileset_atlas_rect_get(atlas, 0x0100, &ax, &ay));
+   for (y = 0; y < 32; y++)
+     fail_if(memcmp(&(img.img[(31 * 32 + y) * img.w + 31 * 32]),
+                    &(atlas->rgba[(ay + y) * atlas->w + ax]),
+                    32 * sizeof(Pud_Color)) != 0);
+   fail_if(memcmp(&(img.img[10 * 32 * img.w + 10 * 32]), &black, sizeof(black)) != 0);
+
+   /* The first frame of the unit (70x3) is centered on its cell. Its
+    * first row has 10 transparent pixels, 5 colors then color 9. */
+   ux = (3 * 32) + (32 - 70) / 2;
+   uy = (4 * 32) + (32 - 3) / 2;
+   for (x = 0; x < 10; x++)
+     fail_if(memcmp(&(img.img[uy * img.w + ux + x]), &black, sizeof(black)) != 0);
+   for (x = 10; x < 15; x++)
+     fail_if(memcmp(&(img.img[uy * img.w + ux + x]), &(palette[x - 9]),
+                    sizeof(Pud_Color)) != 0);
+   for (x = 15; x < 70; x++)
+     fail_if(memcmp(&(img.img[uy * img.w + ux + x]), &(palette[9]),
+                    sizeof(Pud_Color)) != 0);
+
+   /* The rendering can be aborted */
+   fail_if(war2_map_render(w2, pud, _abort_cb, &calls) != PUD_FALSE);
+   fail_if(calls != 1);
+
+   free(img.img);
+   pud_close(pud);
+   war2_tileset_atlas_free(atlas);
+   war2_close(w2);
+   pud_shutdown();
+   war2_shutdown();
+}
+END_TEST
+
+static Pud_Bool
+_abort_pyramid_cb(void            *data,
+                  const Pud_Color *tile,
+                  unsigned int     z,
+                  unsigned int     x,
+                  unsigned int     y)
+{
+   (void) data;
+   (void) tile;
+   (void) z;
+   (void) x;
+   (void) y;
+   return PUD_FALSE;
+}
+
+static void
+_map_image_check(War2_Data               *w2,
+                 const Pud               *pud,
+                 const War2_Map_Renderer *r)
+{
+   Map_Image img;
+   const Pud_Color *pixels;
+   unsigned int w, h;
+
+   img.w = pud->map_w * 32;
+   img.rows = 0;
+   img.ok = PUD_TRUE;
+   img.img = malloc(img.w * pud->map_h * 32 * sizeof(Pud_Color));
+   fail_if(img.img == NULL);
+   fail_if(war2_map_render(w2, pud, _band_cb, &img) != PUD_TRUE);
+
+   pixels = war2_map_renderer_pixels_get(r, &w, &h);
+   fail_if(pixels == NULL);
+   fail_if((w != img.w) || (h != img.rows));
+   fail_if(memcmp(pixels, img.img, w * h * sizeof(Pud_Color)) != 0);
+   free(img.img);
+}
+
+START_TEST(map_renderer)
+{
+   War2_Data *w2;
+   War2_Map_Renderer *r;
+   Pud *pud;
+   War2_Map_Cell cells[3];
+   War2_Map_Rect dirty;
+
+   fail_if(war2_init() != PUD_TRUE);
+   fail_if(pud_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   pud = pud_open(TESTS_BUILD_DIR "/libwar2_map_renderer.pud", PUD_OPEN_MODE_W);
+   fail_if(pud == NULL);
+   fail_if(!pud_tile_set(pud, 1, 2, 0x0010));
+   fail_if(!pud_unit_add(pud, 3, 4, PUD_PLAYER_RED, FIXTURE_OBJECT_SPRITE, 0));
+
+   r = war2_map_renderer_new(w2, pud);
+   fail_if(r == NULL);
+   _map_image_check(w2, pud, r);
+
+   /* Nothing changed */
+   fail_if(war2_map_renderer_update(r, NULL, 0, &dirty) != PUD_TRUE);
+   fail_if((dirty.w != 0) || (dirty.h != 0));
+
+   /* A tile under the sprite of the existing unit changes */
+   fail_if(!pud_tile_set(pud, 2, 4, 0x0100));
+   cells[0].x = 2;
+   cells[0].y = 4;
+   fail_if(war2_map_renderer_update(r, cells, 1, &dirty) != PUD_TRUE);
+   fail_if((dirty.x != 2 * 32) || (dirty.y != 4 * 32) || (dirty.w != 32) || (dirty.h != 32));
+   _map_image_check(w2, pud, r);
+
+   /* A unit is added: all the cells covered by its sprite are redrawn */
+   fail_if(!pud_unit_add(pud, 20, 30, PUD_PLAYER_GREEN, FIXTURE_OBJECT_SPRITE, 0));
+   cells[0].x = 20;
+   cells[0].y = 30;
+   fail_if(war2_map_renderer_update(r, cells, 1, &dirty) != PUD_TRUE);
+   fail_if((dirty.x != 19 * 32) || (dirty.w != 3 * 32) || (dirty.y != 30 * 32) || (dirty.h != 32));
+   _map_image_check(w2, pud, r);
+
+   /* The last unit is removed, and the first one is reported as well */
+   pud->units_count--;
+   cells[1].x = 3;
+   cells[1].y = 4;
+   fail_if(war2_map_renderer_update(r, cells, 2, &dirty) != PUD_TRUE);
+   _map_image_check(w2, pud, r);
+
+   /* Units stacked on the same cells keep the order of a full rendering */
+   fail_if(!pud_unit_add(pud, 10, 10, PUD_PLAYER_BLUE, FIXTURE_OBJECT_SPRITE, 0));
+   fail_if(!pud_unit_add(pud, 11, 10, PUD_PLAYER_RED, FIXTURE_OBJECT_SPRITE, 0));
+   fail_if(!pud_unit_add(pud, 10, 10, PUD_PLAYER_GREEN, FIXTURE_OBJECT_SPRITE, 0));
+   cells[0].x = 10;
+   cells[0].y = 10;
+   cells[1].x = 11;
+   cells[1].y = 10;
+   fail_if(war2_map_renderer_update(r, cells, 2, &dirty) != PUD_TRUE);
+   _map_image_check(w2, pud, r);
+
+   /* A unit moves over the others: it is drawn at its new place */
+   pud->units[0].x = 11;
+   pud->units[0].y = 10;
+   cells[0].x = 3;
+   cells[0].y = 4;
+   cells[1].x = 11;
+   cells[1].y = 10;
+   fail_if(war2_map_renderer_update(r, cells, 2, &dirty) != PUD_TRUE);
+   _map_image_check(w2, pud, r);
+
+   /* The map is resized */
+   fail_if(!pud_dimensions_set(pud, PUD_DIMENSIONS_64_64));
+   fail_if(war2_map_renderer_update(r, NULL, 0, &dirty) != PUD_TRUE);
+   fail_if((dirty.w != 64 * 32) || (dirty.h != 64 * 32));
+   _map_image_check(w2, pud, r);
+
+   war2_map_renderer_free(r);
+   pud_close(pud);
+   war2_close(w2);
+   pud_shutdown();
+   war2_shutdown();
+}
+END_TEST
+
+#define PYRAMID_MAP 32 /* Map size, in tiles */
+#define PYRAMID_TILES_MAX ((PYRAMID_MAP * 32) / WAR2_MAP_PYRAMID_TILE_SIZE)
+
+typedef struct
+{
+   /* Each level, padded to whole images */
+   Pud_Color *levels[WAR2_MAP_PYRAMID_LEVELS];
+   unsigned int seen[WAR2_MAP_PYRAMID_LEVELS][PYRAMID_TILES_MAX][PYRAMID_TILES_MAX];
+} Pyramid;
+
+static unsigned int
+_pyramid_stride(unsigned int z)
+{
+   const unsigned int w = PYRAMID_MAP << z;
+   return ((w + WAR2_MAP_PYRAMID_TILE_SIZE - 1) / WAR2_MAP_PYRAMID_TILE_SIZE) *
+      WAR2_MAP_PYRAMID_TILE_SIZE;
+}
+
+static Pud_Bool
+_pyramid_cb(void            *data,
+            const Pud_Color *tile,
+            unsigned int     z,
+            unsigned int     x,
+            unsigned int     y)
+{
+   Pyramid *p = data;
+   const unsigned int stride = _pyramid_stride(z);
+   unsigned int row;
+
+   /* Images are given concurrently, but each one has its own slot */
+   if ((z >= WAR2_MAP_PYRAMID_LEVELS) || (x >= PYRAMID_TILES_MAX) ||
+       (y >= PYRAMID_TILES_MAX) || ((x + 1) * WAR2_MAP_PYRAMID_TILE_SIZE > stride))
+     return PUD_FALSE;
+   p->seen[z][y][x]++;
+   for (row = 0; row < WAR2_MAP_PYRAMID_TILE_SIZE; row++)
+     memcpy(&(p->levels[z][(y * WAR2_MAP_PYRAMID_TILE_SIZE + row) * stride +
+                           x * WAR2_MAP_PYRAMID_TILE_SIZE]),
+            &(tile[row * WAR2_MAP_PYRAMID_TILE_SIZE]),
+            WAR2_MAP_PYRAMID_TILE_SIZE * sizeof(Pud_Color));
+   return PUD_TRUE;
+}
+
+START_TEST(map_pyramid)
+{
+   War2_Data *w2;
+   Pud *pud;
+   Pyramid *p;
+   Map_Image img;
+   const Pud_Color *a, *b, *c, *d, *px;
+   Pud_Color mini;
+   unsigned int z, x, y, stride, tiles, k;
+   const Pud_Color transparent = { 0, 0, 0, 0 };
+
+   fail_if(war2_init() != PUD_TRUE);
+   fail_if(pud_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   pud = pud_open(TESTS_BUILD_DIR "/libwar2_map_pyramid.pud", PUD_OPEN_MODE_RW);
+   fail_if(pud == NULL);
+   fail_if(pud->map_w != PYRAMID_MAP);
+   fail_if(!pud_tile_set(pud, 1, 2, 0x0010));
+   fail_if(!pud_tile_set(pud, 9, 9, 0x0100));
+   fail_if(!pud_unit_add(pud, 3, 4, PUD_PLAYER_BLUE, FIXTURE_OBJECT_SPRITE, 0));
+
+   p = calloc(1, sizeof(Pyramid));
+   fail_if(p == NULL);
+   for (z = 0; z < WAR2_MAP_PYRAMID_LEVELS; z++)
+     {
+        stride = _pyramid_stride(z);
+        p->levels[z] = malloc(stride * stride * sizeof(Pud_Color));
+        fail_if(p->levels[z] == NULL);
+     }
+
+   fail_if(war2_map_pyramid(w2, pud, _pyramid_cb, p) != PUD_TRUE);
+
+   /* Every image of every level is given exactly once */
+   for (z = 0; z < WAR2_MAP_PYRAMID_LEVELS; z++)
+     {
+        tiles = _pyramid_stride(z) / WAR2_MAP_PYRAMID_TILE_SIZE;
+        for (y = 0; y < PYRAMID_TILES_MAX; y++)
+          for (x = 0; x < PYRAMID_TILES_MAX; x++)
+            fail_if(p->seen[z][y][x] != (((x < tiles) && (y < tiles)) ? 1 : 0));
+     }
+
+   /* The top level is the full rendering of the map */
+   img.w = PYRAMID_MAP * 32;
+   img.rows = 0;
+   img.ok = PUD_TRUE;
+   img.img = malloc(img.w * img.w * sizeof(Pud_Color));
+   fail_if(img.img == NULL);
+   fail_if(war2_map_render(w2, pud, _band_cb, &img) != PUD_TRUE);
+   fail_if(memcmp(p->levels[WAR2_MAP_PYRAMID_LEVELS - 1], img.img,
+                  img.w * img.w * sizeof(Pud_Color)) != 0);
+   free(img.img);
+
+   /* Levels with at least 4 pixels per tile are downsampled */
+   for (z = WAR2_MAP_PYRAMID_LEVELS - 1; z > 2; z--)
+     {
+        stride = _pyramid_stride(z);
+        for (y = 0; y < (PYRAMID_MAP << (z - 1)); y++)
+          for (x = 0; x < (PYRAMID_MAP << (z - 1)); x++)
+            {
+               a = &(p->levels[z][(2 * y) * stride + (2 * x)]);
+               b = a + 1;
+               c = a + stride;
+               d = c + 1;
+               px = &(p->levels[z - 1][y * _pyramid_stride(z - 1) + x]);
+               fail_if(px->r != (a->r + b->r + c->r + d->r + 2) / 4);
+               fail_if(px->g != (a->g + b->g + c->g + d->g + 2) / 4);
+               fail_if(px->b != (a->b + b->b + c->b + d->b + 2) / 4);
+               fail_if(px->a != (a->a + b->a + c->a + d->a + 2) / 4);
+            }
+     }
+
+   /* The two lowest levels are the minimap, and are padded */
+   for (z = 0; z < 2; z++)
+     {
+        stride = _pyramid_stride(z);
+        for (y = 0; y < stride; y++)
+          for (x = 0; x < stride; x++)
+            {
+               px = &(p->levels[z][y * stride + x]);
+               if ((x >= (PYRAMID_MAP << z)) || (y >= (PYRAMID_MAP << z)))
+                 {
+                    fail_if(memcmp(px, &transparent, sizeof(Pud_Color)) != 0);
+                    continue;
+                 }
+               mini = pud_minimap_tile_to_color(PUD_ERA_FOREST,
+                                                pud->tiles_map[(y >> z) * PYRAMID_MAP + (x >> z)]);
+               if (((x >> z) == 3) && ((y >> z) == 4)) /* Unit */
+                 mini = pud_minimap_color_for_unit(FIXTURE_OBJECT_SPRITE, PUD_PLAYER_BLUE);
+               fail_if(memcmp(px, &mini, sizeof(Pud_Color)) != 0);
+            }
+     }
+
+   /* Failures of the callback are reported */
+   for (k = 0; k < WAR2_MAP_PYRAMID_LEVELS; k++)
+     free(p->levels[k]);
+   free(p);
+   fail_if(war2_map_pyramid(w2, pud, _abort_pyramid_cb, NULL) != PUD_FALSE);
+
+   pud_close(pud);
+   war2_close(w2);
+   pud_shutdown();
+   war2_shutdown();
+}
+END_TEST
+
+void
+test_map(TCase *tc)
+{
+   tcase_add_test(tc, map_render);
+   tcase_add_test(tc, map_renderer);
+   tcase_add_test(tc, map_pyramid);
+}
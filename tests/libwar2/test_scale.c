@@ -0,0 +1,122 @@
+#include "tests.h"
+#include <war2.h>
+
+static void
+_expand(const unsigned char *idx,
+        unsigned int         count,
+        const Pud_Color     *palette,
+        Pud_Color           *out)
+{
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     out[i] = palette[idx[i]];
+}
+
+START_TEST(scale_nearest)
+{
+   const unsigned char src[2 * 2] = { 1, 2, 3, 4 };
+   unsigned char dst[6 * 6];
+   unsigned int x, y;
+
+   fail_if(war2_scale_indexed(src, 2, 2, dst, 3, WAR2_SCALER_NEAREST) != PUD_TRUE);
+   for (y = 0; y < 6; y++)
+     for (x = 0; x < 6; x++)
+       fail_if(dst[y * 6 + x] != src[(y / 3) * 2 + (x / 3)]);
+
+   fail_if(war2_scale_indexed(src, 2, 2, dst, 0, WAR2_SCALER_NEAREST) != PUD_FALSE);
+   fail_if(war2_scale_indexed(src, 2, 2, dst, 5, WAR2_SCALER_SCALE2X) != PUD_FALSE);
+}
+END_TEST
+
+START_TEST(scale_scale2x)
+{
+   /* Diagonal edge: Scale2x must smooth it */
+   const unsigned char src[3 * 3] = {
+      1, 1, 2,
+      1, 2, 2,
+      2, 2, 2,
+   };
+   const unsigned char uniform[4] = { 7, 7, 7, 7 };
+   unsigned char dst[12 * 12], dst2[12 * 12], tmp[6 * 6];
+   unsigned int i;
+
+   fail_if(war2_scale_indexed(src, 3, 3, dst, 2, WAR2_SCALER_SCALE2X) != PUD_TRUE);
+   fail_if(dst[2 * 6 + 2] != 1); /* Top-left of the center pixel */
+   fail_if(dst[2 * 6 + 3] != 2);
+   fail_if(dst[3 * 6 + 2] != 2);
+   fail_if(dst[3 * 6 + 3] != 2);
+
+   fail_if(war2_scale_indexed(src, 3, 3, dst, 3, WAR2_SCALER_SCALE2X) != PUD_TRUE);
+   fail_if(dst[3 * 9 + 3] != 1);
+   fail_if(dst[4 * 9 + 4] != 2);
+
+   /* 4x is 2x applied twice */
+   fail_if(war2_scale_indexed(src, 3, 3, dst, 4, WAR2_SCALER_SCALE2X) != PUD_TRUE);
+   fail_if(war2_scale_indexed(src, 3, 3, tmp, 2, WAR2_SCALER_SCALE2X) != PUD_TRUE);
+   fail_if(war2_scale_indexed(tmp, 6, 6, dst2, 2, WAR2_SCALER_SCALE2X) != PUD_TRUE);
+   fail_if(memcmp(dst, dst2, 12 * 12) != 0);
+
+   /* Uniform images remain uniform */
+   fail_if(war2_scale_indexed(uniform, 2, 2, dst, 3, WAR2_SCALER_SCALE2X) != PUD_TRUE);
+   for (i = 0; i < 6 * 6; i++)
+     fail_if(dst[i] != 7);
+}
+END_TEST
+
+START_TEST(scale_indexed_rgba)
+{
+   /* Large enough to be split between threads */
+   const unsigned int w = 97, h = 203;
+   unsigned int factor, scaler, i;
+   Pud_Color palette[WAR2_PALETTE_SIZE];
+   unsigned char *idx, *idx_scaled;
+   Pud_Color *rgba, *rgba_scaled, *expanded;
+
+   for (i = 0; i < WAR2_PALETTE_SIZE; i++)
+     {
+        palette[i].r = i;
+        palette[i].g = 255 - i;
+        palette[i].b = i / 2;
+        palette[i].a = 0xff;
+     }
+
+   idx = malloc(w * h);
+   rgba = malloc(w * h * sizeof(Pud_Color));
+   idx_scaled = malloc(w * h * 16);
+   rgba_scaled = malloc(w * h * 16 * sizeof(Pud_Color));
+   expanded = malloc(w * h * 16 * sizeof(Pud_Color));
+   fail_if((!idx) || (!rgba) || (!idx_scaled) || (!rgba_scaled) || (!expanded));
+
+   /* Few colors, so there are many edges to be smoothed */
+   for (i = 0; i < w * h; i++)
+     idx[i] = (rand() % 4 == 0) ? rand() % 3 : idx[(i > 0) ? i - 1 : 0];
+   _expand(idx, w * h, palette, rgba);
+
+   /* Scaling indexes then applying the palette gives the same image as
+    * scaling the colors */
+   for (scaler = WAR2_SCALER_NEAREST; scaler <= WAR2_SCALER_SCALE2X; scaler++)
+     for (factor = 1; factor <= 4; factor++)
+       {
+          fail_if(war2_scale_indexed(idx, w, h, idx_scaled, factor, scaler) != PUD_TRUE);
+          fail_if(war2_scale_rgba(rgba, w, h, rgba_scaled, factor, scaler) != PUD_TRUE);
+          _expand(idx_scaled, w * h * factor * factor, palette, expanded);
+          fail_if(memcmp(expanded, rgba_scaled,
+                         w * h * factor * factor * sizeof(Pud_Color)) != 0);
+       }
+
+   free(idx);
+   free(rgba);
+   free(idx_scaled);
+   free(rgba_scaled);
+   free(expanded);
+}
+END_TEST
+
+void
+test_scale(TCase *tc)
+{
+   tcase_add_test(tc, scale_nearest);
+   tcase_add_test(tc, scale_scale2x);
+   tcase_add_test(tc, scale_indexed_rgba);
+}
@@ -0,0 +1,352 @@
+#include "tests.h"
+#include <war2.h>
+
+#define FRAMES 3
+
+typedef struct
+{
+   const War2_Sprite_Frame *frames;
+   const Pud_Color *transparent;
+   const Pud_Color *colorized; /* Palette colorized for the player */
+   unsigned int decoded;
+   Pud_Bool ok;
+} Roundtrip;
+
+static void
+_roundtrip_cb(void                          *data,
+              const Pud_Color               *img,
+              int                            x,
+              int                            y,
+              unsigned int                   w,
+              unsigned int                   h,
+              const War2_Sprites_Descriptor *ud,
+              uint16_t                       img_nb)
+{
+   Roundtrip *rt = data;
+   const War2_Sprite_Frame *const f = &(rt->frames[img_nb]);
+   const Pud_Color *expected;
+   unsigned int i;
+
+   rt->decoded++;
+   if (((unsigned int)x != f->x) || ((unsigned int)y != f->y) ||
+       (w != f->w) || (h != f->h))
+     {
+        rt->ok = PUD_FALSE;
+        return;
+     }
+   for (i = 0; i < w * h; i++)
+     {
+        expected = (f->pixels[i].a < 0x80) ? rt->transparent : &(f->pixels[i]);
+        if (memcmp(&(img[i]), expected, sizeof(Pud_Color)) != 0)
+          rt->ok = PUD_FALSE;
+        if ((rt->colorized) &&
+            (memcmp(&(img[i]), &(rt->colorized[ud->indexes[i]]), sizeof(Pud_Color)) != 0))
+          rt->ok = PUD_FALSE;
+     }
+}
+
+static void
+_frames_fill(War2_Sprite_Frame *frames,
+             Pud_Color         *pixels,
+             const Pud_Color   *palette)
+{
+   const unsigned int dims[FRAMES][4] = {
+        /* x,  y,   w,  h */
+        {  0,  0, 200,  6 },
+        {  3,  9,  17, 11 },
+        { 12,  1,   1,  1 },
+   };
+   unsigned int i, k, w;
+   Pud_Color *p = pixels;
+
+   for (i = 0; i < FRAMES; i++)
+     {
+        frames[i].x = dims[i][0];
+        frames[i].y = dims[i][1];
+        frames[i].w = w = dims[i][2];
+        frames[i].h = dims[i][3];
+        frames[i].pixels = p;
+
+        for (k = 0; k < frames[i].w * frames[i].h; k++, p++)
+          {
+             /* Mix long transparent spans, repetitions and noise */
+             if ((k % w) < 130 && (k / w) % 2)
+               p->a = 0;
+             else if ((k % w) % 50 < 20)
+               *p = palette[1 + (k / w)];
+             else
+               *p = palette[1 + (rand() % (WAR2_PALETTE_SIZE - 1))];
+          }
+     }
+}
+
+START_TEST(encode_roundtrip)
+{
+   War2_Data *w2;
+   War2_Decoder *dec;
+   War2_Sprites_Encoder *enc;
+   War2_Sprite_Frame frames[FRAMES];
+   Pud_Color pixels[200 * 6 + 17 * 11 + 1];
+   const Pud_Color *palette;
+   unsigned char *buf;
+   size_t size, i;
+   Roundtrip rt;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   enc = war2_sprites_encoder_new(palette);
+   fail_if(enc == NULL);
+
+   memset(pixels, 0, sizeof(pixels));
+   _frames_fill(frames, pixels, palette);
+
+   buf = war2_sprites_encoder_encode(enc, PUD_PLAYER_RED, frames, FRAMES, &size);
+   fail_if(buf == NULL);
+
+   rt.frames = frames;
+   rt.transparent = &(palette[0]);
+   rt.colorized = NULL;
+   rt.decoded = 0;
+   rt.ok = PUD_TRUE;
+   fail_if(war2_decoder_sprites_buffer_decode(dec, buf, size, palette,
+                                              PUD_PLAYER_RED, _roundtrip_cb,
+                                              &rt) != PUD_TRUE);
+   fail_if(rt.decoded != FRAMES);
+   fail_if(!rt.ok);
+
+   /* Truncated data must be rejected, not read out of bounds */
+   for (i = 0; i < size; i += 7)
+     {
+        rt.decoded = 0;
+        fail_if(war2_decoder_sprites_buffer_decode(dec, buf, i, palette,
+                                                   PUD_PLAYER_RED, _roundtrip_cb,
+                                                   &rt) != PUD_FALSE);
+     }
+
+   free(buf);
+   war2_sprites_encoder_free(enc);
+   war2_decoder_free(dec);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(encode_player_color)
+{
+   War2_Decoder *dec;
+   War2_Sprites_Encoder *enc;
+   War2_Sprite_Frame frame;
+   Pud_Color palette[WAR2_PALETTE_SIZE], colorized[WAR2_PALETTE_SIZE];
+   Pud_Color pixels[4 * 3];
+   unsigned char *buf;
+   unsigned int i;
+   size_t size;
+   Roundtrip rt;
+   const Pud_Color red[4] = {
+        { 0x44, 0x04, 0x00, 0xff },
+        { 0x5c, 0x04, 0x00, 0xff },
+        { 0x7c, 0x00, 0x00, 0xff },
+        { 0xa4, 0x00, 0x00, 0xff },
+   };
+
+   fail_if(war2_init() != PUD_TRUE);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+
+   /* Grayscale palette that contains the red player colors */
+   for (i = 0; i < WAR2_PALETTE_SIZE; i++)
+     {
+        palette[i].r = palette[i].g = palette[i].b = (i & 0x3f) << 2;
+        palette[i].a = 0xff;
+     }
+   palette[0].a = 0x00;
+   memcpy(&(palette[208]), red, sizeof(red));
+   enc = war2_sprites_encoder_new(palette);
+   fail_if(enc == NULL);
+
+   /* An image drawn for the blue player */
+   for (i = 0; i < 4 * 3; i++)
+     {
+        if (i < 4)
+          {
+             pixels[i] = red[i];
+             war2_sprites_color_convert(PUD_PLAYER_RED, PUD_PLAYER_BLUE,
+                                        red[i].r, red[i].g, red[i].b,
+                                        &pixels[i].r, &pixels[i].g, &pixels[i].b);
+          }
+        else
+          pixels[i] = palette[i * 5];
+     }
+   frame.pixels = pixels;
+   frame.x = frame.y = 0;
+   frame.w = 4;
+   frame.h = 3;
+
+   /* Player colors are stored as red */
+   for (i = 0; i < 4; i++)
+     fail_if(war2_sprites_encoder_color_index(enc, PUD_PLAYER_BLUE, pixels[i]) != 208 + i);
+
+   /* Nearest color and transparency */
+   fail_if(war2_sprites_encoder_color_index(enc, PUD_PLAYER_RED,
+                                            (Pud_Color){ 0x41, 0x43, 0x42, 0xff }) != 16);
+   fail_if(war2_sprites_encoder_color_index(enc, PUD_PLAYER_RED,
+                                            (Pud_Color){ 0x40, 0x40, 0x40, 0x7f }) != 0);
+
+   buf = war2_sprites_encoder_encode(enc, PUD_PLAYER_BLUE, &frame, 1, &size);
+   fail_if(buf == NULL);
+   war2_sprites_palette_colorize(palette, PUD_PLAYER_BLUE, colorized);
+   rt.frames = &frame;
+   rt.transparent = &(palette[0]);
+   rt.colorized = colorized;
+   rt.decoded = 0;
+   rt.ok = PUD_TRUE;
+   fail_if(war2_decoder_sprites_buffer_decode(dec, buf, size, palette,
+                                              PUD_PLAYER_BLUE, _roundtrip_cb,
+                                              &rt) != PUD_TRUE);
+   fail_if((rt.decoded != 1) || (!rt.ok));
+
+   free(buf);
+   war2_sprites_encoder_free(enc);
+   war2_decoder_free(dec);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(encode_near_player_color)
+{
+   War2_Decoder *dec;
+   War2_Sprites_Encoder *enc;
+   War2_Sprite_Frame frame, expected;
+   Pud_Color palette[WAR2_PALETTE_SIZE];
+   const Pud_Color pixel = { 0x7a, 0x00, 0x00, 0xff };
+   unsigned char *buf;
+   unsigned int i;
+   size_t size;
+   Roundtrip rt;
+   const Pud_Color red[4] = {
+        { 0x44, 0x04, 0x00, 0xff },
+        { 0x5c, 0x04, 0x00, 0xff },
+        { 0x7c, 0x00, 0x00, 0xff },
+        { 0xa4, 0x00, 0x00, 0xff },
+   };
+
+   fail_if(war2_init() != PUD_TRUE);
+   dec = war2_decoder_new();
+   fail_if(dec == NULL);
+
+   /* The red player colors, and a red that is not a player color, but
+    * farther from the pixel than the player color */
+   for (i = 0; i < WAR2_PALETTE_SIZE; i++)
+     {
+        palette[i].r = palette[i].g = palette[i].b = (i & 0x3f) << 2;
+        palette[i].a = 0xff;
+     }
+   palette[0].a = 0x00;
+   memcpy(&(palette[208]), red, sizeof(red));
+   palette[100] = (Pud_Color){ 0x70, 0x00, 0x00, 0xff };
+   enc = war2_sprites_encoder_new(palette);
+   fail_if(enc == NULL);
+
+   fail_if(war2_sprites_encoder_color_index(enc, PUD_PLAYER_RED, pixel) != 100);
+
+   /* The pixel must not take the colors of the player */
+   frame.pixels = &pixel;
+   frame.x = frame.y = 0;
+   frame.w = frame.h = 1;
+   expected = frame;
+   expected.pixels = &(palette[100]);
+
+   buf = war2_sprites_encoder_encode(enc, PUD_PLAYER_RED, &frame, 1, &size);
+   fail_if(buf == NULL);
+   rt.frames = &expected;
+   rt.transparent = &(palette[0]);
+   rt.colorized = NULL;
+   rt.decoded = 0;
+   rt.ok = PUD_TRUE;
+   fail_if(war2_decoder_sprites_buffer_decode(dec, buf, size, palette,
+                                              PUD_PLAYER_BLUE, _roundtrip_cb,
+                                              &rt) != PUD_TRUE);
+   fail_if((rt.decoded != 1) || (!rt.ok));
+
+   free(buf);
+   war2_sprites_encoder_free(enc);
+   war2_decoder_free(dec);
+   war2_shutdown();
+}
+END_TEST
+
+typedef struct
+{
+   War2_Data *w2;
+   unsigned int decoded;
+   Pud_Bool ok;
+} Icons;
+
+static void
+_icons_cb(void                          *data,
+          const Pud_Color               *img,
+          int                            x,
+          int                            y,
+          unsigned int                   w,
+          unsigned int                   h,
+          const War2_Sprites_Descriptor *ud,
+          uint16_t                       img_nb)
+{
+   Icons *ic = data;
+   const War2_Icon *icon;
+
+   ic->decoded++;
+   icon = war2_icon_get(ic->w2, PUD_ERA_FOREST, img_nb);
+   if ((!icon) || (icon->x != x) || (icon->y != y) ||
+       (icon->w != w) || (icon->h != h) ||
+       (memcmp(icon->pixels, img, w * h * sizeof(Pud_Color)) != 0) ||
+       (memcmp(icon->indexes, ud->indexes, w * h) != 0))
+     ic->ok = PUD_FALSE;
+}
+
+START_TEST(icons_get)
+{
+   War2_Data *w2;
+   const War2_Icon *icon;
+   Icons ic;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   /* Icons are the frames of the icons entry */
+   ic.w2 = w2;
+   ic.decoded = 0;
+   ic.ok = PUD_TRUE;
+   fail_if(war2_sprites_decode(w2, PUD_PLAYER_RED, PUD_ERA_FOREST,
+                               WAR2_SPRITES_ICONS, _icons_cb, &ic) != PUD_TRUE);
+   fail_if((ic.decoded != 2) || (!ic.ok));
+
+   /* The sheet is kept */
+   icon = war2_icon_get(w2, PUD_ERA_FOREST, 1);
+   fail_if(icon == NULL);
+   fail_if(war2_icon_get(w2, PUD_ERA_FOREST, 1) != icon);
+   fail_if((icon->w != 2) || (icon->h != 2));
+
+   fail_if(war2_icon_get(w2, PUD_ERA_FOREST, 2) != NULL);
+   fail_if(war2_icon_get(w2, PUD_ERA_WINTER, 0) != NULL); /* No entry */
+   fail_if(war2_icon_get(w2, PUD_ERA_WINTER, 1) != NULL); /* Not tried again */
+   fail_if(war2_icon_get(w2, 4, 0) != NULL);
+
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+void
+test_sprites(TCase *tc)
+{
+   tcase_add_test(tc, encode_roundtrip);
+   tcase_add_test(tc, encode_player_color);
+   tcase_add_test(tc, encode_near_player_color);
+   tcase_add_test(tc, icons_get);
+}
@@ -0,0 +1,380 @@
+#include "tests.h"
+#include <war2.h>
+#ifdef HAVE_PTHREAD
+# include <pthread.h>
+#endif
+
+typedef struct
+{
+   const War2_Tileset_Atlas *atlas;
+   unsigned int tiles;
+   Pud_Bool ok;
+} Atlas_Check;
+
+static void
+_tile_cb(void                          *data,
+         const Pud_Color               *img,
+         unsigned int                   w,
+         unsigned int                   h,
+         const War2_Tileset_Descriptor *ts,
+         uint16_t                       img_nb)
+{
+   Atlas_Check *chk = data;
+   const War2_Tileset_Atlas *atlas = chk->atlas;
+   unsigned int x, y, row;
+
+   (void) ts;
+   chk->tiles++;
+   if (!war2_tileset_atlas_rect_get(atlas, img_nb, &x, &y))
+     {
+        chk->ok = PUD_FALSE;
+        return;
+     }
+   for (row = 0; row < h; row++)
+     if (memcmp(&(atlas->rgba[(y + row) * atlas->w + x]), &(img[row * w]),
+                w * sizeof(Pud_Color)) != 0)
+       chk->ok = PUD_FALSE;
+}
+
+START_TEST(atlas)
+{
+   War2_Data *w2;
+   War2_Tileset_Atlas *atlas;
+   const Pud_Color *palette;
+   Atlas_Check chk;
+   unsigned int x, y, i, tile;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   atlas = war2_tileset_atlas_new(w2, PUD_ERA_FOREST,
+                                  WAR2_TILESET_ATLAS_RGBA | WAR2_TILESET_ATLAS_INDEXED);
+   fail_if(atlas == NULL);
+   fail_if(atlas->era != PUD_ERA_FOREST);
+
+   /* 0x10, 0x11 and 0x100 look the same, so they share a slot */
+   fail_if(atlas->tiles != 2);
+   fail_if((atlas->w != WAR2_TILESET_ATLAS_COLUMNS * 32) || (atlas->h != 32));
+   for (tile = 0; tile <= 0xffff; tile++)
+     {
+        if ((tile == 0x10) || (tile == 0x11) || (tile == 0x20) || (tile == 0x100))
+          fail_if(!war2_tileset_atlas_rect_get(atlas, tile, &x, &y));
+        else
+          fail_if(war2_tileset_atlas_rect_get(atlas, tile, &x, &y));
+     }
+   fail_if(!war2_tileset_atlas_rect_get(atlas, 0x100, &x, &y));
+   fail_if((x != 0) || (y != 0));
+   fail_if(!war2_tileset_atlas_rect_get(atlas, 0x20, &x, &y));
+   fail_if((x != 32) || (y != 0));
+
+   /* The atlas contains the tiles given by war2_tileset_decode(), and the
+    * indexes match the RGBA pixels */
+   chk.atlas = atlas;
+   chk.tiles = 0;
+   chk.ok = PUD_TRUE;
+   fail_if(war2_tileset_decode(w2, PUD_ERA_FOREST, _tile_cb, &chk) != FIXTURE_TILESET_TILES);
+   fail_if((chk.tiles != FIXTURE_TILESET_TILES) || (!chk.ok));
+
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   for (i = 0; i < 64 * 32; i++)
+     fail_if(memcmp(&(atlas->rgba[(i / 64) * atlas->w + (i % 64)]),
+                    &(palette[atlas->indexes[(i / 64) * atlas->w + (i % 64)]]),
+                    sizeof(Pud_Color)) != 0);
+
+   war2_tileset_atlas_free(atlas);
+
+   /* Only palette indexes */
+   atlas = war2_tileset_atlas_new(w2, PUD_ERA_FOREST, WAR2_TILESET_ATLAS_INDEXED);
+   fail_if(atlas == NULL);
+   fail_if((atlas->rgba != NULL) || (atlas->indexes == NULL));
+   war2_tileset_atlas_free(atlas);
+
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+START_TEST(equivalences)
+{
+   War2_Data *w2;
+   const uint16_t *eq;
+   unsigned int unique, tile, i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   eq = war2_tileset_equivalences_get(w2, PUD_ERA_FOREST, &unique);
+   fail_if(eq == NULL);
+   fail_if(unique != 2);
+
+   /* The lowest tile ID of a group is its canonical tile */
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
+     {
+        i = tile - WAR2_TILESET_TILE_FIRST;
+        if ((tile == 0x10) || (tile == 0x11) || (tile == 0x100))
+          fail_if(eq[i] != 0x10);
+        else if (tile == 0x20)
+          fail_if(eq[i] != 0x20);
+        else
+          fail_if(eq[i] != WAR2_TILESET_TILE_NONE);
+     }
+
+   /* Computed once per era */
+   fail_if(war2_tileset_equivalences_get(w2, PUD_ERA_FOREST, NULL) != eq);
+
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+#ifdef HAVE_PTHREAD
+# define CACHE_THREADS 8
+
+typedef struct
+{
+   War2_Data *w2;
+   const uint16_t *eq;
+   const War2_Icon *icon;
+} Cache_Result;
+
+static void *
+_caches_thread(void *data)
+{
+   Cache_Result *res = data;
+
+   res->eq = war2_tileset_equivalences_get(res->w2, PUD_ERA_FOREST, NULL);
+   res->icon = war2_icon_get(res->w2, PUD_ERA_FOREST, 1);
+   return NULL;
+}
+#endif
+
+START_TEST(shared_caches)
+{
+#ifdef HAVE_PTHREAD
+   War2_Data *w2;
+   pthread_t threads[CACHE_THREADS];
+   Cache_Result res[CACHE_THREADS];
+   unsigned int i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   /* Threads that share the data build each cache exactly once */
+   for (i = 0; i < CACHE_THREADS; i++)
+     {
+        res[i].w2 = w2;
+        fail_if(pthread_create(&(threads[i]), NULL, _caches_thread, &(res[i])) != 0);
+     }
+   for (i = 0; i < CACHE_THREADS; i++)
+     {
+        pthread_join(threads[i], NULL);
+        fail_if((res[i].eq == NULL) || (res[i].icon == NULL));
+        fail_if((res[i].eq != res[0].eq) || (res[i].icon != res[0].icon));
+     }
+
+   war2_close(w2);
+   war2_shutdown();
+#endif
+}
+END_TEST
+
+typedef struct
+{
+   War2_Tileset_Encoder *enc;
+   uint16_t tiles[8];
+   Pud_Color imgs[8][32 * 32];
+   unsigned int count;
+} Encode_Data;
+
+static void
+_encode_cb(void                          *data,
+           const Pud_Color               *img,
+           unsigned int                   w,
+           unsigned int                   h,
+           const War2_Tileset_Descriptor *ts,
+           uint16_t                       img_nb)
+{
+   Encode_Data *ed = data;
+
+   (void) ts;
+   if ((w != 32) || (h != 32) || (ed->count >= 8)) return;
+   ed->tiles[ed->count] = img_nb;
+   memcpy(ed->imgs[ed->count++], img, sizeof(ed->imgs[0]));
+   war2_tileset_encoder_tile_add(ed->enc, img_nb, img);
+}
+
+/* Decode a tile from encoded entries, as the data file would be */
+static Pud_Bool
+_entries_tile_check(const War2_Tileset_Entries *e,
+                    const Pud_Color            *palette,
+                    uint16_t                    tile,
+                    const Pud_Color            *img)
+{
+   const size_t off = ((tile >> 4) * 42) + ((tile & 0xf) * 2);
+   unsigned int mega, word, m, x, y, mx, my;
+
+   if (off + 2 > e->map_size) return PUD_FALSE;
+   mega = e->map[off] | (e->map[off + 1] << 8);
+   if ((mega == 0) || ((mega + 1) * 32 > e->megatiles_size)) return PUD_FALSE;
+
+   for (y = 0; y < 32; y++)
+     for (x = 0; x < 32; x++)
+       {
+          m = mega * 32 + ((y / 8) * 4 + (x / 8)) * 2;
+          word = e->megatiles[m] | (e->megatiles[m + 1] << 8);
+          if (((word >> 2) + 1) * 64 > e->minitiles_size) return PUD_FALSE;
+          mx = (word & 2) ? 7 - (x % 8) : x % 8;
+          my = (word & 1) ? 7 - (y % 8) : y % 8;
+          if (memcmp(&(palette[e->minitiles[(word >> 2) * 64 + my * 8 + mx]]),
+                     &(img[y * 32 + x]), sizeof(Pud_Color)) != 0)
+            return PUD_FALSE;
+       }
+   return PUD_TRUE;
+}
+
+START_TEST(encoder)
+{
+   War2_Data *w2;
+   War2_Tileset_Entries entries;
+   Encode_Data ed;
+   const Pud_Color *palette;
+   Pud_Color *img;
+   unsigned int i;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+   palette = war2_palette_get(w2, PUD_ERA_FOREST);
+
+   ed.enc = war2_tileset_encoder_new(palette);
+   fail_if(ed.enc == NULL);
+   ed.count = 0;
+   fail_if(war2_tileset_decode(w2, PUD_ERA_FOREST, _encode_cb, &ed) != FIXTURE_TILESET_TILES);
+   fail_if(ed.count != FIXTURE_TILESET_TILES);
+
+   /* Invalid tile IDs are rejected */
+   fail_if(war2_tileset_encoder_tile_add(ed.enc, 0x00d0, ed.imgs[0]) != PUD_FALSE);
+   fail_if(war2_tileset_encoder_tile_add(ed.enc, 0x01e0, ed.imgs[0]) != PUD_FALSE);
+
+   fail_if(war2_tileset_encoder_encode(ed.enc, &entries) != PUD_TRUE);
+
+   /* The fixture tiles use two minitiles, in all their flipped variants,
+    * and two distinct megatiles (plus the unused megatile 0) */
+   fail_if(entries.minitiles_size != 2 * 64);
+   fail_if(entries.megatiles_size != 3 * 32);
+   for (i = 0; i < ed.count; i++)
+     fail_if(!_entries_tile_check(&entries, palette, ed.tiles[i], ed.imgs[i]));
+
+   free(entries.megatiles);
+   free(entries.minitiles);
+   free(entries.map);
+   war2_tileset_encoder_free(ed.enc);
+
+   /* A solid tile is only made of minitile 0, unflipped, but must not be
+    * mistaken for the unused megatile 0. Then, noise tiles share nothing,
+    * so the tables have to grow. */
+   ed.enc = war2_tileset_encoder_new(palette);
+   fail_if(ed.enc == NULL);
+   img = malloc(65 * 32 * 32 * sizeof(Pud_Color));
+   fail_if(img == NULL);
+   for (i = 0; i < 32 * 32; i++)
+     img[i] = palette[5];
+   for (i = 32 * 32; i < 65 * 32 * 32; i++)
+     img[i] = palette[1 + (rand() % 63)];
+   fail_if(!war2_tileset_encoder_tile_add(ed.enc, 0x10, img));
+   for (i = 1; i < 65; i++)
+     fail_if(!war2_tileset_encoder_tile_add(ed.enc, 0x200 + i, &(img[i * 32 * 32])));
+   fail_if(war2_tileset_encoder_encode(ed.enc, &entries) != PUD_TRUE);
+   fail_if(entries.minitiles_size != (1 + 64 * 16) * 64);
+   fail_if(!_entries_tile_check(&entries, palette, 0x10, img));
+   for (i = 1; i < 65; i++)
+     fail_if(!_entries_tile_check(&entries, palette, 0x200 + i, &(img[i * 32 * 32])));
+
+   free(img);
+   free(entries.megatiles);
+   free(entries.minitiles);
+   free(entries.map);
+   war2_tileset_encoder_free(ed.enc);
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+typedef struct
+{
+   const uint32_t *colors;
+   unsigned int tiles;
+   Pud_Bool ok;
+} Colors_Check;
+
+static void
+_colors_cb(void                          *data,
+           const Pud_Color               *img,
+           unsigned int                   w,
+           unsigned int                   h,
+           const War2_Tileset_Descriptor *ts,
+           uint16_t                       img_nb)
+{
+   Colors_Check *chk = data;
+   unsigned int i, r = 0, g = 0, b = 0;
+   uint32_t expected;
+
+   (void) ts;
+   chk->tiles++;
+   for (i = 0; i < w * h; i++)
+     {
+        r += img[i].r;
+        g += img[i].g;
+        b += img[i].b;
+     }
+   expected = (((r + 512) / 1024) << 16) | (((g + 512) / 1024) << 8) | ((b + 512) / 1024);
+   if (chk->colors[img_nb] != expected)
+     chk->ok = PUD_FALSE;
+}
+
+START_TEST(minimap_colors)
+{
+   War2_Data *w2;
+   uint32_t colors[WAR2_TILESET_TILE_LAST + 1];
+   Colors_Check chk;
+   unsigned int tile;
+
+   fail_if(war2_init() != PUD_TRUE);
+   w2 = war2_open(fixture_war_get());
+   fail_if(w2 == NULL);
+
+   fail_if(war2_tileset_minimap_colors_get(w2, PUD_ERA_FOREST, colors) != PUD_TRUE);
+
+   /* Each tile gets the average of its pixels */
+   chk.colors = colors;
+   chk.tiles = 0;
+   chk.ok = PUD_TRUE;
+   fail_if(war2_tileset_decode(w2, PUD_ERA_FOREST, _colors_cb, &chk) != FIXTURE_TILESET_TILES);
+   fail_if((chk.tiles != FIXTURE_TILESET_TILES) || (!chk.ok));
+   fail_if(colors[0x10] != colors[0x100]);
+   fail_if(colors[0x10] == colors[0x20]);
+
+   /* Other tiles are black */
+   for (tile = 0; tile <= WAR2_TILESET_TILE_LAST; tile++)
+     {
+        if ((tile != 0x10) && (tile != 0x11) && (tile != 0x20) && (tile != 0x100))
+          fail_if(colors[tile] != 0);
+     }
+
+   war2_close(w2);
+   war2_shutdown();
+}
+END_TEST
+
+void
+test_tileset(TCase *tc)
+{
+   tcase_add_test(tc, atlas);
+   tcase_add_test(tc, equivalences);
+   tcase_add_test(tc, shared_caches);
+   tcase_add_test(tc, encoder);
+   tcase_add_test(tc, minimap_colors);
+}
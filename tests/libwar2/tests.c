@@ -0,0 +1,26 @@
+#include "tests.h"
+
+static const Efl_Test_Case etc[] = {
+     { "Decoder", test_decoder },
+     { "Sprites", test_sprites },
+     { "Scale", test_scale },
+     { "Tileset", test_tileset },
+     { "Map", test_map },
+     { "Font", test_font },
+     { NULL, NULL }
+};
+
+int
+main(int          argc,
+     const char **argv)
+{
+   int failed_count;
+
+   if (!_efl_test_option_disp(argc, argv, etc))
+     return 0;
+
+   failed_count = _efl_suite_build_and_run(argc - 1, argv + 1,
+                                           "libwar2", etc);
+
+   return (failed_count == 0) ? 0 : -1;
+}
@@ -0,0 +1,26 @@
+#ifndef __TESTS_H__
+#define __TESTS_H__
+
+#include "../test_suite.h"
+
+/* Synthetic data file, see fixture.c */
+#define FIXTURE_ENTRY_UI       300
+#define FIXTURE_ENTRY_CURSOR   301
+#define FIXTURE_ENTRY_LZ       7
+#define FIXTURE_ENTRY_LZ_FAR   8
+#define FIXTURE_ENTRY_MISSING  9
+#define FIXTURE_ENTRY_FONT     283 /* WAR2_FONT_GAME */
+#define FIXTURE_OBJECT_SPRITE  PUD_UNIT_DWARVES
+#define FIXTURE_ENTRY_ICONS    356 /* Forest icons, same frames as the sprite */
+#define FIXTURE_TILESET_TILES  4 /* 0x10, 0x11 and 0x100 look the same */
+
+const char *fixture_war_get(void);
+
+void test_decoder(TCase *tc);
+void test_sprites(TCase *tc);
+void test_scale(TCase *tc);
+void test_tileset(TCase *tc);
+void test_map(TCase *tc);
+void test_font(TCase *tc);
+
+#endif
@@ -24,6 +24,7 @@ static Cairo_Ctx _cairo;
 
 #define ICON_W 46
 #define ICON_H 38
+#define ICON_COUNT 196
 
 static void
 _open_era_file(const char *era)
@@ -34,7 +35,7 @@ _open_era_file(const char *era)
 
    _cairo.img = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
                                            ICON_W,
-                                           196 * ICON_H);
+                                           ICON_COUNT * ICON_H);
    _cairo.cr = cairo_create(_cairo.img);
 
    snprintf(my_path2, sizeof(my_path2),
@@ -60,46 +61,30 @@ _usage(FILE *s)
 }
 
 static void
-_icons_cb(void                          *data EINA_UNUSED,
-          const Pud_Color               *tile,
-          int                            x EINA_UNUSED,
-          int                            y EINA_UNUSED,
-          unsigned int                   w,
-          unsigned int                   h,
-          const War2_Sprites_Descriptor *ts EINA_UNUSED,
-          uint16_t                       img_nb)
+_icon_draw(const War2_Icon *icon,
+           unsigned int     img_nb)
 {
-   Eina_Tmpstr *file;
-   int fd;
-   const int px = 0, py = img_nb * ICON_H;
-   cairo_surface_t *img;
+   unsigned char *data;
+   unsigned int y;
+   int stride;
 
    // Size does not fit :/
-   if ((w > ICON_W) || (h > ICON_H)) {
-      fprintf(stderr, "Icon %" PRIu16 " has size (%u,%u). Max allowed "
+   if ((icon->w > ICON_W) || (icon->h > ICON_H)) {
+      fprintf(stderr, "Icon %u has size (%u,%u). Max allowed "
               "for display: (%i,%i)\n",
-              img_nb, w, h, ICON_W, ICON_H);
+              img_nb, icon->w, icon->h, ICON_W, ICON_H);
       return;
    }
 
-   fd = eina_file_mkstemp("tmp.atlas-XXXXXX.png", &file);
-   if (EINA_UNLIKELY(fd < 0))
-     {
-        fprintf(stderr, "*** Failed to create temporary file\n");
-        return;
-     }
-   close(fd);
-   war2_png_write(file, w, h, (unsigned char *)tile);
-
-   img = cairo_image_surface_create_from_png(file);
-
-   cairo_set_source_surface(_cairo.cr, img, px, py);
-   cairo_mask_surface(_cairo.cr, img, px, py);
-   cairo_fill(_cairo.cr);
-   cairo_surface_destroy(img);
-
-   ecore_file_unlink(file);
-   eina_tmpstr_del(file);
+   /* Icons are written directly in the surface (premultiplied ARGB) */
+   cairo_surface_flush(_cairo.img);
+   data = cairo_image_surface_get_data(_cairo.img);
+   stride = cairo_image_surface_get_stride(_cairo.img);
+   for (y = 0; y < icon->h; y++)
+     pud_pixels_convert(&(icon->pixels[y * icon->w]),
+                        data + (img_nb * ICON_H + y) * stride,
+                        icon->w, PUD_PIXEL_FORMAT_ARGB32_PREMUL);
+   cairo_surface_mark_dirty(_cairo.img);
 }
 
 int
@@ -107,11 +92,10 @@ main(int    argc,
      char **argv)
 {
    War2_Data *w2;
-   War2_Sprites_Descriptor *ud;
+   const War2_Icon *icon;
    const char *file;
    int ret = EXIT_FAILURE;
    char buf[1024];
-   Pud_Bool chk;
    struct {
       Pud_Era era;
       const char *str;
@@ -121,7 +105,7 @@ main(int    argc,
         { PUD_ERA_WASTELAND, "wasteland" },
         { PUD_ERA_SWAMP,     "swamp"},
    };
-   unsigned int i;
+   unsigned int i, k;
 
    if (argc != 2)
      {
@@ -140,10 +124,14 @@ main(int    argc,
 
    for (i = 0; i < EINA_C_ARRAY_LENGTH(eras); i++)
      {
+        if (!war2_icon_get(w2, eras[i].era, 0))
+          DIE_RETURN(2, "Failed to decode icons %s", eras[i].str);
         _open_era_file(eras[i].str);
-        chk = war2_sprites_decode(w2, PUD_PLAYER_RED, eras[i].era,
-                                 WAR2_SPRITES_ICONS, _icons_cb, NULL);
-        if (!chk) DIE_RETURN(2, "Failed to decode tileset %s", eras[i].str);
+        for (k = 0; k < ICON_COUNT; k++)
+          {
+             icon = war2_icon_get(w2, eras[i].era, k);
+             if (icon) _icon_draw(icon, k);
+          }
         _close_file();
      }
 
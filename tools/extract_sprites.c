@@ -6,17 +6,17 @@
 #include "war2.h"
 
 #include <Eet.h>
-#include <cairo.h>
-#include <Ecore_File.h>
-#include <unistd.h>
 
 #define SIZEOF_ARRAY(arr_) (sizeof(arr_) / sizeof(*arr_))
 
 static Eet_File *_ef = NULL;
 
+/* Decodes sprites as premultiplied ARGB, which is what eet expects */
+static War2_Decoder *_dec = NULL;
+
 static void
 _unit_cb(void                          *fdata  EINA_UNUSED,
-         const Pud_Color               *sprite,
+         const Pud_Color               *sprite EINA_UNUSED,
          int                            x      EINA_UNUSED,
          int                            y      EINA_UNUSED,
          unsigned int                   w,
@@ -45,17 +45,12 @@ _unit_cb(void                          *fdata  EINA_UNUSED,
    };
    static const unsigned int aliases_count = SIZEOF_ARRAY(aliases);
 
-   void *data;
    int bytes;
    char key[64], key2[64];
    const Pud_Unit u = ud->object;
    unsigned int i;
-   int fd;
    const int compress = 1;
    Eina_Bool ok;
-   cairo_surface_t *img;
-   Eina_Tmpstr *file;
-   int cw, ch;
 
    /* Only handle the 5 first images [0,4] */
    if ((u == PUD_UNIT_HUMAN_START) ||
@@ -70,23 +65,6 @@ _unit_cb(void                          *fdata  EINA_UNUSED,
           return;
      }
 
-   fd = eina_file_mkstemp("tmp.sprites-XXXXXX.png", &file);
-   if (EINA_UNLIKELY(fd < 0))
-     {
-        fprintf(stderr, "*** Failed to create temporary file\n");
-        return;
-     }
-   close(fd);
-
-   war2_png_write(file, w, h, (unsigned char *)sprite);
-
-   img = cairo_image_surface_create_from_png(file);
-   cairo_surface_flush(img);
-   data = cairo_image_surface_get_data(img);
-   cw = cairo_image_surface_get_width(img);
-   ch = cairo_image_surface_get_height(img);
-   printf("format is %i\n" ,cairo_image_surface_get_format (img));
-
    /* Generate key */
    switch (u)
      {
@@ -118,7 +96,7 @@ _unit_cb(void                          *fdata  EINA_UNUSED,
          break;
      }
 
-   bytes = eet_data_image_write(_ef, key, data, cw, ch, 1, compress, 100, 0);
+   bytes = eet_data_image_write(_ef, key, ud->pixels, w, h, 1, compress, 100, 0);
    if (bytes <= 0)
      fprintf(stderr, "*** Failed to save key [%s]\n", key);
 
@@ -146,15 +124,11 @@ _unit_cb(void                          *fdata  EINA_UNUSED,
      if (nopath[i] == '/') nopath[i] = '_';
    war2_png_write(nopath, w, h, (unsigned char *)sprite);
 #endif
-
-   cairo_surface_destroy(img);
-   ecore_file_unlink(file);
-   eina_tmpstr_del(file);
 }
 
 static void
 _building_cb(void                          *fdata  EINA_UNUSED,
-             const Pud_Color               *sprite,
+             const Pud_Color               *sprite EINA_UNUSED,
              int                            x      EINA_UNUSED,
              int                            y      EINA_UNUSED,
              unsigned int                   w,
@@ -162,45 +136,20 @@ _building_cb(void                          *fdata  EINA_UNUSED,
              const War2_Sprites_Descriptor *ud,
              uint16_t                       img_nb)
 {
-   void *data;
    int bytes;
    char key[32];
-   cairo_surface_t *img;
-   Eina_Tmpstr *file;
-   int fd, cw, ch;
    const int compress = 1;
 
    /* Only handle the first image */
    if (img_nb > 0) return;
 
-   fd = eina_file_mkstemp("tmp.sprites-XXXXXX.png", &file);
-   if (EINA_UNLIKELY(fd < 0))
-     {
-        fprintf(stderr, "*** Failed to create temporary file\n");
-        return;
-     }
-   close(fd);
-
-   war2_png_write(file, w, h, (unsigned char *)sprite);
-
-   img = cairo_image_surface_create_from_png(file);
-   cairo_surface_flush(img);
-   data = cairo_image_surface_get_data(img);
-   cw = cairo_image_surface_get_width(img);
-   ch = cairo_image_surface_get_height(img);
-
-
    snprintf(key, sizeof(key), "%s/%s",
             pud_era_to_string(ud->era),
             pud_unit_to_string(ud->object, PUD_FALSE));
-   bytes = eet_data_image_write(_ef, key, data, cw, ch, 1, compress, 100, 0);
+   bytes = eet_data_image_write(_ef, key, ud->pixels, w, h, 1, compress, 100, 0);
    if (bytes <= 0)
      fprintf(stderr, "*** Failed to save key [%s]\n", key);
 
-   cairo_surface_destroy(img);
-   ecore_file_unlink(file);
-   eina_tmpstr_del(file);
-
 #if 0
    /* Quick and dirty debug */
    char nopath[128];
@@ -313,12 +262,12 @@ main(int    argc,
 
 #define GEN_UNIT(unit_, era_) \
    do { \
-      war2_sprites_decode(w2, PUD_PLAYER_RED, era_, unit_, _unit_cb, NULL); \
+      war2_decoder_sprites_decode(w2, _dec, PUD_PLAYER_RED, era_, unit_, _unit_cb, NULL); \
    } while (0)
 
 #define GEN_BUILDING(unit_, era_) \
    do { \
-      war2_sprites_decode(w2, PUD_PLAYER_RED, era_, unit_, _building_cb, NULL); \
+      war2_decoder_sprites_decode(w2, _dec, PUD_PLAYER_RED, era_, unit_, _building_cb, NULL); \
    } while (0)
 
    if (argc != 2)
@@ -332,6 +281,9 @@ main(int    argc,
    w2 = war2_open(argv[1]);
    if (!w2) return 2;
    war2_verbosity_set(w2, 2);
+   _dec = war2_decoder_new();
+   if (!_dec) return 2;
+   war2_decoder_pixel_format_set(_dec, PUD_PIXEL_FORMAT_ARGB32_PREMUL);
 
 
    /*=========================*
@@ -418,6 +370,7 @@ main(int    argc,
      GEN_BUILDING(buildings[i], PUD_ERA_SWAMP);
    eet_close(_ef);
 
+   war2_decoder_free(_dec);
    war2_close(w2);
    eet_shutdown();
    war2_shutdown();
@@ -35,64 +35,53 @@ typedef struct
    char *png;
 } Cairo_Ctx;
 
-typedef struct
-{
-   Pud_Color *bitmap;
-   uint16_t id;
-} Icon;
-
 typedef void (*Generator_Func)(void);
 
 static Cairo_Ctx _cairo;
-static Eina_List *_list = NULL;
 
 
 #define ICON_W 46
 #define ICON_H 38
+#define ICON_COUNT 196
 
 
-static void
-_add_icon(const Pud_Color *col,
-          uint16_t id)
+/* Only icons of the regular size are put in the atlas */
+static const War2_Icon *
+_icon_get(War2_Data    *w2,
+          Pud_Era       era,
+          unsigned int  id)
 {
-   Icon *const ic = malloc(sizeof(Icon));
-   const size_t size = sizeof(Pud_Color) * ICON_W * ICON_H;
-   ic->bitmap = malloc(size);
-   memcpy(ic->bitmap, col, size);
-   ic->id = id;
+   const War2_Icon *const icon = war2_icon_get(w2, era, id);
 
-   _list = eina_list_append(_list, ic);
+   if ((!icon) || (icon->w != ICON_W) || (icon->h != ICON_H)) return NULL;
+   return icon;
 }
 
 static void
-_generate_atlas(unsigned int cols,
-                unsigned int rows)
+_generate_atlas(War2_Data    *w2,
+                Pud_Era       era,
+                unsigned int  cols)
 {
-   Eina_List *l;
-   Icon *ic;
-   Eina_Tmpstr *file;
-   unsigned int it = 0;
-   unsigned int px, py;
-   const int fd = eina_file_mkstemp("tmp.atlas-XXXXXX.png", &file);
-   if (EINA_UNLIKELY(fd < 0))
-     {
-        fprintf(stderr, "*** Failed to create temporary file\n");
-        return;
-     }
-   close(fd);
-
-   EINA_LIST_FOREACH(_list, l, ic)
+   const War2_Icon *icon;
+   unsigned char *data;
+   unsigned int it = 0, id, y;
+   unsigned int px = 0, py = 0;
+   int stride;
+
+   /* Icons are written directly in the surface (premultiplied ARGB) */
+   cairo_surface_flush(_cairo.img);
+   data = cairo_image_surface_get_data(_cairo.img);
+   stride = cairo_image_surface_get_stride(_cairo.img);
+
+   for (id = 0; id < ICON_COUNT; id++)
      {
-        cairo_surface_t *img;
-
-        war2_png_write(file, ICON_W, ICON_H, (unsigned char *)ic->bitmap);
-
-        img = cairo_image_surface_create_from_png(file);
+        icon = _icon_get(w2, era, id);
+        if (!icon) continue;
 
-        cairo_set_source_surface(_cairo.cr, img, px, py);
-        cairo_mask_surface(_cairo.cr, img, px, py);
-        cairo_fill(_cairo.cr);
-        cairo_surface_destroy(img);
+        for (y = 0; y < ICON_H; y++)
+          pud_pixels_convert(&(icon->pixels[y * ICON_W]),
+                             data + (py + y) * stride + px * 4,
+                             ICON_W, PUD_PIXEL_FORMAT_ARGB32_PREMUL);
 
         it++;
         if (it % cols == 0)
@@ -106,8 +95,7 @@ _generate_atlas(unsigned int cols,
           }
      }
 
-   ecore_file_unlink(file);
-   eina_tmpstr_del(file);
+   cairo_surface_mark_dirty(_cairo.img);
 }
 
 static void
@@ -150,29 +138,13 @@ _usage(FILE *s)
 }
 
 
-static void
-_icons_cb(void                          *data EINA_UNUSED,
-          const Pud_Color               *icon,
-          int                            x    EINA_UNUSED,
-          int                            y    EINA_UNUSED,
-          unsigned int                   w,
-          unsigned int                   h,
-          const War2_Sprites_Descriptor *ts   EINA_UNUSED,
-          uint16_t                       img_nb)
-{
-   if ((w != ICON_W) || (h != ICON_H)) return;
-   _add_icon(icon, img_nb);
- }
-
 int
 main(int    argc,
      char **argv)
 {
    War2_Data *w2;
-   War2_Sprites_Descriptor *ud;
    int ret = EXIT_FAILURE;
    char buf[1024];
-   Pud_Bool chk;
    struct {
       const Pud_Era era;
       const char *const str;
@@ -213,27 +185,27 @@ main(int    argc,
 
    for (i = 0; i < EINA_C_ARRAY_LENGTH(eras); i++)
      {
-        unsigned int rows, cols, count;
+        unsigned int rows, cols, count = 0, id;
 
-        chk = war2_sprites_decode(w2, PUD_PLAYER_RED, eras[i].era,
-                                  WAR2_SPRITES_ICONS, _icons_cb, NULL);
-        if (!chk)
+        if (!war2_icon_get(w2, eras[i].era, 0))
           {
-             fprintf(stderr, "*** Failed to decode tileset %s\n", eras[i].str);
+             fprintf(stderr, "*** Failed to decode icons %s\n", eras[i].str);
              return 1;
           }
-        count = eina_list_count(_list);
+        for (id = 0; id < ICON_COUNT; id++)
+          if (_icon_get(w2, eras[i].era, id)) count++;
+        if (count == 0) continue;
 
+        /* Enough rows for all the icons, as they are blitted directly */
         cols = ceil(sqrt(count));
-        rows = floor(sqrt(count));
+        rows = (count + cols - 1) / cols;
         printf("cols, row = %u x %u\n", cols, rows);
 
-        printf("count = %u\n", eina_list_count(_list));
+        printf("count = %u\n", count);
 
         _open_era_file(eras[i].str, cols, rows);
-        _generate_atlas(cols, rows);
+        _generate_atlas(w2, eras[i].era, cols);
 
-        _list = eina_list_free(_list);
         _close_file();
      }
 
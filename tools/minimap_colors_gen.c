@@ -0,0 +1,74 @@
+/*
+ * minimap_colors_gen.c
+ * minimap_colors_gen
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <war2.h>
+
+/*
+ * Prints the minimap colors tables of libpud/tiles.c, computed from the
+ * tilesets of a data file
+ */
+
+static const struct {
+   Pud_Era     era;
+   const char *name;
+} _eras[] = {
+   { PUD_ERA_FOREST,    "forest"    },
+   { PUD_ERA_WINTER,    "winter"    },
+   { PUD_ERA_WASTELAND, "wasteland" },
+   { PUD_ERA_SWAMP,     "swamp"     },
+};
+
+int
+main(int    argc,
+     char **argv)
+{
+   War2_Data *w2;
+   uint32_t colors[WAR2_TILESET_TILE_LAST + 1];
+   unsigned int e, tile;
+   int status = 1;
+
+   if (argc != 2)
+     {
+        fprintf(stderr, "*** Usage: minimap_colors_gen <maindat.war>\n");
+        return 1;
+     }
+
+   war2_init();
+   w2 = war2_open(argv[1]);
+   if (!w2)
+     {
+        fprintf(stderr, "*** Failed to open [%s]\n", argv[1]);
+        goto end;
+     }
+
+   for (e = 0; e < sizeof(_eras) / sizeof(_eras[0]); e++)
+     {
+        if (!war2_tileset_minimap_colors_get(w2, _eras[e].era, colors))
+          {
+             fprintf(stderr, "*** Failed to compute the %s colors\n", _eras[e].name);
+             goto close;
+          }
+
+        printf("static const uint32_t _%s_colors[MINIMAP_TILES] =\n{\n",
+               _eras[e].name);
+        for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
+          {
+             if (colors[tile] != 0)
+               printf("   [0x%04x] = 0x%06x,\n", tile, colors[tile]);
+          }
+        printf("};\n\n");
+     }
+   status = 0;
+
+close:
+   war2_close(w2);
+end:
+   war2_shutdown();
+   return status;
+}
@@ -0,0 +1,321 @@
+/*
+ * png_bench.c
+ * png_bench
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <war2.h>
+
+/*
+ * Writes a set of sprites, icons, tilesets and maps with several PNG
+ * options, and reports the time spent and the size of the files.
+ * QOI is measured as well, for comparison
+ */
+
+#define TMP_FILE "png_bench.tmp.png"
+#define TMP_QOI_FILE "png_bench.tmp.qoi"
+
+typedef struct
+{
+   Pud_Color     *pixels;
+   unsigned char *indexes; /* NULL if the image is not indexed */
+   unsigned int   w;
+   unsigned int   h;
+} Image;
+
+typedef struct
+{
+   Image           *images;
+   unsigned int     count;
+   unsigned int     alloc;
+   size_t           pixels;
+   const Pud_Color *palette; /* Palette of the indexed images */
+   Pud_Bool         indexed; /* Whether all the images are indexed */
+} Image_Set;
+
+typedef struct
+{
+   const char       *name;
+   War2_Png_Profile  profile;
+   int               level; /* Overrides the profile if >= -1 */
+   War2_Png_Filter   filter;
+   War2_Png_Strategy strategy;
+} Config;
+
+static const Config _configs[] = {
+   { "profile default",     WAR2_PNG_PROFILE_DEFAULT, -2, 0, 0 },
+   { "profile fast",        WAR2_PNG_PROFILE_FAST,    -2, 0, 0 },
+   { "profile small",       WAR2_PNG_PROFILE_SMALL,   -2, 0, 0 },
+   { "level 6, none",       WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_NONE,     WAR2_PNG_STRATEGY_DEFAULT },
+   { "level 6, sub",        WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_SUB,      WAR2_PNG_STRATEGY_DEFAULT },
+   { "level 6, paeth",      WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_PAETH,    WAR2_PNG_STRATEGY_DEFAULT },
+   { "level 6, adaptive",   WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_ADAPTIVE, WAR2_PNG_STRATEGY_DEFAULT },
+   { "level 6, filtered",   WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_ADAPTIVE, WAR2_PNG_STRATEGY_FILTERED },
+   { "level 6, huffman",    WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_ADAPTIVE, WAR2_PNG_STRATEGY_HUFFMAN_ONLY },
+   { "level 6, rle",        WAR2_PNG_PROFILE_DEFAULT,  6, WAR2_PNG_FILTER_ADAPTIVE, WAR2_PNG_STRATEGY_RLE },
+   { "level 1, sub",        WAR2_PNG_PROFILE_DEFAULT,  1, WAR2_PNG_FILTER_SUB,      WAR2_PNG_STRATEGY_DEFAULT },
+   { "level 9, adaptive",   WAR2_PNG_PROFILE_DEFAULT,  9, WAR2_PNG_FILTER_ADAPTIVE, WAR2_PNG_STRATEGY_DEFAULT },
+};
+
+static const Pud_Unit _units[] = {
+   PUD_UNIT_FOOTMAN,
+   PUD_UNIT_GRUNT,
+   PUD_UNIT_PEASANT,
+   PUD_UNIT_PEON,
+   PUD_UNIT_KNIGHT,
+   PUD_UNIT_OGRE,
+   PUD_UNIT_TOWN_HALL,
+   PUD_UNIT_GREAT_HALL,
+};
+
+static Pud_Bool
+_image_add(Image_Set           *set,
+           const Pud_Color     *pixels,
+           const unsigned char *indexes,
+           unsigned int         w,
+           unsigned int         h)
+{
+   Image *img;
+
+   if (set->count == set->alloc)
+     {
+        set->alloc = (set->alloc) ? set->alloc * 2 : 64;
+        img = realloc(set->images, set->alloc * sizeof(Image));
+        if (!img) return PUD_FALSE;
+        set->images = img;
+     }
+
+   img = &(set->images[set->count]);
+   img->pixels = malloc(w * h * sizeof(Pud_Color));
+   if (!img->pixels) return PUD_FALSE;
+   memcpy(img->pixels, pixels, w * h * sizeof(Pud_Color));
+   img->indexes = NULL;
+   if (indexes)
+     {
+        img->indexes = malloc(w * h);
+        if (!img->indexes) return PUD_FALSE;
+        memcpy(img->indexes, indexes, w * h);
+     }
+   else
+     set->indexed = PUD_FALSE;
+   img->w = w;
+   img->h = h;
+   set->count++;
+   set->pixels += w * h;
+
+   return PUD_TRUE;
+}
+
+static void
+_image_set_clear(Image_Set *set)
+{
+   unsigned int i;
+
+   for (i = 0; i < set->count; i++)
+     {
+        free(set->images[i].pixels);
+        free(set->images[i].indexes);
+     }
+   free(set->images);
+   memset(set, 0, sizeof(*set));
+   set->indexed = PUD_TRUE;
+}
+
+static void
+_sprite_cb(void                          *data,
+           const Pud_Color               *img,
+           int                            x,
+           int                            y,
+           unsigned int                   w,
+           unsigned int                   h,
+           const War2_Sprites_Descriptor *ud,
+           uint16_t                       img_nb)
+{
+   (void) x;
+   (void) y;
+   (void) img_nb;
+
+   if (!_image_add(data, img, ud->indexes, w, h))
+     fprintf(stderr, "*** Failed to store a sprite\n");
+}
+
+static double
+_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+_bench(const char      *name,
+       const Image_Set *set)
+{
+   War2_Png_Options opts;
+   const Config *c;
+   const Image *img;
+   struct stat st;
+   unsigned int i, k, mode;
+   size_t bytes;
+   double start, elapsed;
+   Pud_Bool chk;
+
+   printf("\n%s: %u images, %zu pixels\n", name, set->count, set->pixels);
+   printf("  %-29s %12s %10s %10s\n", "options", "bytes", "ms", "MPix/s");
+
+   /* Each image is written with each set of options by the serial
+    * encoder, the parallel one, then as an indexed image if possible */
+   for (mode = 0; mode <= (set->indexed ? 2u : 1u); mode++)
+     for (k = 0; k < sizeof(_configs) / sizeof(_configs[0]); k++)
+       {
+          c = &(_configs[k]);
+          war2_png_options_init(&opts, c->profile);
+          if (c->level >= -1)
+            {
+               opts.compression_level = c->level;
+               opts.filter = c->filter;
+               opts.strategy = c->strategy;
+            }
+
+          bytes = 0;
+          start = _now();
+          for (i = 0; i < set->count; i++)
+            {
+               img = &(set->images[i]);
+               if (mode == 2)
+                 chk = war2_png_indexed_write(TMP_FILE, img->w, img->h, img->indexes,
+                                              set->palette, WAR2_PALETTE_SIZE, &opts);
+               else if (mode == 1)
+                 chk = war2_png_parallel_write(TMP_FILE, img->w, img->h,
+                                               (const unsigned char *)img->pixels, &opts);
+               else
+                 chk = war2_png_write_full(TMP_FILE, img->w, img->h,
+                                           (const unsigned char *)img->pixels, &opts);
+               if (!chk)
+                 {
+                    fprintf(stderr, "*** Failed to write PNG\n");
+                    return;
+                 }
+               if (stat(TMP_FILE, &st) == 0)
+                 bytes += st.st_size;
+            }
+          elapsed = _now() - start;
+
+          printf("  %-9s%-20s %12zu %10.1f %10.2f\n",
+                 (mode == 2) ? "indexed" : (mode == 1) ? "parallel" : "rgba",
+                 c->name, bytes, elapsed * 1000.0, set->pixels / elapsed / 1e6);
+       }
+
+   /* QOI, for reference */
+   bytes = 0;
+   start = _now();
+   for (i = 0; i < set->count; i++)
+     {
+        img = &(set->images[i]);
+        if (!war2_qoi_write(TMP_QOI_FILE, img->w, img->h,
+                            (const unsigned char *)img->pixels))
+          {
+             fprintf(stderr, "*** Failed to write QOI\n");
+             return;
+          }
+        if (stat(TMP_QOI_FILE, &st) == 0)
+          bytes += st.st_size;
+     }
+   elapsed = _now() - start;
+   printf("  %-29s %12zu %10.1f %10.2f\n",
+          "qoi", bytes, elapsed * 1000.0, set->pixels / elapsed / 1e6);
+}
+
+int
+main(int    argc,
+     char **argv)
+{
+   War2_Data *w2;
+   War2_Tileset_Atlas *atlas;
+   War2_Map_Renderer *r;
+   const War2_Icon *icon;
+   const Pud_Color *pixels;
+   Image_Set set = { NULL, 0, 0, 0, NULL, PUD_TRUE };
+   Pud *pud;
+   unsigned int i, w, h;
+   int status = 1;
+
+   if (argc < 2)
+     {
+        fprintf(stderr, "*** Usage: png_bench <maindat.war> [map.pud ...]\n");
+        return 1;
+     }
+
+   war2_init();
+   pud_init();
+   w2 = war2_open(argv[1]);
+   if (!w2)
+     {
+        fprintf(stderr, "*** Failed to open [%s]\n", argv[1]);
+        goto end;
+     }
+
+   /* Sprites: many small images with large transparent areas */
+   set.palette = war2_palette_get(w2, PUD_ERA_FOREST);
+   for (i = 0; i < sizeof(_units) / sizeof(_units[0]); i++)
+     war2_sprites_decode(w2, PUD_PLAYER_RED, PUD_ERA_FOREST, _units[i],
+                         _sprite_cb, &set);
+   for (i = 0; i < 256; i++)
+     {
+        icon = war2_icon_get(w2, PUD_ERA_FOREST, i);
+        if (icon) _image_add(&set, icon->pixels, icon->indexes, icon->w, icon->h);
+     }
+   _bench("sprites and icons", &set);
+   _image_set_clear(&set);
+
+   /* Tilesets: medium opaque images. Eras have different palettes */
+   for (i = PUD_ERA_FOREST; i <= PUD_ERA_SWAMP; i++)
+     {
+        atlas = war2_tileset_atlas_new(w2, i, WAR2_TILESET_ATLAS_RGBA |
+                                       WAR2_TILESET_ATLAS_INDEXED);
+        if (!atlas) continue;
+        set.palette = war2_palette_get(w2, i);
+        _image_add(&set, atlas->rgba, atlas->indexes, atlas->w, atlas->h);
+        war2_tileset_atlas_free(atlas);
+        _bench(pud_era_to_string(i), &set);
+        _image_set_clear(&set);
+     }
+
+   /* Maps: large opaque images */
+   for (i = 2; i < (unsigned int)argc; i++)
+     {
+        pud = pud_open(argv[i], PUD_OPEN_MODE_R);
+        if (!pud)
+          {
+             fprintf(stderr, "*** Failed to open [%s]\n", argv[i]);
+             continue;
+          }
+        r = war2_map_renderer_new(w2, pud);
+        if (r)
+          {
+             pixels = war2_map_renderer_pixels_get(r, &w, &h);
+             _image_add(&set, pixels, NULL, w, h);
+             war2_map_renderer_free(r);
+          }
+        pud_close(pud);
+     }
+   if (set.count > 0)
+     _bench("maps", &set);
+   _image_set_clear(&set);
+
+   remove(TMP_FILE);
+   remove(TMP_QOI_FILE);
+   status = 0;
+   war2_close(w2);
+end:
+   pud_shutdown();
+   war2_shutdown();
+   return status;
+}
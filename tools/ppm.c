@@ -26,8 +26,10 @@ ppm_parse(const char *file,
    char comment = 0;
    int w = 0, h = 0;
    char col_st = 0;
+   char binary = 0;
+   unsigned char rgb[3];
 
-   f = fopen(file, "r");
+   f = fopen(file, "rb");
    if (!f)
      {
         fprintf(stderr, "*** Failed to open [%s]\n", file);
@@ -54,15 +56,16 @@ ppm_parse(const char *file,
                   buf[k] = 0;
                   if (status == 0)
                     {
-                       /* Find PP3 */
-                       if (strncmp(buf, "P3", 2) &&
-                           strncmp(buf, "p3", 2))
+                       /* Find P3 (ASCII) or P6 (binary) */
+                       if (!strncmp(buf, "P6", 2) || !strncmp(buf, "p6", 2))
+                         binary = 1;
+                       else if (strncmp(buf, "P3", 2) &&
+                                strncmp(buf, "p3", 2))
                          {
                             fprintf(stderr, "*** Missing header\n");
                             goto end;
                          }
-                       else
-                         status++;
+                       status++;
                     }
                   else if (status == 1)
                     {
@@ -89,6 +92,26 @@ ppm_parse(const char *file,
                             fprintf(stderr, "*** Failed to alloc\n");
                             goto end;
                          }
+
+                       /* Binary pixels follow the single whitespace that
+                        * ended the header */
+                       if (binary)
+                         {
+                            for (i = 0; i < w * h; i++)
+                              {
+                                 if (fread(rgb, 3, 1, f) != 1)
+                                   {
+                                      fprintf(stderr, "*** Truncated PPM\n");
+                                      free(ptr);
+                                      ptr = NULL;
+                                      goto end;
+                                   }
+                                 ptr[i].r = rgb[0];
+                                 ptr[i].g = rgb[1];
+                                 ptr[i].b = rgb[2];
+                              }
+                            break;
+                         }
                     }
                   else
                     {
@@ -133,15 +156,17 @@ ppm_save(const char *file,
    FILE *f;
    int i;
 
-   f = fopen(file, "w+");
+   f = fopen(file, "wb");
    if (f == NULL) return -1;
 
-   fprintf(f, "P3\n%i %i\n255\n", w, h);
+   fprintf(f, "P6\n%i %i\n255\n", w, h);
 
    for (i = 0; i < size; ++i)
-     fprintf(f, "%i %i %i\n", data[i].r, data[i].g, data[i].b);
-
-   fclose(f);
+     {
+        fputc(data[i].r, f);
+        fputc(data[i].g, f);
+        fputc(data[i].b, f);
+     }
 
-   return 0;
+   return (fclose(f) == 0) ? 0 : -1;
 }
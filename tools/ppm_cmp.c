@@ -6,12 +6,45 @@
  */
 
 #include "ppm.h"
+#include <war2.h>
 
 static void
 _usage(FILE *stream)
 {
    fprintf(stream,
-           "Usage: ppm_cmp <file1.ppm> <file2.ppm>\n");
+           "Usage: ppm_cmp <file1.ppm|qoi> <file2.ppm|qoi>\n");
+}
+
+static Col *
+_load(const char *file,
+      int        *w_ret,
+      int        *h_ret)
+{
+   Pud_Color *img;
+   Col *ptr;
+   unsigned int w, h, i;
+   const size_t len = strlen(file);
+
+   /* Render bands and snapshots may be stored as QOI */
+   if ((len < 4) || (strcmp(file + len - 4, ".qoi") != 0))
+     return ppm_parse(file, w_ret, h_ret);
+
+   img = war2_qoi_read(file, &w, &h);
+   if (!img) return NULL;
+   ptr = malloc(w * h * sizeof(Col));
+   if (ptr)
+     {
+        for (i = 0; i < w * h; i++)
+          {
+             ptr[i].r = img[i].r;
+             ptr[i].g = img[i].g;
+             ptr[i].b = img[i].b;
+          }
+        *w_ret = w;
+        *h_ret = h;
+     }
+   free(img);
+   return ptr;
 }
 
 
@@ -63,8 +96,8 @@ main(int    argc,
         return 1;
      }
 
-   im1 = ppm_parse(argv[1], &w1, &h1);
-   im2 = ppm_parse(argv[2], &w2, &h2);
+   im1 = _load(argv[1], &w1, &h1);
+   im2 = _load(argv[2], &w2, &h2);
 
    if ((!im1) || (!im2))
      {
@@ -0,0 +1,145 @@
+/*
+ * tileset_encode.c
+ * tileset_encode
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "ppm.h"
+#include <war2.h>
+
+/*
+ * The tileset image is a grid of 32x32 tiles, 16 per row: tile ID T is in
+ * column (T & 0xf) of row (T >> 4), as in the map entry of a tileset.
+ * Cells that are entirely black are not populated.
+ */
+
+static void
+_usage(FILE *stream)
+{
+   fprintf(stream,
+           "Usage: tileset_encode <maindat.war> <forest|winter|wasteland|swamp> "
+           "<tileset.ppm> <prefix>\n"
+           "\n"
+           "Writes <prefix>.megatiles, <prefix>.minitiles and <prefix>.map\n");
+}
+
+static Pud_Bool
+_era_parse(const char *str,
+           Pud_Era    *era)
+{
+   if (!strcmp(str, "forest")) *era = PUD_ERA_FOREST;
+   else if (!strcmp(str, "winter")) *era = PUD_ERA_WINTER;
+   else if (!strcmp(str, "wasteland")) *era = PUD_ERA_WASTELAND;
+   else if (!strcmp(str, "swamp")) *era = PUD_ERA_SWAMP;
+   else return PUD_FALSE;
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_entry_write(const char          *prefix,
+             const char          *suffix,
+             const unsigned char *data,
+             size_t               size)
+{
+   char path[4096];
+   FILE *f;
+   Pud_Bool ok;
+
+   snprintf(path, sizeof(path), "%s.%s", prefix, suffix);
+   f = fopen(path, "wb");
+   if (!f)
+     {
+        fprintf(stderr, "*** Failed to open [%s]\n", path);
+        return PUD_FALSE;
+     }
+   ok = (fwrite(data, 1, size, f) == size);
+   if (fclose(f) != 0) ok = PUD_FALSE;
+   if (!ok) fprintf(stderr, "*** Failed to write [%s]\n", path);
+   return ok;
+}
+
+int
+main(int    argc,
+     char **argv)
+{
+   War2_Data *w2;
+   War2_Tileset_Encoder *enc;
+   War2_Tileset_Entries entries;
+   Pud_Color img[32 * 32];
+   Pud_Era era;
+   Col *ppm, *c;
+   int w, h, x, y, tile, tiles = 0, status = 1;
+   Pud_Bool black;
+
+   if ((argc != 5) || (!_era_parse(argv[2], &era)))
+     {
+        _usage(stderr);
+        return 1;
+     }
+
+   war2_init();
+   w2 = war2_open(argv[1]);
+   if (!w2)
+     {
+        fprintf(stderr, "*** Failed to open [%s]\n", argv[1]);
+        goto end;
+     }
+
+   ppm = ppm_parse(argv[3], &w, &h);
+   if (!ppm)
+     {
+        fprintf(stderr, "*** ppm_parse() failed\n");
+        goto close;
+     }
+
+   enc = war2_tileset_encoder_new(war2_palette_get(w2, era));
+   if (!enc) goto free_ppm;
+
+   for (tile = WAR2_TILESET_TILE_FIRST; tile <= WAR2_TILESET_TILE_LAST; tile++)
+     {
+        if ((((tile & 0xf) + 1) * 32 > w) || (((tile >> 4) + 1) * 32 > h))
+          continue;
+
+        black = PUD_TRUE;
+        for (y = 0; y < 32; y++)
+          for (x = 0; x < 32; x++)
+            {
+               c = &(ppm[((tile >> 4) * 32 + y) * w + (tile & 0xf) * 32 + x]);
+               img[y * 32 + x] = pud_color(c->r, c->g, c->b, 0xff);
+               if (c->r || c->g || c->b) black = PUD_FALSE;
+            }
+        if (black) continue;
+
+        if (!war2_tileset_encoder_tile_add(enc, tile, img))
+          {
+             fprintf(stderr, "*** Failed to add tile 0x%04x\n", tile);
+             goto free_enc;
+          }
+        tiles++;
+     }
+
+   if (!war2_tileset_encoder_encode(enc, &entries)) goto free_enc;
+
+   if (_entry_write(argv[4], "megatiles", entries.megatiles, entries.megatiles_size) &&
+       _entry_write(argv[4], "minitiles", entries.minitiles, entries.minitiles_size) &&
+       _entry_write(argv[4], "map", entries.map, entries.map_size))
+     {
+        printf("%i tiles, %zu megatiles, %zu minitiles\n", tiles,
+               entries.megatiles_size / 32 - 1, entries.minitiles_size / 64);
+        status = 0;
+     }
+
+   free(entries.megatiles);
+   free(entries.minitiles);
+   free(entries.map);
+free_enc:
+   war2_tileset_encoder_free(enc);
+free_ppm:
+   free(ppm);
+close:
+   war2_close(w2);
+end:
+   war2_shutdown();
+   return status;
+}